@@ -3,7 +3,7 @@ SET( VERSION_MINOR "1" )
 SET( VERSION_PATCH "0" )
 SET( VERSION "${VERSION_MAJOR}.${VERSION_MINOR}.${VERSION_PATCH}" )
 
-SET( SONAME_MAJOR "15" )
+SET( SONAME_MAJOR "16" )
 SET( SONAME_MINOR "0" )
 SET( SONAME_PATCH "0" )
 SET( SONAME "${SONAME_MAJOR}.${SONAME_MINOR}.${SONAME_PATCH}" )
@@ -16,7 +16,7 @@
 #
 
 %define         parent libyui-ncurses-pkg
-%define         so_version 15
+%define         so_version 16
 
 Name:           %{parent}-doc
 # DO NOT manually bump the version here; instead, use   rake version:bump
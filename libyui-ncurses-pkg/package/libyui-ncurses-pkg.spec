@@ -23,7 +23,7 @@ Name:           libyui-ncurses-pkg
 Version:        4.0.1
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         libyui_devel_version libyui-devel >= 3.10.0
 %define         libyui_ncurses_devel_version    libyui-ncurses-devel >= 2.54.0
 %define         libzypp_devel_version           libzypp-devel >= 17.21.0
@@ -114,6 +114,8 @@ int NCHttpDialog::wait_for_input(int timeout_millisec)
 
             if (server_ready)
             {
+                // write the changes done by the request at once
+                NCurses::UpdateBatch batch;
                 bool redraw = YHttpServer::yserver()->process_data();
                 yuiWarning() << "redraw: " << redraw << std::endl;
 
@@ -131,9 +133,10 @@ int NCHttpDialog::wait_for_input(int timeout_millisec)
                         timeout_millisec = 0;
                 }
 
-                // the request might have changed something in the UI, let's redraw it...
+                // the request might have changed something in the UI,
+                // update the changed parts of the screen
                 if (redraw)
-                    NCurses::Redraw();
+                    NCurses::Update();
 
                 // finish the loop if there is any event added by the server call
                 if (getPendingEvent())
@@ -132,9 +132,10 @@ void YNCHttpUI::idleLoop( int fd_ycp )
 
              if (server_ready)
              {
+                NCurses::UpdateBatch batch;
                 bool redraw = YHttpServer::yserver()->process_data();
                 if (redraw)
-                    NCurses::Redraw();
+                    NCurses::Update();
              }
 
  	    //do not throw here, as current dialog may not necessarily exist yet
@@ -0,0 +1,1114 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		NCRenderBenchmark.cc
+
+  Rendering benchmark for the NCurses UI: Runs scripted scenarios modeled
+  after the libyui examples on a pseudo terminal and reports the time, the
+  bytes written to the terminal, the screen updates and the memory
+  allocations per operation.
+
+/-*/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ncursesw/curses.h>
+
+#include <yui/YUI.h>
+#include <yui/YBuiltinCaller.h>
+#include <yui/YWidgetFactory.h>
+#include <yui/YDialog.h>
+#include <yui/YLayoutBox.h>
+#include <yui/YAlignment.h>
+#include <yui/YCheckBox.h>
+#include <yui/YCheckBoxFrame.h>
+#include <yui/YComboBox.h>
+#include <yui/YFrame.h>
+#include <yui/YInputField.h>
+#include <yui/YIntField.h>
+#include <yui/YLabel.h>
+#include <yui/YLogView.h>
+#include <yui/YMenuButton.h>
+#include <yui/YMultiSelectionBox.h>
+#include <yui/YProgressBar.h>
+#include <yui/YProperty.h>
+#include <yui/YPushButton.h>
+#include <yui/YRadioButton.h>
+#include <yui/YRadioButtonGroup.h>
+#include <yui/YReplacePoint.h>
+#include <yui/YRichText.h>
+#include <yui/YSelectionBox.h>
+#include <yui/YSquash.h>
+#include <yui/YTable.h>
+#include <yui/YTableHeader.h>
+#include <yui/YTree.h>
+#include <yui/YTreeItem.h>
+#include <yui/YWidgetID.h>
+
+// <pty.h> defines CTRL() in <sys/ttydefaults.h>, NCurses.h has its own
+#undef CTRL
+
+#include "NCurses.h"
+#include "NCDialog.h"
+#include "NCTable.h"
+#include "YNCursesUI.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * Pseudo terminal the UI runs on. It becomes stdin and stdout of the
+ * process; the terminal output is read and counted by a separate thread.
+ **/
+class Terminal
+{
+public:
+
+    Terminal( int lines, int cols )
+	: _master( -1 )
+	, _bytes( 0 )
+	, _stop( false )
+    {
+	struct winsize size;
+	memset( &size, 0, sizeof( size ) );
+	size.ws_row = lines;
+	size.ws_col = cols;
+
+	int slave = -1;
+
+	if ( openpty( &_master, &slave, 0, 0, &size ) != 0 )
+	{
+	    perror( "openpty" );
+	    exit( 1 );
+	}
+
+	// keep the original stdout for the report
+	_report = fdopen( dup( 1 ), "w" );
+
+	dup2( slave, 0 );
+	dup2( slave, 1 );
+	close( slave );
+
+	_reader = std::thread( &Terminal::read, this );
+    }
+
+    ~Terminal()
+    {
+	_stop = true;
+	_reader.join();
+	close( _master );
+	fclose( _report );
+    }
+
+    /**
+     * Send the key with terminfo capability 'cap' (e.g. "kcud1") or the
+     * literal key sequence 'fallback' and wait until it can be read.
+     **/
+    void sendKey( const char * cap, const char * fallback = "" )
+    {
+	const char * seq = cap ? tigetstr( cap ) : 0;
+
+	if ( !seq || seq == (char *) -1 )
+	    seq = fallback;
+
+	if ( write( _master, seq, strlen( seq ) ) < 0 )
+	    perror( "write" );
+
+	struct pollfd fd = { 0, POLLIN, 0 };
+	poll( &fd, 1, 1000 );
+    }
+
+    /**
+     * Wait until all terminal output is read and return the number of
+     * bytes read so far.
+     **/
+    unsigned long long drain()
+    {
+	while ( true )
+	{
+	    int pending = 0;
+
+	    {
+		std::lock_guard<std::mutex> lock( _mutex );
+		ioctl( _master, FIONREAD, &pending );
+
+		if ( pending == 0 )
+		    return _bytes;
+	    }
+
+	    usleep( 100 );
+	}
+    }
+
+    /**
+     * Change the terminal size and notify the UI like the terminal
+     * emulator does. The UI handles it with the next key it reads.
+     **/
+    void resize( int lines, int cols )
+    {
+	struct winsize size;
+	memset( &size, 0, sizeof( size ) );
+	size.ws_row = lines;
+	size.ws_col = cols;
+
+	if ( ioctl( _master, TIOCSWINSZ, &size ) != 0 )
+	    perror( "TIOCSWINSZ" );
+
+	// the benchmark is not the foreground process of the terminal
+	raise( SIGWINCH );
+    }
+
+    FILE * report() const { return _report; }
+
+private:
+
+    void read()
+    {
+	char buffer[ 16384 ];
+
+	while ( !_stop )
+	{
+	    struct pollfd fd = { _master, POLLIN, 0 };
+
+	    if ( poll( &fd, 1, 10 ) <= 0 )
+		continue;
+
+	    std::lock_guard<std::mutex> lock( _mutex );
+	    ssize_t len = ::read( _master, buffer, sizeof( buffer ) );
+
+	    if ( len > 0 )
+		_bytes += len;
+	}
+    }
+
+    int		       _master;
+    FILE *	       _report;
+    std::thread	       _reader;
+    std::mutex	       _mutex;
+    unsigned long long _bytes;
+    std::atomic<bool>  _stop;
+};
+
+
+
+/**
+ * One event loop iteration of 'dialog' without waiting: Process the typed
+ * keys and update the screen, like the idle loop of the NCurses UI.
+ **/
+static void processInput( YDialog * dialog )
+{
+    static_cast<NCDialog *>( dialog )->idleInput();
+}
+
+
+
+/**
+ * A UI call of the application, handed over to the UI like the built-ins
+ * of a YCP or Ruby script.
+ **/
+class BuiltinCall : public YBuiltinCaller
+{
+public:
+
+    BuiltinCall( std::function<void()> call )
+	: _call( call )
+	{}
+
+    virtual void call() { _call(); }
+
+private:
+
+    std::function<void()> _call;
+};
+
+
+static void callBuiltin( std::function<void()> call )
+{
+    BuiltinCall caller( call );
+    YUI::ui()->callBuiltins( std::vector<YBuiltinCaller *>( 1, &caller ) );
+}
+
+
+
+/**
+ * Runs the operations and collects the results.
+ **/
+class Benchmark
+{
+public:
+
+    Benchmark( Terminal & terminal, const std::string & only )
+	: _terminal( terminal )
+	, _only( only )
+    {}
+
+    /**
+     * Return true if the scenario 'name' should be run.
+     **/
+    bool wanted( const std::string & name )
+    {
+	_scenario = name;
+	return _only.empty() || _only == name;
+    }
+
+    /**
+     * Run 'op' 'count' times and record the costs. 'prepare' is called
+     * before each run and not measured, e.g. to send a key.
+     **/
+    void measure( const std::string & name, int count,
+		  std::function<void( int )> op,
+		  std::function<void( int )> prepare = std::function<void( int )>() )
+    {
+	unsigned long long bytes  = _terminal.drain();
+	unsigned long	   frames = NCurses::frameStats().frames;
+	unsigned long	   allocs = 0;
+	std::chrono::steady_clock::duration time( 0 );
+
+	for ( int i = 0; i < count; ++i )
+	{
+	    if ( prepare )
+		prepare( i );
+
+	    unsigned long allocs_before = allocations;
+	    auto start = std::chrono::steady_clock::now();
+
+	    op( i );
+
+	    time   += std::chrono::steady_clock::now() - start;
+	    allocs += allocations - allocs_before;
+	}
+
+	Result result;
+	result.scenario  = _scenario;
+	result.operation = name;
+	result.count	 = count;
+	result.usec	 = std::chrono::duration<double, std::micro>( time ).count() / count;
+	result.bytes	 = double( _terminal.drain() - bytes ) / count;
+	result.frames	 = double( NCurses::frameStats().frames - frames ) / count;
+	result.allocs	 = double( allocs ) / count;
+
+	_results.push_back( result );
+    }
+
+    /**
+     * Measure a key press: Send the key and process it in the event loop
+     * of 'dialog'.
+     **/
+    void measureKey( const std::string & name, int count, YDialog * dialog,
+		     const char * cap, const char * fallback = "" )
+    {
+	measure( name, count,
+		 [dialog]( int ) { processInput( dialog ); },
+		 [this, cap, fallback]( int ) { _terminal.sendKey( cap, fallback ); } );
+    }
+
+    /**
+     * Return the screen updates per run of operation 'name' of scenario
+     * 'scenario' or -1 if it wasn't run.
+     **/
+    double frames( const std::string & scenario, const std::string & name ) const
+    {
+	for ( const Result & r : _results )
+	{
+	    if ( r.scenario == scenario && r.operation == name )
+		return r.frames;
+	}
+
+	return -1;
+    }
+
+    Terminal & terminal() { return _terminal; }
+
+    void report()
+    {
+	FILE * out = _terminal.report();
+
+	fprintf( out, "%-16s %-20s %6s %12s %12s %10s %10s\n",
+		 "Scenario", "Operation", "Count", "usec/op", "bytes/op", "frames/op", "allocs/op" );
+
+	for ( const Result & r : _results )
+	{
+	    fprintf( out, "%-16s %-20s %6d %12.1f %12.1f %10.2f %10.1f\n",
+		     r.scenario.c_str(), r.operation.c_str(), r.count,
+		     r.usec, r.bytes, r.frames, r.allocs );
+	}
+
+	fflush( out );
+    }
+
+private:
+
+    struct Result
+    {
+	std::string scenario;
+	std::string operation;
+	int	    count;
+	double	    usec;
+	double	    bytes;
+	double	    frames;
+	double	    allocs;
+    };
+
+    Terminal &		_terminal;
+    std::string		_only;
+    std::string		_scenario;
+    std::vector<Result> _results;
+};
+
+
+
+static YWidgetFactory * factory()
+{
+    return YUI::widgetFactory();
+}
+
+
+static std::string loremIpsum()
+{
+    return "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+	"eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim "
+	"ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+	"aliquip ex ea commodo consequat. Duis aute irure dolor in "
+	"reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla "
+	"pariatur.";
+}
+
+
+static void openDialog( YDialog * dialog )
+{
+    dialog->open();
+    processInput( dialog );
+}
+
+
+
+/**
+ * Sort an NCTable like after choosing the column in the popup of the
+ * sort hotkey (Ctrl-O), which throws away the keys typed ahead and so
+ * can't be driven through the terminal here.
+ **/
+class TableSorter : public NCTable
+{
+public:
+
+    static void sort( YTable * table, int sortCol, bool reverse )
+    {
+	// pointers to the protected members, but they can be used for any NCTable
+	void ( NCTable::*sortItems )( int, bool ) = &TableSorter::sortItems;
+	void ( NCTable::*drawPad )()		  = &TableSorter::DrawPad;
+
+	NCTable * ncTable = dynamic_cast<NCTable *>( table );
+	( ncTable->*sortItems )( sortCol, reverse );
+	( ncTable->*drawPad )();
+    }
+};
+
+
+
+// Like the Table-many-items example
+
+static YItemCollection tableItems( int count )
+{
+    YItemCollection items;
+
+    for ( int i = 1; i <= count; i++ )
+    {
+	char no[ 16 ];
+	sprintf( no, "%04d", i );
+
+	char name[ 80 ];
+	sprintf( name, "Pizza #%05d", i );
+	items.push_back( new YTableItem( std::vector<std::string> { no, name } ) );
+    }
+
+    return items;
+}
+
+
+static void tableScenario( Benchmark & bench, int itemCount )
+{
+    if ( !bench.wanted( "table" ) )
+	return;
+
+    YDialog * dialog = 0;
+    YTable * table = 0;
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createPopupDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	YAlignment * minSize = factory()->createMinSize( vbox, 50, 16 );
+
+	YTableHeader * header = new YTableHeader();
+	header->addColumn( "Number" );
+	header->addColumn( "Name" );
+	table = factory()->createTable( minSize, header );
+	table->addItems( tableItems( itemCount ) );
+
+	factory()->createPushButton( vbox, "&Close" );
+	openDialog( dialog );
+    } );
+
+    bench.measureKey( "key down",  200, dialog, "kcud1", "\033[B"  );
+    bench.measureKey( "page down",  50, dialog, "knp",	 "\033[6~" );
+
+    bench.measure( "end / home", 20,
+		   [dialog]( int ) { processInput( dialog ); },
+		   [&bench]( int i ) { bench.terminal().sendKey( i % 2 ? "khome" : "kend" ); } );
+
+    bench.measure( "select item", 100, [&]( int i )
+    {
+	table->selectItem( table->itemAt( ( i * 37 ) % itemCount ) );
+	processInput( dialog );
+    } );
+
+    // sort by the "Name" and the "Number" column in turns, descending
+    // every other time
+
+    bench.measure( "sort", 10, [&]( int i )
+    {
+	TableSorter::sort( table, 1 - i % 2, i % 4 >= 2 );
+	processInput( dialog );
+    } );
+
+    bench.measure( "replace items", 5, [&]( int )
+    {
+	// the UI writes the changes at the end of the call
+	callBuiltin( [&]()
+	{
+	    table->deleteAllItems();
+	    table->addItems( tableItems( itemCount ) );
+	} );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+// Like the SelectionBox3-many-items example
+
+static YItemCollection selectionItems( int count )
+{
+    YItemCollection items;
+
+    for ( int i = 1; i <= count; i++ )
+    {
+	char name[ 80 ];
+	sprintf( name, "Pizza #%05d", i );
+	items.push_back( new YItem( name ) );
+    }
+
+    return items;
+}
+
+
+static void selectionBoxScenario( Benchmark & bench, int itemCount )
+{
+    if ( !bench.wanted( "selectionbox" ) )
+	return;
+
+    YDialog * dialog = 0;
+    YSelectionBox * selBox = 0;
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createPopupDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	YAlignment * minSize = factory()->createMinSize( vbox, 40, 8 );
+	selBox = factory()->createSelectionBox( minSize, "&Menu" );
+	selBox->addItems( selectionItems( itemCount ) );
+
+	factory()->createPushButton( vbox, "&Close" );
+	openDialog( dialog );
+    } );
+
+    bench.measureKey( "key down",  200, dialog, "kcud1", "\033[B"  );
+    bench.measureKey( "page down",  50, dialog, "knp",	 "\033[6~" );
+
+    bench.measure( "select item", 100, [&]( int i )
+    {
+	selBox->selectItem( selBox->itemAt( ( i * 37 ) % itemCount ) );
+	processInput( dialog );
+    } );
+
+    bench.measure( "replace items", 5, [&]( int )
+    {
+	// the UI writes the changes at the end of the call
+	callBuiltin( [&]()
+	{
+	    selBox->deleteAllItems();
+	    selBox->addItems( selectionItems( itemCount ) );
+	} );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+// Like the ManyWidgets example
+
+static void manyWidgetsScenario( Benchmark & bench )
+{
+    if ( !bench.wanted( "manywidgets" ) )
+	return;
+
+    YDialog *	   dialog   = 0;
+    YInputField *  input    = 0;
+    YLabel *	   label    = 0;
+    YProgressBar * progress = 0;
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createMainDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	factory()->createHeading( vbox, "Many Widgets" );
+
+	YLayoutBox * hbox = factory()->createHBox( vbox );
+	YLayoutBox * left = factory()->createVBox( hbox );
+	YLayoutBox * right = factory()->createVBox( hbox );
+
+	input = factory()->createInputField( left, "&Name" );
+	factory()->createPasswordField( left, "&Password" );
+	factory()->createIntField( left, "&Count", 0, 100, 42 );
+
+	YComboBox * combo = factory()->createComboBox( left, "C&olor" );
+	combo->addItem( new YItem( "Red" ) );
+	combo->addItem( new YItem( "Green" ) );
+	combo->addItem( new YItem( "Blue" ) );
+
+	for ( int i = 1; i <= 3; i++ )
+	    factory()->createCheckBox( left, "Check box " + std::to_string( i ) );
+
+	YRadioButtonGroup * group = factory()->createRadioButtonGroup( right );
+	YLayoutBox * radioBox = factory()->createVBox( group );
+
+	for ( int i = 1; i <= 3; i++ )
+	    factory()->createRadioButton( radioBox, "Radio button " + std::to_string( i ) );
+
+	label	 = factory()->createLabel( right, "Status" );
+	progress = factory()->createProgressBar( right, "Progress", 100 );
+
+	YLayoutBox * buttonBox = factory()->createHBox( vbox );
+
+	for ( int i = 1; i <= 3; i++ )
+	    factory()->createPushButton( buttonBox, "Button " + std::to_string( i ) );
+
+	openDialog( dialog );
+    } );
+
+    bench.measureKey( "tab", 100, dialog, 0, "\t" );
+
+    bench.measure( "set values", 100, [&]( int i )
+    {
+	input->setValue( "Value " + std::to_string( i ) );
+	label->setValue( "Status " + std::to_string( i ) );
+	progress->setValue( i );
+	processInput( dialog );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+// Like a wizard: the content of a replace point is replaced page by page,
+// and popups are opened and closed on top of it
+
+static void wizardPage( YReplacePoint * replacePoint, int page )
+{
+    replacePoint->deleteChildren();
+
+    YLayoutBox * vbox = factory()->createVBox( replacePoint );
+    factory()->createHeading( vbox, "Step " + std::to_string( page ) );
+
+    for ( int i = 1; i <= 5; i++ )
+    {
+	YLayoutBox * hbox = factory()->createHBox( vbox );
+	YInputField * field = factory()->createInputField( hbox, "Field " + std::to_string( i ) );
+	field->setId( new YStringWidgetID( "field" + std::to_string( i ) ) );
+	factory()->createCheckBox( hbox, "Option " + std::to_string( i ) );
+    }
+
+    YComboBox * combo = factory()->createComboBox( vbox, "&Choice" );
+
+    for ( int i = 1; i <= 50; i++ )
+	combo->addItem( new YItem( "Choice " + std::to_string( i ) ) );
+
+    replacePoint->showChild();
+}
+
+
+static void wizardScenario( Benchmark & bench )
+{
+    if ( !bench.wanted( "wizard" ) )
+	return;
+
+    YDialog *	    dialog	 = 0;
+    YReplacePoint * replacePoint = 0;
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createMainDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	factory()->createHeading( vbox, "Wizard" );
+	replacePoint = factory()->createReplacePoint( vbox );
+	factory()->createEmpty( replacePoint );
+
+	YLayoutBox * buttonBox = factory()->createHBox( vbox );
+	factory()->createPushButton( buttonBox, "&Back" );
+	factory()->createPushButton( buttonBox, "&Next" );
+
+	openDialog( dialog );
+    } );
+
+    bench.measure( "next page", 100, [&]( int i )
+    {
+	wizardPage( replacePoint, i );
+	dialog->recalcLayout();
+	processInput( dialog );
+    } );
+
+    bench.measure( "popup", 100, [&]( int )
+    {
+	YDialog * popup = factory()->createPopupDialog();
+	YLayoutBox * vbox = factory()->createVBox( popup );
+	factory()->createLabel( vbox, loremIpsum() );
+	factory()->createPushButton( vbox, "&OK" );
+	openDialog( popup );
+	popup->destroy();
+	processInput( dialog );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+static void richTextScenario( Benchmark & bench, int lines, int cols )
+{
+    if ( !bench.wanted( "richtext" ) )
+	return;
+
+    YDialog * dialog = 0;
+    YRichText * richText = 0;
+    std::string text;
+
+    for ( int i = 1; i <= 50; i++ )
+    {
+	text += "<h2>Chapter " + std::to_string( i ) + "</h2>";
+	text += "<p><b>" + loremIpsum() + "</b> " + loremIpsum() + "</p>";
+	text += "<ul><li>" + loremIpsum() + "</li><li><i>" + loremIpsum() + "</i></li></ul>";
+    }
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createMainDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	richText = factory()->createRichText( vbox, text );
+	factory()->createPushButton( vbox, "&Close" );
+	openDialog( dialog );
+    } );
+
+    bench.measureKey( "page down", 50, dialog, "knp", "\033[6~" );
+
+    bench.measure( "set text", 10, [&]( int i )
+    {
+	richText->setValue( "<p>" + std::to_string( i ) + "</p>" + text );
+	processInput( dialog );
+    } );
+
+    bench.measure( "resize to 100", 1,
+		   [&]( int ) { processInput( dialog ); },
+		   [&]( int ) { bench.terminal().resize( lines, 100 ); } );
+
+    bench.measure( "resize back", 1,
+		   [&]( int ) { processInput( dialog ); },
+		   [&]( int ) { bench.terminal().resize( lines, cols ); } );
+
+    bench.measure( "append paragraph", 200, [&]( int i )
+    {
+	richText->appendText( "<p><b>" + std::to_string( i ) + "</b> " + loremIpsum() + "</p>" );
+	processInput( dialog );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+static void logViewScenario( Benchmark & bench )
+{
+    if ( !bench.wanted( "logview" ) )
+	return;
+
+    YDialog * dialog = 0;
+    YLogView * logView = 0;
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createMainDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	logView = factory()->createLogView( vbox, "&Log", 15, 1000 );
+	factory()->createPushButton( vbox, "&Close" );
+	openDialog( dialog );
+    } );
+
+    bench.measure( "append line", 500, [&]( int i )
+    {
+	logView->appendLines( "Line " + std::to_string( i ) + ": " + loremIpsum().substr( 0, 60 ) + "\n" );
+	processInput( dialog );
+    } );
+
+    bench.measure( "clear", 5, [&]( int )
+    {
+	logView->clearText();
+	processInput( dialog );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+/**
+ * A log of about 'size' bytes with lines of different lengths, most of them
+ * longer than the terminal is wide.
+ **/
+static std::string bigLog( size_t size )
+{
+    std::string lorem = loremIpsum();
+    std::string log;
+    log.reserve( size + lorem.size() );
+
+    for ( int i = 0; log.size() < size; i++ )
+    {
+	log += "Line " + std::to_string( i ) + ": ";
+	log += lorem.substr( 0, ( i * 37 ) % lorem.size() );
+	log += '\n';
+    }
+
+    return log;
+}
+
+
+static void logWrapScenario( Benchmark & bench, int lines, int cols )
+{
+    if ( !bench.wanted( "logwrap" ) )
+	return;
+
+    YDialog * dialog = 0;
+    YLogView * logView = 0;
+    std::string log = bigLog( 4 * 1024 * 1024 );
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createMainDialog();
+	YLayoutBox * vbox = factory()->createVBox( dialog );
+	logView = factory()->createLogView( vbox, "&Log", 15, 0 );
+	factory()->createPushButton( vbox, "&Close" );
+	openDialog( dialog );
+    } );
+
+    bench.measure( "set 4 MB log", 1, [&]( int )
+    {
+	logView->setLogText( log );
+	processInput( dialog );
+    } );
+
+    for ( int width : { 60, 100, 132, 200, cols } )
+    {
+	bench.measure( "resize to " + std::to_string( width ), 1,
+		       [&]( int ) { processInput( dialog ); },
+		       [&]( int ) { bench.terminal().resize( lines, width ); } );
+    }
+
+    bench.measure( "append line", 200, [&]( int i )
+    {
+	logView->appendLines( "Line " + std::to_string( i ) + ": " + loremIpsum() + "\n" );
+	processInput( dialog );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+
+// One widget of every class the widget factory can create, and every
+// property of each of them read and written like the bindings and the
+// REST API do
+
+static void createAllWidgets( YWidget * parent )
+{
+    YLayoutBox * hbox  = factory()->createHBox( parent );
+    YLayoutBox * left  = factory()->createVBox( hbox );
+    YLayoutBox * right = factory()->createVBox( hbox );
+
+    factory()->createHeading( left, "All Widgets" );
+    factory()->createLabel( left, "Label" );
+    factory()->createOutputField( left, "Output field" );
+    factory()->createInputField( left, "&Input field" );
+    factory()->createPasswordField( left, "&Password" );
+    factory()->createIntField( left, "&Count", 0, 100, 42 );
+    factory()->createCheckBox( left, "Check &box", true );
+    factory()->createProgressBar( left, "Progress", 100 );
+    factory()->createBusyIndicator( left, "Busy" );
+    factory()->createMultiLineEdit( left, "&Multi line edit" );
+    factory()->createRichText( left, "<b>Rich</b> text" );
+    factory()->createLogView( left, "&Log", 3, 100 );
+    factory()->createImage( left, "" );
+
+    YComboBox * combo = factory()->createComboBox( right, "C&ombo box" );
+    YSelectionBox * selectionBox = factory()->createSelectionBox( right, "&Selection box" );
+    YMultiSelectionBox * multiSelectionBox = factory()->createMultiSelectionBox( right, "M&ulti selection box" );
+    YMenuButton * menuButton = factory()->createMenuButton( right, "M&enu" );
+    YTree * tree = factory()->createTree( right, "&Tree" );
+
+    for ( int i = 1; i <= 3; i++ )
+    {
+	std::string label = "Item " + std::to_string( i );
+
+	combo->addItem( new YItem( label ) );
+	selectionBox->addItem( new YItem( label ) );
+	multiSelectionBox->addItem( new YItem( label ) );
+	menuButton->addItem( label );
+	tree->addItem( new YTreeItem( label ) );
+    }
+
+    YTableHeader * header = new YTableHeader();
+    header->addColumn( "Number" );
+    header->addColumn( "Name" );
+    YTable * table = factory()->createTable( right, header );
+    table->addItems( tableItems( 3 ) );
+
+    YFrame * frame = factory()->createFrame( right, "&Frame" );
+    factory()->createRadioButton( factory()->createRadioButtonGroup( frame ), "&Radio button" );
+
+    YCheckBoxFrame * checkBoxFrame = factory()->createCheckBoxFrame( right, "Check box &frame", true );
+    factory()->createPushButton( factory()->createSquash( checkBoxFrame, true, true ), "&Push button" );
+
+    YReplacePoint * replacePoint = factory()->createReplacePoint( right );
+    factory()->createEmpty( replacePoint );
+
+    factory()->createHSpacing( factory()->createLeft( parent ), 2 );
+}
+
+
+/**
+ * Collect 'widget' and all widgets below it.
+ **/
+static void collectWidgets( YWidget * widget, std::vector<YWidget *> & widgets )
+{
+    widgets.push_back( widget );
+
+    for ( YWidgetListConstIterator it = widget->childrenConstBegin(); it != widget->childrenConstEnd(); ++it )
+	collectWidgets( *it, widgets );
+}
+
+
+static void propertiesScenario( Benchmark & bench )
+{
+    if ( !bench.wanted( "properties" ) )
+	return;
+
+    YDialog * dialog = 0;
+
+    bench.measure( "open", 1, [&]( int )
+    {
+	dialog = factory()->createMainDialog();
+	createAllWidgets( factory()->createVBox( dialog ) );
+	openDialog( dialog );
+    } );
+
+    struct Access
+    {
+	YWidget *	widget;
+	std::string	name;
+	YPropertyValue	value;
+    };
+
+    std::vector<Access> gets;
+    std::vector<Access> sets;
+    std::vector<YWidget *> widgets;
+    collectWidgets( dialog, widgets );
+
+    for ( YWidget * widget : widgets )
+    {
+	const YPropertySet & propSet = widget->propertySet();
+
+	for ( YPropertySet::const_iterator it = propSet.propertiesBegin(); it != propSet.propertiesEnd(); ++it )
+	{
+	    // the values of the other properties are not simple values
+	    if ( it->type() == YOtherProperty )
+		continue;
+
+	    Access access { widget, it->name(), widget->getProperty( it->name() ) };
+	    gets.push_back( access );
+
+	    if ( !it->isReadOnly() && access.value.type() != YOtherProperty )
+		sets.push_back( access );
+	}
+    }
+
+    int getCount = (int) gets.size();
+    int setCount = (int) sets.size();
+
+    bench.measure( "get property", 20 * getCount, [&]( int i )
+    {
+	const Access & access = gets[ i % getCount ];
+	access.widget->getProperty( access.name );
+    } );
+
+    // set the value that was just read, so nothing changes on the screen
+    bench.measure( "set property", 20 * setCount, [&]( int i )
+    {
+	const Access & access = sets[ i % setCount ];
+	access.widget->setProperty( access.name, access.value );
+    } );
+
+    bench.measure( "close", 1, []( int ) { YDialog::deleteTopmostDialog(); } );
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr,
+	     "Usage: %s [--lines N] [--cols N] [--items N] [--scenario NAME] [--arena]\n"
+	     "\n"
+	     "Scenarios: table, selectionbox, manywidgets, wizard, richtext, logview, logwrap,\n"
+	     "           properties\n"
+	     "\n"
+	     "--arena: Give each dialog an arena (YDialog::setUseArena())\n",
+	     prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int lines	  = 25;
+    int cols	  = 80;
+    int itemCount = 1000;
+    std::string scenario;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--arena" )
+	{
+	    YDialog::setUseArena( true );
+	    continue;
+	}
+
+	if ( i + 1 >= argc )
+	    usage( argv[0] );
+
+	if ( arg == "--lines" )
+	    lines = atoi( argv[ ++i ] );
+	else if ( arg == "--cols" )
+	    cols = atoi( argv[ ++i ] );
+	else if ( arg == "--items" )
+	    itemCount = atoi( argv[ ++i ] );
+	else if ( arg == "--scenario" )
+	    scenario = argv[ ++i ];
+	else
+	    usage( argv[0] );
+    }
+
+    if ( lines <= 0 || cols <= 0 || itemCount <= 0 )
+	usage( argv[0] );
+
+    // the size is taken from the terminal, not from the environment
+    unsetenv( "LINES" );
+    unsetenv( "COLUMNS" );
+
+    if ( !getenv( "TERM" ) || !*getenv( "TERM" ) )
+	setenv( "TERM", "xterm", 1 );
+
+    Terminal terminal( lines, cols );
+    createUI( false );
+
+    Benchmark bench( terminal, scenario );
+
+    tableScenario( bench, itemCount );
+    selectionBoxScenario( bench, itemCount );
+    manyWidgetsScenario( bench );
+    wizardScenario( bench );
+    richTextScenario( bench, lines, cols );
+    logViewScenario( bench );
+    logWrapScenario( bench, lines, cols );
+    propertiesScenario( bench );
+
+    bench.report();
+
+    // The screen updates of one UI call are written to the terminal at once
+
+    double frames = bench.frames( "selectionbox", "replace items" );
+
+    if ( frames > 1.5 )
+    {
+	fprintf( stderr, "Replacing the items took %.1f screen updates instead of 1\n", frames );
+	return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,352 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		NCStringBenchmark.cc
+
+  Throughput benchmark for recoding UTF-8 text to wide characters and
+  back: NCstring against the iconv based implementation it used before.
+  The results of both are compared, too, and short texts are recoded both
+  ways to check that they come back unchanged.
+
+/-*/
+
+#include <errno.h>
+#include <iconv.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "NCstring.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+//
+// The iconv based recoding NCstring used for UTF-8 before, as reference.
+//
+
+static void iconvToWchar( const std::string & in, std::wstring * out )
+{
+    static iconv_t cd = iconv_open( "WCHAR_T", "UTF-8" );
+    *out = L"";
+
+    if ( in.length() == 0 )
+	return;
+
+    size_t in_len = in.length();
+    char * in_ptr = const_cast<char *>( in.c_str() );
+
+    size_t tmp_size = in_len * sizeof( wchar_t );
+    char * tmp = (char *) malloc( tmp_size + sizeof( wchar_t ) );
+
+    do
+    {
+	size_t tmp_len = tmp_size;
+	char * tmp_ptr = tmp;
+
+	size_t iconv_ret = iconv( cd, &in_ptr, &in_len, &tmp_ptr, &tmp_len );
+
+	*( (wchar_t *) tmp_ptr ) = L'\0';
+	*out += std::wstring( (wchar_t *) tmp );
+
+	if ( iconv_ret == ( size_t )( -1 ) )
+	{
+	    if ( errno == EINVAL || errno == EILSEQ )
+		*out += L'?';
+
+	    in_ptr++;
+	    in_len--;
+	}
+    }
+    while ( in_len != 0 );
+
+    free( tmp );
+}
+
+
+static void iconvFromWchar( const std::wstring & in, std::string * out )
+{
+    static iconv_t cd = iconv_open( "UTF-8", "WCHAR_T" );
+    *out = "";
+
+    if ( in.length() == 0 )
+	return;
+
+    size_t in_len = in.length() * sizeof( std::wstring::value_type );
+    char * in_ptr = (char *) in.data();
+
+    size_t tmp_size = in_len * 2;
+    char * tmp = (char *) malloc( tmp_size + sizeof( char ) );
+
+    do
+    {
+	char * tmp_ptr = tmp;
+	size_t tmp_len = tmp_size;
+
+	size_t iconv_ret = iconv( cd, &in_ptr, &in_len, &tmp_ptr, &tmp_len );
+
+	*tmp_ptr = '\0';
+	*out += std::string( tmp );
+
+	if ( iconv_ret == ( size_t )( -1 ) )
+	{
+	    if ( errno == EINVAL || errno == EILSEQ )
+		*out += '?';
+
+	    in_ptr += sizeof( std::wstring::value_type );
+	    in_len -= sizeof( std::wstring::value_type );
+	}
+    }
+    while ( in_len != 0 );
+
+    free( tmp );
+}
+
+
+
+/**
+ * A set of texts to recode.
+ **/
+struct Corpus
+{
+    std::string		     name;
+    std::vector<std::string> texts;
+    size_t		     bytes;
+
+    Corpus( const std::string & name, const std::vector<std::string> & texts )
+	: name( name )
+	, texts( texts )
+	, bytes( 0 )
+    {
+	for ( const std::string & text : texts )
+	    bytes += text.size();
+    }
+};
+
+
+static std::string repeat( const std::string & text, size_t size )
+{
+    std::string result;
+
+    while ( result.size() < size )
+	result += text;
+
+    return result;
+}
+
+
+static std::vector<Corpus> corpora()
+{
+    std::vector<Corpus> result;
+
+    // widget labels and table cells: many short strings
+    std::vector<std::string> labels;
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+	static const char * words[] = { "&OK", "&Cancel", "Pizza #", "Package ",
+					"/usr/lib64/libyui.so.", "Install", "&Next" };
+
+	labels.push_back( std::string( words[ i % 7 ] ) + std::to_string( i ) );
+    }
+
+    result.push_back( Corpus( "labels", labels ) );
+
+    std::string lorem = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+	"eiusmod tempor incididunt ut labore et dolore magna aliqua. ";
+    std::string german = "Gr\xc3\xb6\xc3\x9f" "e der Partition \xc3\xa4ndern, "
+	"\xc3\x9c" "bersicht der Software-Auswahl f\xc3\xbcr die Installation. ";
+    std::string cjk = "\xe5\xae\x89\xe8\xa3\x85\xe8\xbd\xaf\xe4\xbb\xb6\xe5\x8c\x85\xef\xbc\x8c"
+	"\xe5\x88\x86\xe5\x8c\xba\xe5\xa4\xa7\xe5\xb0\x8f\xe3\x80\x82";
+
+    result.push_back( Corpus( "ascii text",  { repeat( lorem,  64 * 1024 ) } ) );
+    result.push_back( Corpus( "german text", { repeat( german, 64 * 1024 ) } ) );
+    result.push_back( Corpus( "cjk text",    { repeat( cjk,    64 * 1024 ) } ) );
+
+    // only for the comparison: invalid and incomplete sequences, NUL
+    std::string invalid = lorem + "\xff" + cjk.substr( 0, 4 ) + "x\xc0\x80\xed\xa0\x80"
+	+ std::string( "a\0b", 3 ) + "\xe4\xb8" + german;
+
+    result.push_back( Corpus( "invalid", { invalid, invalid.substr( 0, invalid.size() - 1 ) } ) );
+
+    return result;
+}
+
+
+
+/**
+ * Run 'op' over all texts of 'corpus' for about 'seconds' and print the
+ * throughput of the fastest round (the machine might be busy with other
+ * things meanwhile) and the allocations per text.
+ **/
+static void measure( const Corpus & corpus, const char * direction, const char * codec,
+		     std::function<void( size_t )> op, double seconds = 0.2 )
+{
+    unsigned long rounds = 0;
+    unsigned long allocs = allocations;
+    std::chrono::duration<double> time( 0 );
+    std::chrono::duration<double> best( seconds );
+
+    do
+    {
+	auto start = std::chrono::steady_clock::now();
+
+	for ( size_t i = 0; i < corpus.texts.size(); i++ )
+	    op( i );
+
+	std::chrono::duration<double> round = std::chrono::steady_clock::now() - start;
+
+	best  = std::min( best, round );
+	time += round;
+	rounds++;
+    }
+    while ( time.count() < seconds );
+
+    allocs = allocations - allocs;
+
+    printf( "%-12s %-10s %-6s %10.1f %12.1f %10.2f\n",
+	    corpus.name.c_str(), direction, codec,
+	    corpus.bytes / best.count() / 1e6,
+	    best.count() * 1e9 / corpus.texts.size(),
+	    double( allocs ) / ( rounds * corpus.texts.size() ) );
+}
+
+
+/**
+ * Recode ASCII texts of all lengths up to 20 and a few non-ASCII ones to
+ * wide characters and back and check that every character ends up where it
+ * was. The ASCII ones cover the block-wise loops and their tails at every
+ * offset. Return false and complain if a text comes back differently.
+ **/
+static bool checkRoundTrip()
+{
+    std::vector<std::string> texts;
+    std::string ascii = "abcdefghijklmnopqrst";
+
+    for ( size_t len = 0; len <= ascii.size(); len++ )
+	texts.push_back( ascii.substr( 0, len ) );
+
+    texts.push_back( "abcd\xc3\xa4" "efgh" );
+    texts.push_back( "\xe5\xae\x89" "abcdefgh" "\xe8\xa3\x85" "ijk" );
+    texts.push_back( "\xf0\x9f\x98\x80" "abcde" );
+
+    bool ok = true;
+
+    for ( const std::string & text : texts )
+    {
+	std::wstring wstr;
+	std::string  str;
+
+	NCstring::RecodeToWchar( text, "UTF-8", &wstr );
+	NCstring::RecodeFromWchar( wstr, "UTF-8", &str );
+
+	if ( str != text )
+	{
+	    fprintf( stderr, "Round trip: \"%s\" came back as \"%s\"\n", text.c_str(), str.c_str() );
+	    ok = false;
+	}
+    }
+
+    return ok;
+}
+
+
+int main()
+{
+    bool ok = checkRoundTrip();
+
+    printf( "%-12s %-10s %-6s %10s %12s %10s\n",
+	    "Text", "Direction", "Codec", "MB/s", "nsec/text", "allocs/text" );
+
+    for ( const Corpus & corpus : corpora() )
+    {
+	std::vector<std::wstring> wide( corpus.texts.size() );
+	std::wstring wstr;
+	std::string  str;
+
+	for ( size_t i = 0; i < corpus.texts.size(); i++ )
+	{
+	    iconvToWchar( corpus.texts[i], &wide[i] );
+	    NCstring::RecodeToWchar( corpus.texts[i], "UTF-8", &wstr );
+
+	    if ( wstr != wide[i] )
+	    {
+		fprintf( stderr, "%s: text %zu differs when recoded to wchar_t\n", corpus.name.c_str(), i );
+		ok = false;
+	    }
+
+	    iconvFromWchar( wide[i], &str );
+	    std::string expected = str;
+	    NCstring::RecodeFromWchar( wide[i], "UTF-8", &str );
+
+	    if ( str != expected )
+	    {
+		fprintf( stderr, "%s: text %zu differs when recoded from wchar_t\n", corpus.name.c_str(), i );
+		ok = false;
+	    }
+	}
+
+	if ( corpus.name == "invalid" )
+	    continue;
+
+	// The results are recoded into the same strings again and again, so
+	// this measures the recoding itself; "NCstring" includes creating and
+	// destroying the strings.
+
+	measure( corpus, "to wchar", "iconv", [&]( size_t i ) { iconvToWchar( corpus.texts[i], &wstr ); } );
+	measure( corpus, "to wchar", "utf-8", [&]( size_t i ) { NCstring::RecodeToWchar( corpus.texts[i], "UTF-8", &wstr ); } );
+	measure( corpus, "to utf-8", "iconv", [&]( size_t i ) { iconvFromWchar( wide[i], &str ); } );
+	measure( corpus, "to utf-8", "utf-8", [&]( size_t i ) { NCstring::RecodeFromWchar( wide[i], "UTF-8", &str ); } );
+	measure( corpus, "NCstring", "utf-8", [&]( size_t i ) { NCstring( corpus.texts[i] ).Str(); } );
+    }
+
+    return ok ? 0 : 1;
+}
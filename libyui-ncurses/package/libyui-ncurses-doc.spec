@@ -17,7 +17,7 @@
 #
 
 %define         parent libyui-ncurses
-%define         so_version 15
+%define         so_version 16
 
 Name:           %{parent}-doc
 
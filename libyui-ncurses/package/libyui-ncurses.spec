@@ -23,7 +23,7 @@ Name:           libyui-ncurses
 Version:        4.0.2
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         libyui_devel_version libyui-devel >= 4.0.1
 %define         bin_name %{name}%{so_version}
 
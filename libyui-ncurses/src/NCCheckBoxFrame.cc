@@ -55,7 +55,7 @@ NCCheckBoxFrame::~NCCheckBoxFrame()
 
 int NCCheckBoxFrame::preferredWidth()
 {
-    defsze.W = hasChildren() ? firstChild()->preferredWidth() : 0;
+    defsze.W = hasChildren() ? firstChild()->cachedPreferredSize( YD_HORIZ ) : 0;
 
     if ( label.width() > (unsigned) defsze.W )
 	defsze.W = label.width();
@@ -68,7 +68,7 @@ int NCCheckBoxFrame::preferredWidth()
 
 int NCCheckBoxFrame::preferredHeight()
 {
-    defsze.H  = hasChildren() ? firstChild()->preferredHeight() : 0;
+    defsze.H  = hasChildren() ? firstChild()->cachedPreferredSize( YD_VERT ) : 0;
     defsze.H += framedim.Sze.H;
 
     return defsze.H;
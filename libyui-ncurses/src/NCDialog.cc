@@ -175,8 +175,8 @@ int NCDialog::preferredWidth()
 
     if ( hasChildren() )
     {
-	csze = wsze( firstChild()->preferredHeight(),
-		     firstChild()->preferredWidth() );
+	csze = wsze( firstChild()->cachedPreferredSize( YD_VERT ),
+		     firstChild()->cachedPreferredSize( YD_HORIZ ) );
     }
 
     csze = wsze::min( wGetDefsze(), wsze::max( csze, wsze( 1 ) ) );
@@ -196,8 +196,8 @@ int NCDialog::preferredHeight()
 
     if ( hasChildren() )
     {
-	csze = wsze( firstChild()->preferredHeight(),
-		     firstChild()->preferredWidth() );
+	csze = wsze( firstChild()->cachedPreferredSize( YD_VERT ),
+		     firstChild()->cachedPreferredSize( YD_HORIZ ) );
     }
 
     csze = wsze::min( wGetDefsze(),
@@ -533,6 +533,10 @@ void NCDialog::wUpdate( bool forced_br )
     if ( !pan )
 	return;
 
+    // All widgets of this dialog request their updates here, so this is
+    // where the user or the application changed something
+    contentChanged();
+
     if ( !forced_br
 	 && ( pan->hidden() || inMultiDraw_i ) )
 	return;
@@ -808,6 +812,11 @@ wint_t NCDialog::getch( int timeout_millisec )
 {
     wint_t got = WEOF;
 
+    // Don't keep the user waiting for the changes of the current update
+    // batch, e.g. in a popup opened while handling a key
+    if ( timeout_millisec != 0 )
+	NCurses::flushUpdateBatch();
+
     if ( timeout_millisec < 0 )
     {
 	// wait for input
@@ -899,6 +908,10 @@ void NCDialog::idleInput()
 
     // yuiDebug() << "idle+ " << this << std::endl;
 
+    // All keys typed ahead are processed without waiting: write the
+    // changes at once
+    NCurses::UpdateBatch batch;
+
     if ( !active )
     {
 	if ( flushTypeahead() )
@@ -927,6 +940,8 @@ NCursesEvent NCDialog::pollInput()
 	return NCursesEvent::cancel;
     }
 
+    NCurses::UpdateBatch batch;
+
     if ( pendingEvent )
     {
 	if ( active )
@@ -1033,6 +1048,7 @@ void NCDialog::processInput( int timeout_millisec )
     if ( wActive->GetState() != NC::WSactive )
     {
 	// yuiDebug() << "noactive item => reactivate!" << std::endl;
+	NCurses::UpdateBatch batch;
 	Activate();
     }
 
@@ -1074,6 +1090,9 @@ void NCDialog::processInput( int timeout_millisec )
 
 	ch = getch( timeout_millisec );
 
+	// Write all changes caused by this key at once
+	NCurses::UpdateBatch batch;
+
 	switch ( ch )
 	{
 	    // case KEY_RESIZE: is directly handled in NCDialog::getch.
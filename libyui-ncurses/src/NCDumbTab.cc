@@ -50,7 +50,7 @@ NCDumbTab::~NCDumbTab()
 
 int NCDumbTab::preferredWidth()
 {
-    defsze.W = hasChildren() ? firstChild()->preferredWidth() : 0;
+    defsze.W = hasChildren() ? firstChild()->cachedPreferredSize( YD_HORIZ ) : 0;
 
     YItemIterator listIt = itemsBegin();
 
@@ -79,7 +79,7 @@ int NCDumbTab::preferredWidth()
 
 int NCDumbTab::preferredHeight()
 {
-    defsze.H  = hasChildren() ? firstChild()->preferredHeight() : 0;
+    defsze.H  = hasChildren() ? firstChild()->cachedPreferredSize( YD_VERT ) : 0;
     defsze.H += framedim.Sze.H;
 
     return defsze.H;
@@ -49,7 +49,7 @@ NCFrame::~NCFrame()
 
 int NCFrame::preferredWidth()
 {
-    defsze.W = hasChildren() ? firstChild()->preferredWidth() : 0;
+    defsze.W = hasChildren() ? firstChild()->cachedPreferredSize( YD_HORIZ ) : 0;
 
     if ( label.width() > (unsigned) defsze.W )
 	defsze.W = label.width();
@@ -62,7 +62,7 @@ int NCFrame::preferredWidth()
 
 int NCFrame::preferredHeight()
 {
-    defsze.H  = hasChildren() ? firstChild()->preferredHeight() : 0;
+    defsze.H  = hasChildren() ? firstChild()->cachedPreferredSize( YD_VERT ) : 0;
     defsze.H += framedim.Sze.H;
 
     return defsze.H;
@@ -27,6 +27,44 @@
 #include "NCLogView.h"
 
 
+/**
+ * The pad of a NCLogView. It is always paging (see
+ * NCPad::setAlwaysPaging()): It only holds the visible rows, and they are
+ * drawn from the wrapped text whenever the pad is updated. So appending,
+ * scrolling and resizing don't depend on the size of the log.
+ **/
+class NCLogPad : public NCPad
+{
+public:
+
+    NCLogPad( int lines, int cols, const NCWidget & p, NCwrappedText & text )
+	: NCPad( lines, cols, p )
+	, _text( text )
+    {
+	setAlwaysPaging( true );
+    }
+
+protected:
+
+    virtual void directDraw( NCursesWindow & w, const wrect at, unsigned lineno )
+    {
+	w.move( at.Pos.L, at.Pos.C );
+	w.clrtoeol();
+
+	if ( lineno < _text.Rows() )
+	{
+	    _text.row( lineno, _row );
+	    w.addwstr( _row.c_str() );
+	}
+    }
+
+private:
+
+    NCwrappedText & _text;
+    std::wstring    _row;	///< buffer for the drawn row
+};
+
+
 NCLogView::NCLogView( YWidget * parent,
 		      const std::string & nlabel,
 		      int visibleLines,
@@ -82,16 +120,100 @@ void NCLogView::setLabel( const std::string & nlabel )
 void NCLogView::displayLogText( const std::string & ntext )
 {
     DelPad();
-    text = NCtext( NCstring( ntext ), Columns() );
+
+    text.clear();
+    text.setWrapColumns( Columns() );
+
+    std::string::size_type from = 0;
+
+    while ( from < ntext.size() )
+    {
+	std::string::size_type to = ntext.find( '\n', from );
+
+	if ( to == std::string::npos )
+	    to = ntext.size();
+	else
+	    to++;
+
+	appendLine( ntext.substr( from, to - from ) );
+	from = to;
+    }
+
     Redraw();
 }
 
 
+void NCLogView::displayAppendedLines( const std::vector<std::string> & newLines,
+				      bool lastLineReplaced,
+				      int  droppedLines )
+{
+    if ( lastLineReplaced && text.Lines() > 0 )
+	text.removeLastLines( 1 );
+
+    for ( std::vector<std::string>::const_iterator it = newLines.begin(); it != newLines.end(); ++it )
+	appendLine( *it );
+
+    if ( droppedLines > 0 )
+	text.removeFirstLines( std::min( (unsigned) droppedLines, text.Lines() ) );
+
+    if ( text.wrapColumns() != Columns() )
+    {
+	// The width changed: Rewrap (as far as needed) and redraw everything
+
+	text.setWrapColumns( Columns() );
+	DelPad();
+	Redraw();
+	return;
+    }
+
+    if ( !myPad() || !myPad()->Destwin() )
+    {
+	// Nothing drawn yet: The next redraw will draw everything
+
+	Redraw();
+	return;
+    }
+
+    // The pad only holds the visible rows: Scrolling to the new end draws
+    // just those
+
+    AdjustPad( wsze( text.Rows(), Columns() ) );
+    myPad()->ScrlTo( wpos( text.Rows(), 0 ) );
+    Update();
+}
+
+
+void NCLogView::appendLine( const std::string & line )
+{
+    // A log line may contain more newlines; the trailing one is implicit
+
+    std::string::size_type from = 0;
+    std::string::size_type to	= line.find( '\n' );
+
+    while ( to != std::string::npos && to + 1 < line.size() )
+    {
+	text.append( NCstring( line.substr( from, to - from ) ) );
+	from = to + 1;
+	to   = line.find( '\n', from );
+    }
+
+    if ( to == std::string::npos )
+	to = line.size();
+
+    text.append( NCstring( line.substr( from, to - from ) ) );
+}
+
+
 void NCLogView::wRedraw()
 {
     if ( !win )
 	return;
 
+    // After a resize: Rewrap the text if the width changed
+
+    if ( myPad() && !myPad()->Destwin() && (size_t) defPadSze().W != text.wrapColumns() )
+	DelPad();
+
     bool initial = ( !myPad() || !myPad()->Destwin() );
 
     if ( myPad() )
@@ -100,7 +222,7 @@ void NCLogView::wRedraw()
     NCPadWidget::wRedraw();
 
     if ( initial )
-	myPad()->ScrlTo( wpos( text.Lines(), 0 ) );
+	myPad()->ScrlTo( wpos( text.Rows(), 0 ) );
 }
 
 
@@ -121,7 +243,7 @@ NCursesEvent NCLogView::wHandleInput( wint_t key )
 NCPad * NCLogView::CreatePad()
 {
     wsze psze( defPadSze() );
-    NCPad * npad = new NCPad( psze.H, psze.W, *this );
+    NCPad * npad = new NCLogPad( psze.H, psze.W, *this, text );
     npad->bkgd( listStyle().item.plain );
     return npad;
 }
@@ -129,32 +251,8 @@ NCPad * NCLogView::CreatePad()
 
 void NCLogView::DrawPad()
 {
-    // maximal value for lines is 32000!
-    unsigned maxLines = 20000;
-    unsigned skipLines = 0;
-    unsigned lines = text.Lines();
-    unsigned cl = 0;
-
-    if ( lines > maxLines )
-    {
-	skipLines = lines - maxLines;
-	lines = maxLines;
-    }
-
-    AdjustPad( wsze( lines, Columns() ) );
+    // The rows are drawn when the pad is updated (see NCLogPad)
 
-    for ( NCtext::const_iterator line = text.begin(); line != text.end(); ++line )
-    {
-	if ( skipLines == 0 )
-	{
-	    myPad()->move( cl++, 0 );
-	    std::wstring cline = ( *line ).str();
-	    myPad()->addwstr( cline.c_str() );
-	}
-	else
-	{
-	    skipLines--;
-	}
-    }
+    text.setWrapColumns( Columns() );
+    AdjustPad( wsze( text.Rows(), Columns() ) );
 }
-
@@ -41,7 +41,12 @@ private:
     NCLogView( const NCLogView & );
 
 
-    NCtext text;
+    NCwrappedText text;		///< the log lines, wrapped to the pad width
+
+    /**
+     * Add one log line to 'text'.
+     **/
+    void appendLine( const std::string & line );
 
 protected:
 
@@ -69,6 +74,10 @@ public:
     virtual void setLabel( const std::string & nlabel );
     virtual void displayLogText( const std::string & ntext );
 
+    virtual void displayAppendedLines( const std::vector<std::string> & newLines,
+				       bool lastLineReplaced,
+				       int  droppedLines );
+
     virtual NCursesEvent wHandleInput( wint_t key );
 
     virtual void setEnabled( bool do_bv );
@@ -22,6 +22,8 @@
 
 /-*/
 
+#include <algorithm>
+
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
 #include "NCPad.h"
@@ -40,6 +42,7 @@
 NCPad::NCPad( int lines, int cols, const NCWidget & p )
   : NCursesPad( lines > MAX_PAD_HEIGHT ? PAD_PAGESIZE : lines, cols )
   , _vheight( lines > MAX_PAD_HEIGHT ? lines : 0 )
+  , _alwaysPaging( false )
   , parw( p )
   , destwin ( 0 )
   , maxdpos ( 0 )
@@ -80,18 +83,44 @@ void NCPad::resize( wsze nsze )
 {
     SetPadSize( nsze ); // might be enlarged by NCPadWidget if redirected
 
+    bool page = nsze.H > MAX_PAD_HEIGHT || ( _alwaysPaging && nsze.H > 0 );
+
+    if ( page && paging() && destwin
+	 && nsze.W == width()
+	 && height() >= std::min( nsze.H, drect.Sze.H ) )
+    {
+	// Only the virtual height of the paging pad changes, and the pad
+	// itself is still large enough for the visible lines: Keep it and
+	// just adjust the scroll range. The visible lines are drawn with the
+	// next update, like after a change of the content.
+
+	_vheight = nsze.H;
+
+	wsze mysze( vheight(), width() );
+
+	srect.Sze = wsze::min( mysze, drect.Sze );
+	maxdpos = drect.Pos + srect.Sze - 1;
+	maxspos = mysze - srect.Sze;
+	srect.Pos = srect.Pos.between( 0, maxspos );
+
+	dclear = ( drect.Sze != srect.Sze );
+
+	return;
+    }
+
     if ( nsze.H != vheight()
-	 || nsze.W != width() )
+	 || nsze.W != width()
+	 || page != paging() )
     {
 	NCursesWindow * odest = Destwin();
 
 	if ( odest )
 	    Destwin( 0 );
 
-        if ( nsze.H > MAX_PAD_HEIGHT )
+        if ( page )
         {
 	    // yuiDebug() << "TRUNCATE PAD: " << nsze.H << " > " << MAX_PAD_HEIGHT << std::endl;
-	    NCursesPad::resize( PAD_PAGESIZE, nsze.W );
+	    NCursesPad::resize( std::min( nsze.H, PAD_PAGESIZE ), nsze.W );
 	    _vheight = nsze.H;
         }
         else
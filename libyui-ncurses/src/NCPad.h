@@ -123,11 +123,14 @@ private:
      *
      * \todo Once all NCPad based types are able to page, \a maxPadHeight could be
      * std::set to e.g \c 1024 to avoid bigger widgets in memory. Currently just
-     * \ref NCTablePad supports paging. If paging is \c ON, all content lines are
+     * \ref NCTablePadBase supports paging. If paging is \c ON, all content lines are
      * written via \ref directDraw. Without paging \ref DoRedraw is reponsible for this.
      */
     int   _vheight;
 
+    /** Whether to page regardless of the height, see \ref setAlwaysPaging. */
+    bool  _alwaysPaging;
+
 protected:
 
     const NCWidget & parw;
@@ -148,6 +151,17 @@ protected:
     /** Whether the Pad is truncated (we're paging). */
     bool paging() const { return _vheight; }
 
+    /** Page even if the Pad could hold all lines.
+     *
+     * A paging Pad holds at most one page of lines, and only the lines
+     * in the visible part are drawn (via \ref directDraw) when it is
+     * updated. Scrolling and redrawing then don't depend on the number
+     * of lines.
+     *
+     * Takes effect on the next \ref resize.
+     */
+    void setAlwaysPaging( bool on ) { _alwaysPaging = on; }
+
     virtual int dirtyPad() { dirty = false; return setpos( CurPos() ); }
 
     /// Set the visible position to *newpos* (but clamp by *maxspos*), then \ref update.
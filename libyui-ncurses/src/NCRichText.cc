@@ -29,6 +29,7 @@
 #include "stringutil.h"
 #include "stdutil.h"
 #include <sstream>
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 
 #include <yui/YMenuItem.h>
@@ -170,12 +171,15 @@ NCRichText::NCRichText( YWidget * parent, const std::string & ntext,
 	, text( ntext )
 	, plainText( plainTextMode )
 	, textwidth( 0 )
-	, cl( 0 )
-	, cc( 0 )
-	, cindent( 0 )
-	, atbol( true )
-	, preTag( false )
-	, Tattr( 0 )
+	, armed( Anchor::unset )
+	, vScrollFirstvisible( 0 )
+	, vScrollNextinvisible( 0 )
+	, parsed( false )
+	, reparse( 0 )
+	, reparseFrom( 0 )
+	, reparsePre( false )
+	, resumeClean( false )
+	, drawnLines( 0 )
 {
     // yuiDebug() << std::endl;
     activeLabelOnly = true;
@@ -225,16 +229,134 @@ void NCRichText::setValue( const std::string & ntext )
 {
     DelPad();
     text = NCstring( ntext );
+
+    if ( plainText )
+	plainLines = NCtext( text );
+
+    // parse and lay out the new text on the next redraw
+    parsed = false;
+    elements.clear();
+    layouts.clear();
+
     YRichText::setValue( ntext );
     Redraw();
 }
 
 
+void NCRichText::appendText( const std::string & ntext )
+{
+    if ( ntext.empty() )
+	return;
+
+    YRichText::setValue( value() + ntext );
+    text += NCstring( ntext );
+
+    if ( plainText )
+    {
+	// the old last line might be continued, the lines before don't change
+	unsigned first = plainLines.Lines() ? plainLines.Lines() - 1 : 0;
+	plainLines = NCtext( text );
+
+	if ( myPad() && myPad()->Destwin() )
+	{
+	    DrawPlainPad( first );
+
+	    if ( autoScrollDown() )
+		myPad()->ScrlTo( wpos( myPad()->maxy(), 0 ) );
+
+	    Redraw();
+	}
+
+	return;
+    }
+
+    if ( !parsed )
+	return; // nothing drawn yet
+
+    size_t oldReparse = reparse;
+    ParseHTML();
+
+    // Continue the layouts at the old reparse point
+
+    std::map<unsigned, Layout>::iterator current = layouts.find( textwidth );
+    LayoutState oldResume;
+
+    if ( current != layouts.end() )
+	oldResume = current->second.resume;
+
+    for ( std::map<unsigned, Layout>::iterator it = layouts.begin(); it != layouts.end(); )
+    {
+	Layout & lay = it->second;
+
+	if ( lay.resume.element != oldReparse )
+	{
+	    if ( it == current )
+		current = layouts.end();
+
+	    layouts.erase( it++ );
+	    continue;
+	}
+
+	lay.ops.resize( lay.resume.ops );
+	lay.anchors.resize( lay.resume.anchors );
+	lay.state  = lay.resume;
+	lay.sealed = lay.ops.size();
+	LayoutHTML( lay );
+	++it;
+    }
+
+    // Continue drawing the pad at the old reparse point if nothing was
+    // drawn behind that position yet; otherwise draw it completely
+
+    if ( !myPad() || !myPad()->Destwin() || current == layouts.end()
+	 || !resumeClean || resumeEnd.L >= (int) drawnLines )
+    {
+	DelPad();
+	Redraw();
+	return;
+    }
+
+    Layout & lay = current->second;
+
+    // new and cleared cells get the plain background like on a full redraw
+    myPad()->bkgdset( wStyle().richtext.plain );
+    AdjustPad( wsze( lay.state.lines, oldResume.textwidth ) );
+    myPad()->move( resumePos.L, resumePos.C );
+    myPad()->clrtobot();
+    myPad()->bkgdset( textStyle( oldResume.Tattr ) );
+    drawnEnd = resumeEnd;
+    DrawOps( lay, oldResume.ops );
+
+    drawnLines = lay.state.atbol ? lay.state.cl : lay.state.cl + 1;
+    AdjustPad( wsze( drawnLines, lay.state.textwidth ) );
+
+    anchors = lay.anchors;
+
+    if ( armed != Anchor::unset && armed >= anchors.size() )
+	armed = Anchor::unset;
+
+    if ( autoScrollDown() )
+	myPad()->ScrlTo( wpos( myPad()->maxy(), 0 ) );
+
+    Redraw();
+}
+
+
 void NCRichText::wRedraw()
 {
     if ( !win )
 	return;
 
+    // The pad was detached on a resize: Lay out the text for the new width
+    int line = -1;
+
+    if ( !plainText && myPad() && !myPad()->Destwin()
+	 && (unsigned) defPadSze().W != textwidth )
+    {
+	line = myPad()->CurPos().L;
+	DelPad();
+    }
+
     bool initial = ( !myPad() || !myPad()->Destwin() );
 
     if ( !( plainText || anchors.empty() ) )
@@ -246,6 +368,10 @@ void NCRichText::wRedraw()
     {
 	myPad()->ScrlTo( wpos( myPad()->maxy(), 0 ) );
     }
+    else if ( line > 0 )
+    {
+	myPad()->ScrlLine( line );
+    }
 
     return;
 }
@@ -317,7 +443,7 @@ void NCRichText::DrawPad()
     myPad()->clear();
 
     if ( plainText )
-	DrawPlainPad();
+	DrawPlainPad( 0 );
     else
 	DrawHTMLPad();
 
@@ -325,45 +451,23 @@ void NCRichText::DrawPad()
 }
 
 
-void NCRichText::DrawPlainPad()
-{
-    NCtext ftext( text );
-    // yuiDebug() << "ftext is " << wsze( ftext.Lines(), ftext.Columns() ) << std::endl;
-
-    AdjustPad( wsze( ftext.Lines(), ftext.Columns() ) );
-
-    cl = 0;
-
-    for ( NCtext::const_iterator line = ftext.begin();
-	  line != ftext.end(); ++line, ++cl )
-    {
-	myPad()->addwstr( cl, 0, ( *line ).str().c_str() );
-    }
-}
-
-void NCRichText::PadPreTXT( const wchar_t * osch, const unsigned olen )
+void NCRichText::DrawPlainPad( unsigned firstLine )
 {
-    std::wstring wtxt( osch, olen );
+    // yuiDebug() << "plainLines is " << wsze( plainLines.Lines(), plainLines.Columns() ) << std::endl;
 
-    // resolve the entities even in PRE (#71718)
-    wtxt = filterEntities( wtxt );
-
-    NCstring nctxt( wtxt );
-    NCtext ftext( nctxt );
+    AdjustPad( wsze( plainLines.Lines(), plainLines.Columns() ) );
 
-    // insert the text
-    const wchar_t * sch = wtxt.data();
-
-    while ( *sch )
+    for ( unsigned cl = firstLine; cl < plainLines.Lines(); ++cl )
     {
-	myPad()->addwstr( sch, 1 );	// add one wide chararacter
-
-	++sch;
+	// control characters might have wrapped the line before into this one
+	myPad()->move( cl, 0 );
+	myPad()->clrtoeol();
+	myPad()->addwstr( plainLines[cl].str().c_str() );
     }
 }
 
 //
-// DrawHTMLPad tools
+// ParseHTML tools
 //
 
 inline void SkipToken( const wchar_t *& wch )
@@ -417,79 +521,35 @@ inline void SkipPreTXT( const wchar_t *& wch )
 }
 
 
-//
-// Calculate longest line of text in <pre> </pre> tags
-// and adjust the pad accordingly
-//
-void NCRichText::AdjustPrePad( const wchar_t *osch )
-{
-    const wchar_t * wch = osch;
-    std::wstring wstr( wch, 6 );
-
-    do
-    {
-        ++wch;
-	wstr.assign( wch, 6 );
-    }
-    while ( *wch && wstr != L"</pre>" );
-
-    std::wstring wtxt( osch, wch - osch );
-
-    // resolve the entities to get correct length for calculation of longest line
-    wtxt = filterEntities( wtxt );
-
-    // replace <br> by \n to get appropriate lines in NCtext
-    boost::replace_all( wtxt, L"<br>", L"\n" );
-    boost::replace_all( wtxt, L"<br/>", L"\n" );
-
-    // yuiDebug() << "Text: " << wtxt << " initial length: " << wch - osch << std::endl;
-
-    NCstring nctxt( wtxt );
-    NCtext ftext( nctxt );
-
-    std::list<NCstring>::const_iterator line;
-    size_t llen = 0;		// longest line
-
-    // iterate through NCtext
-    for ( line = ftext.Text().begin(); line != ftext.Text().end(); ++line )
-    {
-	size_t tmp_len = 0;
-
-        tmp_len = textWidth( (*line).str() );
-
-	if ( tmp_len > llen )
-	    llen = tmp_len;
-    }
-    // yuiDebug() << "Longest line: " << llen << std::endl;
-
-    if ( llen > textwidth )
-    {
-	textwidth = llen;
-	AdjustPad( wsze( cl + ftext.Lines(), llen ) );	// adjust pad to longest line
-    }
-
-}
-
-void NCRichText::DrawHTMLPad()
+/**
+ * Split the text (from 'reparseFrom' on) into elements. Afterwards
+ * 'reparse' is the first element which might be changed by appending text.
+ **/
+void NCRichText::ParseHTML()
 {
-    // yuiDebug() << "Start:" << std::endl;
-
-    liststack = std::stack<int>();
-    canchor = Anchor();
-    anchors.clear();
-    armed = Anchor::unset;
-
-    cl = 0;
-    cc = 0;
-    cindent = 0;
-    myPad()->move( cl, cc );
-    atbol = true;
-
-    const wchar_t * wch = ( wchar_t * )text.str().data();
+    const wchar_t * begin = text.str().c_str();
+    const wchar_t * wch = begin + reparseFrom;
     const wchar_t * swch = 0;
+    bool pre = reparsePre;
+    size_t openPre = std::wstring::npos;	// <pre> whose end is not in the text
+
+    elements.resize( reparse );
 
     while ( *wch )
     {
+	Element element;
+	element.kind	     = Element::WORD;
+	element.token	     = T_UNKNOWN;
+	element.endtag	     = false;
+	element.pre	     = pre;
+	element.leveltag     = 0;
+	element.headinglevel = 0;
+	element.source	     = wch - begin;
+	element.length	     = 0;
+	element.width	     = 0;
+	element.lines	     = 0;
+	element.filtered     = false;
+
 	switch ( *wch )
 	{
 	    case L' ':
@@ -498,10 +558,11 @@ void NCRichText::DrawHTMLPad()
 	    case L'\v':
 	    case L'\r':
             case L'\f':
-		if ( ! preTag )
+		if ( ! pre )
 		{
 		    SkipWS( wch );
-		    PadWS();
+		    element.kind = Element::SPACE;
+		    elements.push_back( element );
 		}
 		else
 		{
@@ -509,12 +570,15 @@ void NCRichText::DrawHTMLPad()
 		    {
 			case L' ':	// add white space
 			case L'\t':
-			    myPad()->addwstr( wch, 1 );
+			    element.kind   = Element::PRE_TEXT;
+			    element.length = 1;
+			    elements.push_back( element );
 			    break;
 
 			case L'\n':
                         case L'\f':
-			    PadNL();	// add new line
+			    element.kind = Element::PRE_NL;	// add new line
+			    elements.push_back( element );
 			    break;
 
 			default:
@@ -529,114 +593,162 @@ void NCRichText::DrawHTMLPad()
 		swch = wch;
 		SkipToken( wch );
 
-		if ( PadTOKEN( swch, wch ) )
+		if ( ParseTOKEN( swch, wch, element ) )
+		{
+		    if ( element.token == T_PLAIN )
+		    {
+			pre = !element.endtag;	// display text preserving newlines and spaces
+
+			if ( pre && !ParsePreText( wch - begin, element )
+			     && openPre == std::wstring::npos )
+			{
+			    openPre = elements.size();
+			}
+		    }
+
+		    if ( element.token != T_IGNORE && element.token != T_UNKNOWN )
+			elements.push_back( element );
+
 		    break;	// strip token
+		}
 		else
 		    wch = swch;		// reset and fall through
 
 	    default:
 		swch = wch;
 
-		if ( !preTag )
+		if ( !pre )
 		{
 		    SkipWord( wch );
-		    PadTXT( swch, wch - swch );
+		    element.kind = Element::WORD;
 		}
 		else
 		{
 		    SkipPreTXT( wch );
-		    PadPreTXT( swch, wch - swch );
+		    element.kind = Element::PRE_TEXT;
+		}
+
+		element.length = wch - swch;
+		element.width  = textWidth( swch, wch - swch );
+
+		// resolve the entities (even in PRE, #71718)
+		if ( std::find( swch, wch, L'&' ) != wch )
+		{
+		    element.filtered = true;
+		    element.str	     = filterEntities( std::wstring( swch, wch - swch ) );
+		    element.width    = textWidth( element.str );
+
+		    // the text is written up to a NUL only (e.g. from "&#0;")
+		    element.str.resize( wcslen( element.str.c_str() ) );
 		}
 
+		elements.push_back( element );
+
 		break;
 	}
     }
 
-    PadBOL();
-    AdjustPad( wsze( cl, textwidth ) );
+    reparse	= elements.size();
+    reparseFrom = wch - begin;
+    reparsePre	= pre;
 
-#if 0
-    yuiDebug() << "Anchors: " << anchors.size() << std::endl;
+    auto reparseAt = [this]( size_t idx )
+    {
+	if ( idx >= reparse )
+	    return;
 
-    for ( unsigned i = 0; i < anchors.size(); ++i )
+	reparse	    = idx;
+	reparseFrom = elements[idx].source;
+	reparsePre  = elements[idx].pre;
+    };
+
+    // Appended text might continue the last word or white space
+    if ( !elements.empty() )
     {
-	yuiDebug() << form( "  %2d: [%2d,%2d] -> [%2d,%2d]",
-			    i,
-			    anchors[i].sline, anchors[i].scol,
-			    anchors[i].eline, anchors[i].ecol ) << std::endl;
-    }
-#endif
-}
+	Element::Kind last = elements.back().kind;
 
+	if ( last == Element::WORD || last == Element::SPACE || last == Element::PRE_TEXT )
+	    reparseAt( elements.size() - 1 );
+    }
 
-inline void NCRichText::PadNL()
-{
-    cc = cindent;
+    // or turn an unclosed '<' into a tag
+    const std::wstring & wtext = text.str();
+    std::wstring::size_type gt = wtext.rfind( L'>' );
+    std::wstring::size_type lt = wtext.find( L'<', gt == std::wstring::npos ? 0 : gt + 1 );
 
-    if ( ++cl == (unsigned) myPad()->height() )
+    if ( lt != std::wstring::npos && lt < reparseFrom )
     {
-	AdjustPad( wsze( myPad()->height() + defPadSze().H, textwidth ) );
+	size_t idx = reparse;
+
+	while ( idx > 0 && elements[idx - 1].source >= lt )
+	    --idx;
+
+	reparseAt( idx );
     }
 
-    myPad()->move( cl, cc );
+    // or contain the end of an open <pre>
+    if ( openPre != std::wstring::npos )
+	reparseAt( openPre );
 
-    atbol = true;
+    parsed = true;
 }
 
 
-inline void NCRichText::PadBOL()
+//
+// Calculate longest line of text in <pre> </pre> tags
+// Returns false if the end tag was not found.
+//
+bool NCRichText::ParsePreText( size_t from, Element & element )
 {
-    if ( !atbol )
-	PadNL();
-}
+    const std::wstring & wtext = text.str();
 
+    // the end tag is searched from the 2nd character on
+    std::wstring::size_type end = std::wstring::npos;
 
-inline void NCRichText::PadWS( bool tab )
-{
-    if ( atbol )
-	return; // no WS at beginning of line
+    if ( from < wtext.size() )
+	end = wtext.find( L"</pre>", from + 1 );
 
-    if ( cc == textwidth )
-    {
-	PadNL();
-    }
-    else
-    {
-	myPad()->addwstr( L" " );
-	++cc;
-    }
-}
+    bool found = ( end != std::wstring::npos );
 
+    if ( !found )
+	end = wtext.size();
 
-inline void NCRichText::PadTXT( const wchar_t * osch, const unsigned olen )
-{
-    std::wstring txt( osch, olen );
+    std::wstring wtxt( wtext, std::min( from, end ), end - std::min( from, end ) );
+
+    // resolve the entities to get correct length for calculation of longest line
+    wtxt = filterEntities( wtxt );
 
-    txt = filterEntities( txt );
+    // replace <br> by \n to get appropriate lines in NCtext
+    boost::replace_all( wtxt, L"<br>", L"\n" );
+    boost::replace_all( wtxt, L"<br/>", L"\n" );
 
-    size_t	len = textWidth( txt );
+    // yuiDebug() << "Text: " << wtxt << " initial length: " << end - from << std::endl;
 
-    if ( !atbol && cc + len > textwidth )
-	PadNL();
+    NCstring nctxt( wtxt );
+    NCtext ftext( nctxt );
 
-    // insert the text
-    const wchar_t * sch = txt.data();
+    NCtext::const_iterator line;
+    size_t llen = 0;		// longest line
 
-    while ( *sch )
+    // iterate through NCtext
+    for ( line = ftext.Text().begin(); line != ftext.Text().end(); ++line )
     {
-	myPad()->addwstr( sch, 1 );	// add one wide chararacter
-	cc += wcwidth( *sch );
-	atbol = false;	// at begin of line = false
+	size_t tmp_len = 0;
 
-	if ( cc >= textwidth )
-	{
-	    PadNL();	// add a new line
-	}
+        tmp_len = textWidth( (*line).str() );
 
-	sch++;
+	if ( tmp_len > llen )
+	    llen = tmp_len;
     }
+    // yuiDebug() << "Longest line: " << llen << std::endl;
+
+    element.width = llen;
+    element.lines = ftext.Lines();
+
+    return found;
 }
 
+
 /**
  * Get the number of columns needed to print a 'std::wstring'. Only printable characters
  * are taken into account because otherwise 'wcwidth' would return -1 (e.g. for '\n').
@@ -644,12 +756,11 @@ inline void NCRichText::PadTXT( const wchar_t * osch, const unsigned olen )
  * Attention: only use textWidth() to calculate space, not for iterating through a text
  * or to get the length of a text (real text length includes new lines).
  */
-size_t NCRichText::textWidth( std::wstring wstr )
+size_t NCRichText::textWidth( const wchar_t * wstr, size_t wlen )
 {
     size_t len = 0;
-    std::wstring::const_iterator wstr_it;	// iterator for std::wstring
 
-    for ( wstr_it = wstr.begin(); wstr_it != wstr.end() ; ++wstr_it )
+    for ( const wchar_t * wstr_it = wstr; wstr_it != wstr + wlen; ++wstr_it )
     {
 	// check whether char is printable
 	if ( iswprint( *wstr_it ) )
@@ -658,7 +769,7 @@ size_t NCRichText::textWidth( std::wstring wstr )
 	}
 	else if ( *wstr_it == '\t' )
 	{
-	    len += myPad()->tabsize();
+	    len += NCursesWindow::tabsize();
 	}
     }
 
@@ -666,167 +777,69 @@ size_t NCRichText::textWidth( std::wstring wstr )
 }
 
 
-/**
- * Set character attributes (e.g. color, font face...)
- **/
-inline void NCRichText::PadSetAttr()
+std::wstring NCRichText::ParseAnchorTarget( std::wstring args )
 {
-    const NCstyle::StRichtext & style( wStyle().richtext );
-    chtype nbg = style.plain;
+    const wchar_t * ch = ( wchar_t * )args.data();
+    const wchar_t * lookupstr = L"href = ";
+    const wchar_t * lookup = lookupstr;
 
-    if ( Tattr & T_ANC )
-    {
-	nbg = style.link;
-    }
-    else if ( Tattr & T_HEAD )
-    {
-	nbg = style.title;
-    }
-    else
+    for ( ; *ch && *lookup; ++ch )
     {
-	switch ( Tattr & Tfontmask )
+	wchar_t c = towlower( *ch );
+
+	switch ( c )
 	{
-	    case T_BOLD:
-		nbg = style.B;
-		break;
+	    case L'\t':
+	    case L' ':
 
-	    case T_IT:
-		nbg = style.I;
-		break;
+		if ( *lookup != L' ' )
+		    lookup = lookupstr;
 
-	    case T_TT:
-		nbg = style.T;
 		break;
 
-	    case T_BOLD|T_IT:
-		nbg = style.BI;
-		break;
+	    default:
+		if ( *lookup == L' ' )
+		{
+		    ++lookup;
 
-	    case T_BOLD|T_TT:
-		nbg = style.BT;
-		break;
+		    if ( !*lookup )
+		    {
+			// ch is the 1st char after lookupstr
+			--ch; // end of loop will ++ch
+			break;
+		    }
+		}
 
-	    case T_IT|T_TT:
-		nbg = style.IT;
-		break;
+		if ( c == *lookup )
+		    ++lookup;
+		else
+		    lookup = lookupstr;
 
-	    case T_BOLD|T_IT|T_TT:
-		nbg = style.BIT;
 		break;
 	}
     }
 
-    myPad()->bkgdset( nbg );
-}
+    if ( !*lookup )
+    {
+	const wchar_t * delim = ( *ch == L'"' ) ? L"\"" : L" \t";
+	args = ( *ch == L'"' ) ? ++ch : ch;
 
+	std::wstring::size_type end = args.find_first_of( delim );
 
-void NCRichText::PadSetLevel()
-{
-    cindent = listindent * liststack.size();
+	if ( end != std::wstring::npos )
+	    args.erase( end );
 
-    if ( cindent > textwidth / 2 )
-	cindent = textwidth / 2;
-
-    if ( atbol )
-    {
-	cc = cindent;
-	myPad()->move( cl, cc );
-    }
-}
-
-
-void NCRichText::PadChangeLevel( bool down, int tag )
-{
-    if ( down )
-    {
-	if ( liststack.size() )
-	    liststack.pop();
-    }
-    else
-    {
-	liststack.push( tag );
-    }
-
-    PadSetLevel();
-}
-
-
-void NCRichText::openAnchor( std::wstring args )
-{
-    canchor.open( cl, cc );
-
-    const wchar_t * ch = ( wchar_t * )args.data();
-    const wchar_t * lookupstr = L"href = ";
-    const wchar_t * lookup = lookupstr;
-
-    for ( ; *ch && *lookup; ++ch )
-    {
-	wchar_t c = towlower( *ch );
-
-	switch ( c )
-	{
-	    case L'\t':
-	    case L' ':
-
-		if ( *lookup != L' ' )
-		    lookup = lookupstr;
-
-		break;
-
-	    default:
-		if ( *lookup == L' ' )
-		{
-		    ++lookup;
-
-		    if ( !*lookup )
-		    {
-			// ch is the 1st char after lookupstr
-			--ch; // end of loop will ++ch
-			break;
-		    }
-		}
-
-		if ( c == *lookup )
-		    ++lookup;
-		else
-		    lookup = lookupstr;
-
-		break;
-	}
+	return args;
     }
 
-    if ( !*lookup )
-    {
-	const wchar_t * delim = ( *ch == L'"' ) ? L"\"" : L" \t";
-	args = ( *ch == L'"' ) ? ++ch : ch;
-
-	std::wstring::size_type end = args.find_first_of( delim );
+    yuiError() << "No value for 'HREF=' in anchor '" << args << "'" << std::endl;
 
-	if ( end != std::wstring::npos )
-	    args.erase( end );
-
-	canchor.target = args;
-    }
-    else
-    {
-	yuiError() << "No value for 'HREF=' in anchor '" << args << "'" << std::endl;
-    }
-}
-
-
-void NCRichText::closeAnchor()
-{
-    canchor.close( cl, cc );
-
-    if ( canchor.valid() )
-	anchors.push_back( canchor );
-
-    canchor = Anchor();
+    return L"";
 }
 
 
 // expect "<[/]value>"
-bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
+bool NCRichText::ParseTOKEN( const wchar_t * sch, const wchar_t * ech, Element & element )
 {
     // "<[/]value>"
     if ( *sch++ != L'<' || *( ech - 1 ) != L'>' )
@@ -943,64 +956,515 @@ bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
 	yuiDebug() << "T_UNKNOWN :" << value << ":" << args << ":" << std::endl;
 	// see bug #67319
         //  return false;
-	return true;
     }
 
-    if ( token == T_IGNORE )
-	return true;
+    element.kind	 = Element::TAG;
+    element.token	 = token;
+    element.endtag	 = endtag;
+    element.leveltag	 = leveltag;
+    element.headinglevel = headinglevel;
+
+    if ( token == T_ANC && !endtag )
+	element.str = ParseAnchorTarget( args );
+
+    return true;
+}
+
+//
+// Layout tools
+//
+
+void NCRichText::Layout::move( unsigned line, unsigned col )
+{
+    ops.push_back( PadOp{ PadOp::MOVE, line, col, 0, std::wstring() } );
+
+    if ( state.lines < line + 1 )
+	state.lines = line + 1;
+}
+
+
+void NCRichText::Layout::addText( const wchar_t * sch, size_t len )
+{
+    if ( !len )
+	return;
+
+    if ( ops.size() > sealed && ops.back().kind == PadOp::TEXT )
+	ops.back().str.append( sch, len );
+    else
+	ops.push_back( PadOp{ PadOp::TEXT, 0, 0, 0, std::wstring( sch, len ) } );
+
+    if ( state.lines < state.cl + 1 )
+	state.lines = state.cl + 1;
+}
+
+
+void NCRichText::Layout::setAttr( unsigned attr )
+{
+    ops.push_back( PadOp{ PadOp::ATTR, 0, 0, attr, std::wstring() } );
+}
+
+
+void NCRichText::Layout::setWidth( unsigned width )
+{
+    ops.push_back( PadOp{ PadOp::WIDTH, 0, width, 0, std::wstring() } );
+}
+
+
+/**
+ * Return the layout of the text for the current pad width, parse and lay
+ * out the text if necessary.
+ **/
+NCRichText::Layout & NCRichText::layout()
+{
+    if ( !parsed )
+    {
+	reparse	    = 0;
+	reparseFrom = 0;
+	reparsePre  = false;
+	ParseHTML();
+    }
+
+    std::map<unsigned, Layout>::iterator it = layouts.find( textwidth );
+
+    if ( it != layouts.end() )
+	return it->second;
+
+    // switching back and forth between a few widths is common, more not
+    if ( layouts.size() >= 4 )
+	layouts.clear();
+
+    Layout & lay = layouts[ textwidth ];
+    LayoutState & st = lay.state;
+
+    st.textwidth = textwidth;
+    st.cl	 = 0;
+    st.cc	 = 0;
+    st.cindent	 = 0;
+    st.atbol	 = true;
+    st.Tattr	 = 0;
+    st.element	 = 0;
+    st.ops	 = 0;
+    st.anchors	 = 0;
+    st.lines	 = 0;
+    lay.sealed	 = 0;
+
+    LayoutHTML( lay );
+
+    return lay;
+}
+
+
+/**
+ * Return the text of a WORD or PRE_TEXT element and its length in 'len'.
+ **/
+inline const wchar_t * NCRichText::elementText( const Element & element, size_t & len ) const
+{
+    if ( element.filtered )
+    {
+	len = element.str.size();
+	return element.str.c_str();
+    }
+
+    len = element.length;
+    return text.str().c_str() + element.source;
+}
+
+
+void NCRichText::LayoutHTML( Layout & lay )
+{
+    LayoutState & st = lay.state;
+
+    for ( ; st.element < elements.size(); ++st.element )
+    {
+	if ( st.element == reparse )
+	    Checkpoint( lay );
+
+	const Element & element = elements[ st.element ];
+
+	switch ( element.kind )
+	{
+	    case Element::WORD:
+		{
+		    size_t len;
+		    const wchar_t * txt = elementText( element, len );
+		    PadTXT( lay, txt, len, element.width );
+		}
+		break;
+
+	    case Element::SPACE:
+		PadWS( lay );
+		break;
+
+	    case Element::TAG:
+		PadTOKEN( lay, element );
+		break;
+
+	    case Element::PRE_TEXT:
+		{
+		    size_t len;
+		    const wchar_t * txt = elementText( element, len );
+		    lay.addText( txt, len );
+		}
+		break;
+
+	    case Element::PRE_NL:
+		PadNL( lay );
+		break;
+	}
+    }
+
+    if ( st.element == reparse )
+	Checkpoint( lay );
+}
+
+
+/**
+ * Remember the layout state at element 'reparse' to continue from there
+ * when text is appended.
+ **/
+void NCRichText::Checkpoint( Layout & lay )
+{
+    lay.resume	       = lay.state;
+    lay.resume.ops     = lay.ops.size();
+    lay.resume.anchors = lay.anchors.size();
+    lay.sealed	       = lay.ops.size();
+}
+
+//
+// Drawing
+//
+
+void NCRichText::DrawHTMLPad()
+{
+    // yuiDebug() << "Start:" << std::endl;
+
+    const Layout & lay = layout();
+
+    anchors = lay.anchors;
+    armed = Anchor::unset;
+
+    AdjustPad( wsze( lay.state.lines, textwidth ) );
+    myPad()->move( 0, 0 );
+    drawnEnd = wpos( 0, 0 );
+    DrawOps( lay, 0 );
+
+    // no empty line at the end
+    drawnLines = lay.state.atbol ? lay.state.cl : lay.state.cl + 1;
+    AdjustPad( wsze( drawnLines, lay.state.textwidth ) );
+
+#if 0
+    yuiDebug() << "Anchors: " << anchors.size() << std::endl;
+
+    for ( unsigned i = 0; i < anchors.size(); ++i )
+    {
+	yuiDebug() << form( "  %2d: [%2d,%2d] -> [%2d,%2d]",
+			    i,
+			    anchors[i].sline, anchors[i].scol,
+			    anchors[i].eline, anchors[i].ecol ) << std::endl;
+    }
+#endif
+}
+
+
+/**
+ * Replay the ops of a layout on the pad, starting with op 'from'.
+ **/
+void NCRichText::DrawOps( const Layout & lay, size_t from )
+{
+    NCPad * pad = myPad();
+    unsigned lines = lay.state.lines;
+
+    for ( size_t i = from; i <= lay.ops.size(); ++i )
+    {
+	if ( i == lay.resume.ops )
+	{
+	    // appended text is drawn from here
+	    int l, c;
+	    pad->getyx( l, c );
+	    resumePos = wpos( l, c );
+	    resumeEnd = drawnEnd;
+	}
+
+	if ( i == lay.ops.size() )
+	    break;
+
+	const PadOp & op = lay.ops[i];
+
+	switch ( op.kind )
+	{
+	    case PadOp::MOVE:
+		pad->move( op.line, op.col );
+		break;
+
+	    case PadOp::ATTR:
+		pad->bkgdset( textStyle( op.attr ) );
+		break;
+
+	    case PadOp::TEXT:
+		{
+		    pad->addwstr( op.str.c_str() );
+		    int l, c;
+		    pad->getyx( l, c );
+		    drawnEnd = wpos( l, c );
+		}
+		break;
+
+	    case PadOp::WIDTH:
+		{
+		    chtype bg = pad->getbkgd();
+		    pad->bkgdset( wStyle().richtext.plain );
+		    AdjustPad( wsze( lines, op.col ) );
+		    pad->bkgdset( bg );
+		}
+		break;
+	}
+    }
+
+    resumeClean = ( resumeEnd.L < resumePos.L
+		    || ( resumeEnd.L == resumePos.L && resumeEnd.C <= resumePos.C ) );
+}
+
+
+/**
+ * Return the style for the font token bits 'attr' (e.g. color, font face...)
+ **/
+chtype NCRichText::textStyle( unsigned attr )
+{
+    const NCstyle::StRichtext & style( wStyle().richtext );
+    chtype nbg = style.plain;
+
+    if ( attr & T_ANC )
+    {
+	nbg = style.link;
+    }
+    else if ( attr & T_HEAD )
+    {
+	nbg = style.title;
+    }
+    else
+    {
+	switch ( attr & Tfontmask )
+	{
+	    case T_BOLD:
+		nbg = style.B;
+		break;
+
+	    case T_IT:
+		nbg = style.I;
+		break;
+
+	    case T_TT:
+		nbg = style.T;
+		break;
+
+	    case T_BOLD|T_IT:
+		nbg = style.BI;
+		break;
+
+	    case T_BOLD|T_TT:
+		nbg = style.BT;
+		break;
+
+	    case T_IT|T_TT:
+		nbg = style.IT;
+		break;
+
+	    case T_BOLD|T_IT|T_TT:
+		nbg = style.BIT;
+		break;
+	}
+    }
+
+    return nbg;
+}
+
+
+inline void NCRichText::PadNL( Layout & lay )
+{
+    LayoutState & st = lay.state;
+
+    st.cc = st.cindent;
+    ++st.cl;
+    lay.move( st.cl, st.cc );
+    st.atbol = true;
+}
+
+
+inline void NCRichText::PadBOL( Layout & lay )
+{
+    if ( !lay.state.atbol )
+	PadNL( lay );
+}
+
+
+inline void NCRichText::PadWS( Layout & lay )
+{
+    LayoutState & st = lay.state;
+
+    if ( st.atbol )
+	return; // no WS at beginning of line
+
+    if ( st.cc == st.textwidth )
+    {
+	PadNL( lay );
+    }
+    else
+    {
+	lay.addText( L" ", 1 );
+	++st.cc;
+    }
+}
+
+
+inline void NCRichText::PadTXT( Layout & lay, const wchar_t * txt, size_t len, size_t width )
+{
+    LayoutState & st = lay.state;
+
+    if ( !st.atbol && st.cc + width > st.textwidth )
+	PadNL( lay );
+
+    // insert the text
+    const wchar_t * start = txt;
+    const wchar_t * sch = start;
+
+    while ( sch != txt + len && *sch )
+    {
+	st.cc += wcwidth( *sch );
+	st.atbol = false;	// at begin of line = false
+	sch++;
+
+	if ( st.cc >= st.textwidth )
+	{
+	    lay.addText( start, sch - start );
+	    start = sch;
+	    PadNL( lay );	// add a new line
+	}
+    }
+
+    lay.addText( start, sch - start );
+}
+
+
+/**
+ * Set character attributes (e.g. color, font face...)
+ **/
+inline void NCRichText::PadSetAttr( Layout & lay )
+{
+    lay.setAttr( lay.state.Tattr );
+}
+
+
+void NCRichText::PadSetLevel( Layout & lay )
+{
+    LayoutState & st = lay.state;
+
+    st.cindent = listindent * st.liststack.size();
+
+    if ( st.cindent > st.textwidth / 2 )
+	st.cindent = st.textwidth / 2;
+
+    if ( st.atbol )
+    {
+	st.cc = st.cindent;
+	lay.move( st.cl, st.cc );
+    }
+}
+
+
+void NCRichText::PadChangeLevel( Layout & lay, bool down, int tag )
+{
+    if ( down )
+    {
+	if ( lay.state.liststack.size() )
+	    lay.state.liststack.pop();
+    }
+    else
+    {
+	lay.state.liststack.push( tag );
+    }
+
+    PadSetLevel( lay );
+}
+
+
+void NCRichText::openAnchor( Layout & lay, const std::wstring & target )
+{
+    lay.state.canchor.open( lay.state.cl, lay.state.cc );
+    lay.state.canchor.target = target;
+}
+
+
+void NCRichText::closeAnchor( Layout & lay )
+{
+    LayoutState & st = lay.state;
+
+    st.canchor.close( st.cl, st.cc );
+
+    if ( st.canchor.valid() )
+	lay.anchors.push_back( st.canchor );
+
+    st.canchor = Anchor();
+}
+
+
+void NCRichText::PadTOKEN( Layout & lay, const Element & element )
+{
+    LayoutState & st = lay.state;
+    TOKEN token = element.token;
+    bool endtag = element.endtag;
 
     switch ( token )
     {
 	case T_LEVEL:
-	    PadChangeLevel( endtag, leveltag );
-	    PadBOL();
+	    PadChangeLevel( lay, endtag, element.leveltag );
+	    PadBOL( lay );
 	    // add new line after end of the list
             // (only at the very end)
-	    if ( endtag && !cindent )
-		PadNL();
+	    if ( endtag && !st.cindent )
+		PadNL( lay );
 
 	    break;
 
 	case T_BR:
-	    PadNL();
+	    PadNL( lay );
 
 	    break;
 
 	case T_HEAD:
 	    if ( endtag )
-		Tattr &= ~token;
+		st.Tattr &= ~token;
 	    else
-		Tattr |= token;
+		st.Tattr |= token;
 
-	    PadSetAttr();
-	    PadBOL();
+	    PadSetAttr( lay );
+	    PadBOL( lay );
 
-	    if ( headinglevel && endtag )
-		PadNL();
+	    if ( element.headinglevel && endtag )
+		PadNL( lay );
 
 	    break;
 
 	case T_PAR:
-	    PadBOL();
+	    PadBOL( lay );
 
-	    if ( !cindent )
+	    if ( !st.cindent )
 	    {
 		if ( endtag )
 		    // add new line after closing tag (FaTE 3124)
-		    PadNL();
+		    PadNL( lay );
 	    }
 
 	    break;
 
 	case T_LI:
-	    PadSetLevel();
-	    PadBOL();
+	    PadSetLevel( lay );
+	    PadBOL( lay );
 
 	    if ( !endtag )
 	    {
 		std::wstring tag;
 
-		if ( liststack.empty() )
+		if ( st.liststack.empty() )
 		{
 		    tag = std::wstring( listindent, L' ' );
 		}
@@ -1008,26 +1472,26 @@ bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
 		{
 		    wchar_t buf[16];
 
-		    if ( liststack.top() )
+		    if ( st.liststack.top() )
 		    {
-			swprintf( buf, 15, L"%2ld. ", liststack.top()++ );
+			swprintf( buf, 15, L"%2ld. ", (long) st.liststack.top()++ );
 		    }
 		    else
 		    {
-			swprintf( buf, 15, L" %lc  ", listleveltags[liststack.size()%listleveltags.size()] );
+			swprintf( buf, 15, L" %lc  ", listleveltags[st.liststack.size()%listleveltags.size()] );
 		    }
 
 		    tag = buf;
 		}
 
 		// outsent list tag:
-		cc = ( tag.size() < cc ? cc - tag.size() : 0 );
+		st.cc = ( tag.size() < st.cc ? st.cc - tag.size() : 0 );
 
-		myPad()->move( cl, cc );
+		lay.move( st.cl, st.cc );
 
-		PadTXT( tag.c_str(), tag.size() );
+		PadTXT( lay, tag.c_str(), tag.size(), textWidth( tag ) );
 
-		atbol = true;
+		st.atbol = true;
 	    }
 
 	    break;
@@ -1036,13 +1500,16 @@ bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
 
 	    if ( !endtag )
 	    {
-		preTag = true;	// display text preserving newlines and spaces
-		AdjustPrePad( ech );
+		// widen the pad to the longest line
+		if ( element.width > st.textwidth )
+		{
+		    st.textwidth = element.width;
+		    lay.setWidth( st.textwidth );
+		}
 	    }
 	    else
 	    {
-		preTag = false;
-		PadNL();	 // add new line (text may continue after </pre>)
+		PadNL( lay );	 // add new line (text may continue after </pre>)
 	    }
 
 	    break;
@@ -1051,11 +1518,11 @@ bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
 
 	    if ( endtag )
 	    {
-		closeAnchor();
+		closeAnchor( lay );
 	    }
 	    else
 	    {
-		openAnchor( args );
+		openAnchor( lay, element.str );
 	    }
 
 	    // fall through
@@ -1064,11 +1531,11 @@ bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
 	case T_IT:
 	case T_TT:
 	    if ( endtag )
-		Tattr &= ~token;
+		st.Tattr &= ~token;
 	    else
-		Tattr |= token;
+		st.Tattr |= token;
 
-	    PadSetAttr();
+	    PadSetAttr( lay );
 
 	    break;
 
@@ -1076,8 +1543,6 @@ bool NCRichText::PadTOKEN( const wchar_t * sch, const wchar_t *& ech )
 	case T_UNKNOWN:
 	    break;
     }
-
-    return true;
 }
 
 
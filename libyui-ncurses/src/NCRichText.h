@@ -26,10 +26,12 @@
 #define NCRichText_h
 
 #include <iosfwd>
+#include <map>
 #include <stack>
 
 #include <yui/YRichText.h>
 #include "NCPadWidget.h"
+#include "NCtext.h"
 
 
 class NCRichText : public YRichText, public NCPadWidget
@@ -66,15 +68,9 @@ private:
 
     bool plainText;
 
-    unsigned textwidth;
-    unsigned cl;
-    unsigned cc;
-    unsigned cindent;
-    bool     atbol;
+    NCtext plainLines;		///< 'text' split into lines in plain text mode
 
-    bool     preTag;		// <pre> tag
-
-    unsigned Tattr;
+    unsigned textwidth;		///< the width the text is laid out for
 
     static const unsigned Tfontmask = 0xff00;
     enum TOKEN
@@ -99,11 +95,8 @@ private:
     static const unsigned listindent;
     static const std::wstring   listleveltags;
 
-    std::stack<int> liststack;
-
-    void PadChangeLevel( bool down, int tag );
-    void PadSetLevel();
-    size_t textWidth( std::wstring wstr );
+    size_t textWidth( const wchar_t * wstr, size_t len );
+    size_t textWidth( const std::wstring & wstr ) { return textWidth( wstr.data(), wstr.size() ); }
 
 private:
 
@@ -168,33 +161,143 @@ private:
 
     static const bool showLinkTarget;
 
-    Anchor		canchor;
     std::vector<Anchor>	anchors;
     unsigned		armed;
 
     unsigned vScrollFirstvisible;
     unsigned vScrollNextinvisible;
 
-    void openAnchor( std::wstring args );
-    void closeAnchor();
-
     void arm( unsigned i );
     void disarm() { arm( Anchor::unset ); }
 
 private:
 
-    void PadSetAttr();
+    /**
+     * One element of the parsed HTML text: A word, white space, a tag, or
+     * text or a newline inside <pre>. The elements don't depend on the
+     * width, so the text is parsed only once.
+     **/
+    struct Element
+    {
+	enum Kind { WORD, SPACE, TAG, PRE_TEXT, PRE_NL };
+
+	Kind	     kind;
+	TOKEN	     token;		///< TAG: the token
+	bool	     endtag;		///< TAG: closing tag
+	bool	     pre;		///< inside <pre> at the start of the element
+	int	     leveltag;		///< TAG T_LEVEL: 1 for <ol>, 0 for <ul>
+	int	     headinglevel;	///< TAG T_HEAD: 1 for <h1> etc.
+	size_t	     source;		///< start in 'text'
+	size_t	     length;		///< WORD, PRE_TEXT: length in 'text'
+	size_t	     width;		///< WORD: text width, TAG T_PLAIN: longest line
+	size_t	     lines;		///< TAG T_PLAIN: number of lines
+	bool	     filtered;		///< WORD, PRE_TEXT: 'str' holds the text
+	std::wstring str;		///< WORD, PRE_TEXT: text with entities replaced,
+					///< TAG T_ANC: link target
+    };
+
+    std::vector<Element> elements;	///< the parsed text (not in plain text mode)
+    bool   parsed;			///< 'elements' are up to date
+
+    // Where to continue parsing when text is appended: The first element
+    // that might change, its start in 'text' and whether it is in <pre>
+
+    size_t reparse;
+    size_t reparseFrom;
+    bool   reparsePre;
+
+    void ParseHTML();
+    const wchar_t * elementText( const Element & element, size_t & len ) const;
+    bool ParseTOKEN( const wchar_t * sch, const wchar_t * ech, Element & element );
+    bool ParsePreText( size_t from, Element & element );
+    std::wstring ParseAnchorTarget( std::wstring args );
+
+    /**
+     * Operation on the pad, recorded when laying out the elements and
+     * replayed when drawing the pad.
+     **/
+    struct PadOp
+    {
+	enum Kind { MOVE, ATTR, TEXT, WIDTH };
+
+	Kind	     kind;
+	unsigned     line;		///< MOVE
+	unsigned     col;		///< MOVE, WIDTH: the new pad width
+	unsigned     attr;		///< ATTR: the font token bits
+	std::wstring str;		///< TEXT
+    };
+
+    struct LayoutState
+    {
+	unsigned textwidth;
+	unsigned cl;
+	unsigned cc;
+	unsigned cindent;
+	bool     atbol;
+	unsigned Tattr;
+
+	std::stack<int> liststack;
+	Anchor		canchor;
+
+	size_t	 element;		///< the next element to lay out
+	size_t	 ops;			///< number of ops so far
+	size_t	 anchors;		///< number of anchors so far
+	unsigned lines;			///< number of pad lines used so far
+    };
+
+    /**
+     * The elements laid out for one pad width.
+     **/
+    struct Layout
+    {
+	std::vector<PadOp>  ops;
+	std::vector<Anchor> anchors;
+	LayoutState	    state;	///< at the end of the elements
+	LayoutState	    resume;	///< at element 'reparse', to lay out appended text
+	size_t		    sealed;	///< ops before that must not be extended
+
+	void move( unsigned line, unsigned col );
+	void addText( const wchar_t * sch, size_t len );
+	void setAttr( unsigned attr );
+	void setWidth( unsigned width );
+    };
+
+    std::map<unsigned, Layout> layouts;	///< by pad width
+
+    Layout & layout();
+    void LayoutHTML( Layout & lay );
+    void Checkpoint( Layout & lay );
 
-    void DrawPlainPad();
+    // Where the pad of the current layout can be continued after text is
+    // appended: The cursor before the ops of the 'resume' state, the
+    // position after the last text written before and whether nothing was
+    // written after the cursor yet
+
+    wpos     resumePos;
+    wpos     resumeEnd;
+    bool     resumeClean;
+    wpos     drawnEnd;
+    unsigned drawnLines;
+
+    chtype textStyle( unsigned attr );
+    void DrawOps( const Layout & lay, size_t from );
+
+private:
+
+    void DrawPlainPad( unsigned firstLine );
     void DrawHTMLPad();
 
-    void PadNL();
-    void PadBOL();
-    void PadWS( bool tab = false );
-    void PadTXT( const wchar_t * sch, const unsigned len );
-    void PadPreTXT( const wchar_t * sch, const unsigned len );
-    void AdjustPrePad( const wchar_t * sch );
-    bool PadTOKEN( const wchar_t * sch, const wchar_t *& ech );
+    void PadNL( Layout & lay );
+    void PadBOL( Layout & lay );
+    void PadWS( Layout & lay );
+    void PadTXT( Layout & lay, const wchar_t * txt, size_t len, size_t width );
+    void PadSetAttr( Layout & lay );
+    void PadSetLevel( Layout & lay );
+    void PadChangeLevel( Layout & lay, bool down, int tag );
+    void PadTOKEN( Layout & lay, const Element & element );
+
+    void openAnchor( Layout & lay, const std::wstring & target );
+    void closeAnchor( Layout & lay );
 
 protected:
 
@@ -228,6 +331,13 @@ public:
 
     virtual void setValue( const std::string & ntext ) override;
 
+    /**
+     * Append text to the text content. Only the new text is parsed and laid
+     * out, and only the new lines are drawn (unless the new text changes
+     * the layout of the old text, e.g. continues its last word).
+     **/
+    virtual void appendText( const std::string & ntext ) override;
+
     virtual void setEnabled( bool do_bv );
 
     virtual bool setKeyboardFocus()
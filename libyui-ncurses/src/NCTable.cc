@@ -166,6 +166,9 @@ void NCTable::cellChanged( const YTableCell * changedCell )
 
     if ( tableCol )
     {
+        // Let the pad recalculate the column widths for this line
+        myPad()->ModifyLine( tableLine->index() );
+
         tableCol->SetLabel( changedCell->label() );
         DrawPad();
     }
@@ -210,7 +213,15 @@ NCTable::getHeader() const
 void NCTable::addItems( const YItemCollection & itemCollection )
 {
     myPad()->ClearTable();
-    YTable::addItems( itemCollection );
+
+    // Only notify the YTable base class here, not our own addItem(): The pad
+    // lines for all items are built only once below.
+
+    for ( YItemConstIterator it = itemCollection.begin(); it != itemCollection.end(); ++it )
+    {
+        if ( ! (*it)->parent() )
+            YTable::addItem( *it );
+    }
 
     if ( keepSorting() )
     {
@@ -275,6 +286,7 @@ void NCTable::addPadLine( NCTableLine *      parentLine,
         _nestedItems = true;
 
     vector<NCTableCol*> cells;
+    cells.reserve( item->cellCount() + ( _multiSelect ? 1 : 0 ) );
 
     if ( _multiSelect )
     {
@@ -706,8 +718,6 @@ void NCTable::interactiveSort()
 
 void NCTable::sortItems( int sortCol, bool reverse )
 {
-    myPad()->ClearTable();
-
     // Sort the YItems.
     //
     // This may feel a little weird since those YItems are owned by the
@@ -721,9 +731,9 @@ void NCTable::sortItems( int sortCol, bool reverse )
     // out.  But we need the hierarchy to sort each tree level separately in
     // each branch.
     //
-    // It is much simpler and less error-prone to just clear the pad (and thus
-    // get rid of any existing NCTableLines), sort the YItems and rebuild all
-    // the NCTableLines from the newly sorted YItems.
+    // So the YItems are sorted, and then the existing NCTableLines are put in
+    // the same order. They keep their cells, their column widths and their
+    // state; only the tree links and the indexes change.
 
     _sortStrategy->setSortCol( sortCol );
     _sortStrategy->setReverse( reverse );
@@ -731,7 +741,69 @@ void NCTable::sortItems( int sortCol, bool reverse )
 
     sortYItems( itemsBegin(), itemsEnd() );
 
-    rebuildPadLines();
+    std::vector<NCTableLine *> lines;
+    lines.reserve( myPad()->Lines() );
+
+    if ( myPad()->empty()
+         || ! reorderPadLines( 0, itemsBegin(), itemsEnd(), lines )
+         || lines.size() != myPad()->Lines() )
+    {
+        // No lines yet (e.g. from addItems()) or not for all items
+        rebuildPadLines();
+        return;
+    }
+
+    myPad()->ReorderLines( lines );
+
+    for ( NCTableLine * line : lines )
+    {
+        // The tree line graphics depend on the new siblings
+        if ( line->isNested() )
+            line->updatePrefix();
+
+        // Like addPadLine(): Move the cursor to the (last) selected item
+        if ( line->origItem() && line->origItem()->selected() )
+            setCurrentItem( line->index() );
+    }
+}
+
+
+bool NCTable::reorderPadLines( NCTableLine *                parentLine,
+                               YItemIterator                begin,
+                               YItemIterator                end,
+                               std::vector<NCTableLine *> & lines )
+{
+    NCTableLine * previous = 0;
+
+    if ( parentLine )
+        parentLine->setFirstChild( 0 );
+
+    for ( YItemIterator it = begin; it != end; ++it )
+    {
+        NCTableLine * line = (NCTableLine *) ( *it )->data();
+
+        if ( ! line )
+            return false;
+
+        // Only child lines are linked to their siblings (see NCTableLine::treeInit())
+
+        if ( previous )
+            previous->setNextSibling( line );
+        else if ( parentLine )
+            parentLine->setFirstChild( line );
+
+        line->setNextSibling( 0 );
+        previous = parentLine ? line : 0;
+
+        line->setIndex( lines.size() );
+        ( *it )->setIndex( lines.size() );
+        lines.push_back( line );
+
+        if ( ! reorderPadLines( line, ( *it )->childrenBegin(), ( *it )->childrenEnd(), lines ) )
+            return false;
+    }
+
+    return true;
 }
 
 
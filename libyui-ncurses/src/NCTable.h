@@ -419,8 +419,9 @@ protected:
     /**
      * Sort the items by column no. 'sortCol' with the current sort strategy.
      *
-     * This sorts the YItems and recreates all NCTableLines.
-     * All YItem pointers remain valid, but the NCTableLines do not.
+     * This sorts the YItems and puts the NCTableLines in the same order (or
+     * creates them if there are none yet). All YItem and NCTableLine pointers
+     * remain valid, but the indexes change.
      **/
     void sortItems( int sortCol, bool reverse = false );
 
@@ -431,6 +432,18 @@ protected:
     void sortYItems( YItemIterator begin,
                      YItemIterator end   );
 
+    /**
+     * Put the existing NCTableLines in the order of the (sorted) YItems:
+     * Collect them depth-first in 'lines', link them to their new siblings
+     * and renumber them and their YItems.
+     *
+     * Return 'false' if an item doesn't have a line.
+     **/
+    bool reorderPadLines( NCTableLine *                parentLine,
+                          YItemIterator                begin,
+                          YItemIterator                end,
+                          std::vector<NCTableLine *> & lines );
+
 private:
 
     // Disable unwanted assignment opearator and copy constructor
@@ -308,7 +308,7 @@ void NCTableLine::UpdateFormat( NCTableStyle & tableStyle )
 	if ( !_cells[ col ] )
 	    continue;
 
-	tableStyle.MinColWidth( col, _cells[ col ]->Size().W );
+	tableStyle.AddColWidth( col, _cells[ col ]->Size().W );
     }
 
     if ( _nested && ! _prefix )
@@ -316,6 +316,18 @@ void NCTableLine::UpdateFormat( NCTableStyle & tableStyle )
 }
 
 
+void NCTableLine::RemoveFormat( NCTableStyle & tableStyle )
+{
+    for ( unsigned col = 0; col < Cols(); ++col )
+    {
+	if ( !_cells[ col ] )
+	    continue;
+
+	tableStyle.RemoveColWidth( col, _cells[ col ]->Size().W );
+    }
+}
+
+
 void NCTableLine::DrawAt( NCursesWindow & w,
                           const wrect     at,
 			  NCTableStyle &  tableStyle,
@@ -727,6 +739,7 @@ bool NCTableStyle::SetStyleFrom( const std::vector<NCstring> & head )
 
     _colWidth.clear();
     _colAdjust.clear();
+    _widthCount.clear();
     AssertMinCols( ncols );
 
     bool hasContent = false;
@@ -772,6 +785,31 @@ bool NCTableStyle::SetStyleFrom( const std::vector<NCstring> & head )
 }
 
 
+void NCTableStyle::RemoveColWidth( unsigned num, unsigned val )
+{
+    if ( num >= _widthCount.size() )
+	return;
+
+    std::map<unsigned, unsigned> & count = _widthCount[ num ];
+    std::map<unsigned, unsigned>::iterator it = count.find( val );
+
+    if ( it == count.end() )
+    {
+	// The cell was changed without the pad knowing
+	yuiDebug() << "Width " << val << " not counted in column " << num << std::endl;
+	return;
+    }
+
+    if ( --it->second == 0 )
+    {
+	count.erase( it );
+
+	if ( val == _colWidth[ num ] )
+	    _colWidth[ num ] = count.empty() ? 0 : count.rbegin()->first;
+    }
+}
+
+
 chtype NCTableStyle::highlightBG( const NCTableLine::STATE lstate,
 				  const NCTableCol::STYLE  cstyle,
 				  const NCTableCol::STYLE  dstyle ) const
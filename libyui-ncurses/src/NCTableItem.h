@@ -28,6 +28,7 @@
 #define NCTableItem_h
 
 #include <iosfwd>
+#include <map>
 #include <vector>
 
 #include "position.h"
@@ -136,6 +137,11 @@ public:
      **/
     int index() const { return _index; }
 
+    /**
+     * Set the unique index, e.g. after the lines were sorted.
+     **/
+    void setIndex( int index ) { _index = index; }
+
     /**
      * Return the number of columns (cells) in this line.
      **/
@@ -254,6 +260,12 @@ public:
      **/
     virtual void UpdateFormat( NCTableStyle & tableStyle );
 
+    /**
+     * Remove this line from the column widths of TableStyle again,
+     * e.g. before it is changed. This undoes UpdateFormat().
+     **/
+    virtual void RemoveFormat( NCTableStyle & tableStyle );
+
     /**
      * Create the real tree hierarchy line graphics prefix and store it in
      * _prefix
@@ -552,6 +564,7 @@ public:
     void ResetToMinCols()
     {
 	_colWidth.clear();
+	_widthCount.clear();
 	AssertMinCols( _headline.Cols() );
 	_headline.UpdateFormat( *this );
     }
@@ -563,9 +576,25 @@ public:
 	{
 	    _colWidth.resize( num, 0 );
 	    _colAdjust.resize( _colWidth.size(), NC::LEFT );
+	    _widthCount.resize( _colWidth.size() );
 	}
     }
 
+    /// Count a cell of width *val* in column *num*, widening the column
+    /// if needed.
+    void AddColWidth( unsigned num, unsigned val )
+    {
+	AssertMinCols( num + 1 );
+	++_widthCount[ num ][ val ];
+
+	if ( val > _colWidth[num] )
+	    _colWidth[ num ] = val;
+    }
+
+    /// Stop counting a cell added with AddColWidth(). The column
+    /// shrinks if that was the widest one.
+    void RemoveColWidth( unsigned num, unsigned val );
+
     /// Update colWidth[num] to be at least *val*.
     /// @param num column number (may be bigger than previously)
     /// @param val width of that column for some line
@@ -630,6 +659,10 @@ private:
     std::vector<unsigned>	_colWidth;  ///< column widths
     std::vector<NC::ADJUST>	_colAdjust; ///< column alignment
 
+    /// For each column: how many cells (of the headline and the lines
+    /// counted with AddColWidth) have which width
+    std::vector< std::map<unsigned, unsigned> > _widthCount;
+
 
     /// total width of space between adjacent columns, including the separator character
     unsigned _colSepWidth;
@@ -64,20 +64,6 @@ int NCTablePad::DoRedraw()
 }
 
 
-void NCTablePad::directDraw( NCursesWindow & w, const wrect at, unsigned lineNo )
-{
-    if ( lineNo < Lines() )
-    {
-        _visibleItems[ lineNo ]->DrawAt( w,
-                                         at,
-                                         _itemStyle,
-                                         ( (unsigned) currentLineNo() == lineNo) );
-    }
-    else
-        yuiWarning() << "Illegal Line no " << lineNo << " (" << Lines() << ")" << std::endl;
-}
-
-
 bool NCTablePad::handleInput( wint_t key )
 {
     bool handled = false;
@@ -148,20 +134,10 @@ void NCTablePad::stripHotkeys()
 }
 
 
-typedef std::vector<NCTableLine *>::const_iterator NCTableLineIterator;
-
 int NCTablePad::findIndexById( int id ) const
 {
-    NCTableLineIterator begin = _items.begin();
-    NCTableLineIterator end   = _items.end();
-    NCTableLineIterator found = find_if( begin, end,
-                                         [id](NCTableLine * line)
-                                             {
-                                                 return line->index() == id;
-                                             });
-
-    if ( found == end )
+    if ( id < 0 )
 	return -1;
-    else
-	return found - begin;
+
+    return findIndex( id );
 }
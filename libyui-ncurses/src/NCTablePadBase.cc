@@ -23,12 +23,18 @@
 
 /-*/
 
+#include <algorithm>
+
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
 #include "NCTablePadBase.h"
 
 using std::vector;
 
+// Maximum number of lines changed with ModifyLine() that are counted again
+// one by one in UpdateFormat(). If more lines change, all lines are counted.
+#define MAX_MODIFIED_LINES 64
+
 
 NCTablePadBase::NCTablePadBase( int lines, int cols, const NCWidget & p )
     : NCPad( lines, cols, p )
@@ -36,9 +42,14 @@ NCTablePadBase::NCTablePadBase( int lines, int cols, const NCWidget & p )
     , _headpad( 1, 1 )
     , _dirtyHead( false )
     , _dirtyFormat( false )
+    , _dirtyWidths( false )
+    , _dirtyVisible( false )
     , _itemStyle( p )
     , _citem( 0 )
+    , _dirtyIndex( false )
 {
+    // Draw only the lines in the viewport, no matter how many there are
+    setAlwaysPaging( true );
 }
 
 
@@ -55,28 +66,22 @@ void NCTablePadBase::ClearTable()
 
     _items.clear();
     _visibleItems.clear();
+    _posByIndex.clear();
+    _dirtyIndex = false;
     setFormatDirty();
 }
 
 
 NCTableLine * NCTablePadBase::getLineWithIndex( unsigned idx ) const
 {
-    NCTableLine * line = 0;
-
-    if ( idx < Lines() )
-	line = _items[ idx ];
-
-    if ( (unsigned) line->index() == idx )
-        return line;
+    // Usually the lines are in index order
+    if ( idx < Lines() && (unsigned) _items[ idx ]->index() == idx )
+        return _items[ idx ];
 
     int pos = findIndex( idx );
 
     if ( pos >= 0 )
-    {
-        yuiWarning() << "Found item with index " << idx << " at pos " << pos << endl;
-
         return _items[ pos ];
-    }
 
     yuiError() << "Can't find item with index " << idx << endl;
 
@@ -92,23 +97,70 @@ const NCTableLine * NCTablePadBase::GetLine( unsigned idx ) const
 
 NCTableLine * NCTablePadBase::ModifyLine( unsigned idx )
 {
-    setFormatDirty();
-    return getLineWithIndex( idx );
+    NCTableLine * line = getLineWithIndex( idx );
+
+    if ( line )
+        lineModified( line );
+
+    return line;
 }
 
 
-int NCTablePadBase::findIndex( unsigned idx ) const
+void NCTablePadBase::lineModified( NCTableLine * line )
 {
-    for ( unsigned i=0; i < Lines(); i++ )
+    dirty = _dirtyFormat = true;
+
+    if ( _dirtyWidths )
+        return;         // all lines are counted anyway
+
+    if ( find( _modifiedLines.begin(), _modifiedLines.end(), line ) != _modifiedLines.end() )
+        return;         // already taken out
+
+    if ( _modifiedLines.size() >= MAX_MODIFIED_LINES )
     {
-        if ( (unsigned) _items[ i ]->index() == idx )
-            return i;
+        setFormatDirty();
+        return;
     }
 
+    line->RemoveFormat( _itemStyle );
+    _modifiedLines.push_back( line );
+}
+
+
+int NCTablePadBase::findIndex( unsigned idx ) const
+{
+    if ( _dirtyIndex )
+        rebuildIndex();
+
+    if ( idx < _posByIndex.size() )
+        return _posByIndex[ idx ];
+
     return -1;
 }
 
 
+void NCTablePadBase::rebuildIndex() const
+{
+    _posByIndex.clear();
+
+    for ( unsigned i = 0; i < Lines(); ++i )
+    {
+        int idx = _items[ i ]->index();
+
+        if ( idx < 0 )
+            continue;
+
+        if ( (unsigned) idx >= _posByIndex.size() )
+            _posByIndex.resize( idx + 1, -1 );
+
+        if ( _posByIndex[ idx ] < 0 ) // the first one wins
+            _posByIndex[ idx ] = i;
+    }
+
+    _dirtyIndex = false;
+}
+
+
 void NCTablePadBase::SetLines( unsigned idx )
 {
     if ( idx == Lines() )
@@ -132,6 +184,7 @@ void NCTablePadBase::SetLines( unsigned idx )
 	    _items[i] = new NCTableLine( 0 );
     }
 
+    _dirtyIndex = true;
     setFormatDirty();
 }
 
@@ -147,17 +200,67 @@ void NCTablePadBase::SetLines( std::vector<NCTableLine*> & newItems )
 	    _items[i] = new NCTableLine( 0 );
     }
 
+    _dirtyIndex = true;
     setFormatDirty();
 }
 
 
+void NCTablePadBase::ReorderLines( std::vector<NCTableLine*> & newItems )
+{
+    if ( newItems.size() != _items.size() )
+    {
+	yuiError() << "Expected " << _items.size() << " lines, got " << newItems.size() << endl;
+	return;
+    }
+
+    _items.swap( newItems );
+
+    _dirtyIndex = true;
+    setVisibleItemsDirty();
+}
+
+
 void NCTablePadBase::AddLine( unsigned idx, NCTableLine * item )
 {
-    assertLine( idx );
-    delete _items[idx];
-    _items[idx] = item ? item : new NCTableLine( 0 );
+    if ( !item )
+	item = new NCTableLine( 0 );
 
-    setFormatDirty();
+    if ( idx != Lines() || item->isNested() )
+    {
+	// Replacing a line or adding a tree branch (with line graphics
+	// depending on the siblings): Recalculate everything
+
+	assertLine( idx );
+	delete _items[idx];
+	_items[idx] = item;
+
+	_dirtyIndex = true;
+	setFormatDirty();
+
+	return;
+    }
+
+    // Appending a line: Just add it to the format
+
+    _items.push_back( item );
+    dirty = _dirtyFormat = true;
+
+    if ( ! _dirtyWidths )
+	item->UpdateFormat( _itemStyle );
+
+    if ( ! _dirtyVisible && item->isVisible() )
+	_visibleItems.push_back( item );
+
+    int index = item->index();
+
+    if ( ! _dirtyIndex && index >= 0 )
+    {
+	if ( (unsigned) index >= _posByIndex.size() )
+	    _posByIndex.resize( index + 1, -1 );
+
+	if ( _posByIndex[ index ] < 0 )
+	    _posByIndex[ index ] = idx;
+    }
 }
 
 
@@ -204,13 +307,28 @@ wsze NCTablePadBase::tableSize()
 wsze NCTablePadBase::UpdateFormat()
 {
     dirty = true;
-    _itemStyle.ResetToMinCols();
 
-    for ( unsigned i = 0; i < Lines(); ++i )
-	_items[i]->UpdateFormat( _itemStyle );
+    if ( _dirtyWidths )
+    {
+	_itemStyle.ResetToMinCols();
+
+	for ( unsigned i = 0; i < Lines(); ++i )
+	    _items[i]->UpdateFormat( _itemStyle );
 
+	_dirtyWidths = false;
+    }
+    else
+    {
+	// Just count the lines changed since the last update again
+	for ( unsigned i = 0; i < _modifiedLines.size(); ++i )
+	    _modifiedLines[i]->UpdateFormat( _itemStyle );
+    }
+
+    _modifiedLines.clear();
     _dirtyFormat = false;
-    updateVisibleItems();
+
+    if ( _dirtyVisible )
+	updateVisibleItems();
 
     maxspos.L = visibleLines() > (unsigned) srect.Sze.H ? visibleLines() - srect.Sze.H : 0;
 
@@ -233,6 +351,8 @@ void NCTablePadBase::updateVisibleItems()
 	if ( _items[ i ]->isVisible() )
 	    _visibleItems.push_back( _items[ i ] );
     }
+
+    _dirtyVisible = false;
 }
 
 
@@ -249,7 +369,12 @@ int NCTablePadBase::DoRedraw()
     }
 
     prepareRedraw();
-    drawContentLines();
+
+    if ( ! paging() )
+        drawContentLines();
+    // else
+    //   item drawing requested via directDraw()
+
     drawHeader();
 
     dirty = false;
@@ -282,6 +407,24 @@ void NCTablePadBase::drawContentLines()
 }
 
 
+void NCTablePadBase::directDraw( NCursesWindow & w, const wrect at, unsigned lineNo )
+{
+    if ( lineNo < visibleLines() )
+    {
+        _visibleItems[ lineNo ]->DrawAt( w,
+                                         at,
+                                         _itemStyle,
+                                         ( (unsigned) currentLineNo() == lineNo ) );
+    }
+    else // below the last line
+    {
+        w.bkgdset( _itemStyle.getBG() );
+        w.move( at.Pos.L, at.Pos.C );
+        w.clrtoeol();
+    }
+}
+
+
 void NCTablePadBase::drawHeader()
 {
     wsze lineSize( 1, width() );
@@ -432,6 +575,8 @@ bool NCTablePadBase::currentItemHandleInput( wint_t key )
 
         if ( handled )
         {
+            // A branch might have been opened or closed
+            setVisibleItemsDirty();
             UpdateFormat();
             setpos( wpos( currentLineNo(), srect.Pos.C ) );
         }
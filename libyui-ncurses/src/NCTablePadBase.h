@@ -132,6 +132,12 @@ public:
 
     void SetLines( std::vector<NCTableLine*> & newItems );
 
+    /**
+     * Replace the lines with the same lines in a different order, e.g. after
+     * sorting. Unlike SetLines(), this keeps the lines and the column widths.
+     **/
+    void ReorderLines( std::vector<NCTableLine*> & newItems );
+
     /**
      * Add *item* at position *idx*, expanding if needed
      * @param item we take ownership
@@ -159,6 +165,9 @@ public:
 
     /**
      * Return line at *idx* for read-write operations and mark it as modified.
+     *
+     * Only this line's column widths are recalculated on the next format
+     * update, so any changes to its cells must be done before that.
      **/
     NCTableLine * ModifyLine( unsigned idx );
 
@@ -199,6 +208,17 @@ private:
      **/
     NCTableLine * getLineWithIndex( unsigned idx ) const;
 
+    /**
+     * Rebuild _posByIndex from the current items.
+     **/
+    void rebuildIndex() const;
+
+    /**
+     * Take the column widths of 'line' out of the table format because it
+     * is about to be changed. The next UpdateFormat() adds them again.
+     **/
+    void lineModified( NCTableLine * line );
+
 
 protected:
 
@@ -219,7 +239,21 @@ protected:
      **/
     void updateVisibleItems();
 
-    void setFormatDirty() { dirty = _dirtyFormat = true; }
+    /**
+     * Mark the whole format as dirty: The column widths are recalculated
+     * from all lines, and the visible lines are collected again.
+     **/
+    void setFormatDirty()
+    {
+	dirty = _dirtyFormat = _dirtyWidths = _dirtyVisible = true;
+	_modifiedLines.clear();
+    }
+
+    /**
+     * Mark the visible lines as dirty, e.g. after a branch was opened or
+     * closed. This does not recalculate the column widths.
+     **/
+    void setVisibleItemsDirty() { dirty = _dirtyFormat = _dirtyVisible = true; }
 
     virtual int dirtyPad() { return setpos( CurPos() ); }
 
@@ -238,9 +272,19 @@ protected:
 
     /**
      * Redraw the (visible) content lines one by one.
+     *
+     * This is only needed when not paging; a paging pad draws just the
+     * lines in the viewport with directDraw().
      **/
     virtual void drawContentLines();
 
+    /**
+     * Draw the visible line 'lineNo' at 'at' in the paging pad 'w'.
+     *
+     * Reimplemented from NCPad.
+     **/
+    virtual void directDraw( NCursesWindow & w, const wrect at, unsigned lineNo );
+
     /**
      * Redraw the table header.
      **/
@@ -291,8 +335,14 @@ protected:
     NCursesPad	              _headpad;
     bool	              _dirtyHead;
     bool	              _dirtyFormat;  ///< does table format (size) need recalculating?
+    bool	              _dirtyWidths;  ///< do the column widths need recounting from all lines?
+    bool	              _dirtyVisible; ///< does _visibleItems need rebuilding?
+    std::vector<NCTableLine*> _modifiedLines; ///< lines to count again in UpdateFormat() (not owned)
     NCTableStyle	      _itemStyle;
     wpos		      _citem;        ///< current/cursor position
+
+    mutable std::vector<int>  _posByIndex;   ///< position in _items for each line index, or -1
+    mutable bool	      _dirtyIndex;   ///< does _posByIndex need rebuilding?
 };
 
 
@@ -14,6 +14,10 @@
 */
 
 
+#include <errno.h>
+#include <cwchar>
+#include <algorithm>
+
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
 #include <yui/YTableItem.h>
@@ -32,65 +36,93 @@ NCTableSortDefault::sort( YItemIterator begin, YItemIterator end )
     // yuiMilestone() << "Sorting by col #" << sortCol()
     //                << " reverse: " << std::boolalpha << reverse() << endl;
 
-    std::stable_sort( begin, end,
-                      Compare( sortCol(), reverse() ) );
+    std::vector<SortKey> keys;
+    keys.reserve( end - begin );
+
+    for ( YItemIterator it = begin; it != end; ++it )
+        keys.push_back( sortKey( *it ) );
+
+    std::stable_sort( keys.begin(), keys.end(), Compare( reverse() ) );
+
+    for ( const SortKey & key : keys )
+        *begin++ = key.item;
 }
 
 
 bool
-NCTableSortDefault::Compare::operator() ( YItem * item1,
-					  YItem * item2 ) const
+NCTableSortDefault::Compare::operator() ( const SortKey & key1,
+					  const SortKey & key2 ) const
 {
-    std::wstring w1 = smartSortKey( item1 );
-    std::wstring w2 = smartSortKey( item2 );
-
-    bool ok1, ok2;
-    long long number1 = toNumber( w1, &ok1 );
-    long long number2 = toNumber( w2, &ok2 );
-
-    if ( ok1 && ok2 )
+    if ( key1.isNumber && key2.isNumber )
     {
 	// Both are numbers
-	return !_reverse ? number1 < number2 : number1 > number2;
+	return !_reverse ? key1.number < key2.number : key1.number > key2.number;
     }
-    else if ( ok1 && !ok2 )
+    else if ( key1.isNumber && !key2.isNumber )
     {
 	// int < string
 	return true;
     }
-    else if ( !ok1 && ok2 )
+    else if ( !key1.isNumber && key2.isNumber )
     {
 	// string > int
 	return false;
     }
     else
     {
-	// compare strings using collating information
-	int result = std::wcscoll( w1.c_str(), w2.c_str() );
+	// comparing the collation keys is the same as comparing the strings
+	// with wcscoll()
+	int result = key1.collationKey.compare( key2.collationKey );
 
 	return !_reverse ? result < 0 : result > 0;
     }
 }
 
 
-long long
-NCTableSortDefault::Compare::toNumber( const std::wstring & str, bool * ok ) const
+NCTableSortDefault::SortKey
+NCTableSortDefault::sortKey( YItem * item ) const
 {
-    try
-    {
-	*ok = true;
-	return std::stoll( str );
-    }
-    catch (...)
+    SortKey key;
+    key.item = item;
+
+    std::wstring str = smartSortKey( item );
+    key.number = toNumber( str, &key.isNumber );
+
+    if ( ! key.isNumber )
     {
-	*ok = false;
-	return 0;
+        // wcsxfrm() stops at a NUL like wcscoll()
+        const wchar_t * cstr = str.c_str();
+        size_t len = std::wcsxfrm( 0, cstr, 0 );
+
+        key.collationKey.resize( len + 1 );
+        std::wcsxfrm( &key.collationKey[0], cstr, len + 1 );
+        key.collationKey.resize( len );
     }
+
+    return key;
+}
+
+
+long long
+NCTableSortDefault::toNumber( const std::wstring & str, bool * ok ) const
+{
+    // Like std::stoll(), but without throwing an exception for each string
+    // that is not a number
+
+    const wchar_t * start = str.c_str();
+    wchar_t * end = 0;
+
+    errno = 0;
+    long long number = std::wcstoll( start, &end, 10 );
+
+    *ok = end != start && errno != ERANGE;
+
+    return *ok ? number : 0;
 }
 
 
 std::wstring
-NCTableSortDefault::Compare::smartSortKey( YItem * item ) const
+NCTableSortDefault::smartSortKey( YItem * item ) const
 {
     std::wstring empty;
 
@@ -102,7 +134,7 @@ NCTableSortDefault::Compare::smartSortKey( YItem * item ) const
     if ( ! tableItem )
         return empty;
 
-    YTableCell * tableCell = tableItem->cell( _sortCol );
+    YTableCell * tableCell = tableItem->cell( sortCol() );
 
     if ( ! tableCell )
         return empty;
@@ -116,4 +148,3 @@ NCTableSortDefault::Compare::smartSortKey( YItem * item ) const
 
     return result.str();
 }
-
@@ -77,44 +77,57 @@ public:
 private:
 
     /**
-     * Comparison functor.
+     * The sort key of one item. It is extracted once for each item before
+     * sorting, not for each comparison.
      *
      * This uses the sort key of the cell if it has one, the label if not.
+     * If that is a number, it is compared numerically; otherwise its
+     * collation key (from wcsxfrm()) is compared.
+     **/
+    struct SortKey
+    {
+	YItem *	     item;
+	bool	     isNumber;
+	long long    number;
+	std::wstring collationKey;
+    };
+
+    /**
+     * Return the sort key of column no. sortCol() for an item.
+     **/
+    SortKey sortKey( YItem * item ) const;
+
+    /**
+     * Return the sort key of column no. sortCol() for an item or, if it
+     * doesn't have one, its label in that column.
+     **/
+    std::wstring smartSortKey( YItem * item ) const;
+
+    /**
+     * Try to convert a string to a number. Return the number and set the
+     * 'ok' flag to 'true' on success, to 'false' on failure.
+     **/
+    long long toNumber( const std::wstring& str, bool * ok ) const;
+
+    /**
+     * Comparison functor for the sort keys.
      *
-     * It also tries to convert strings to numbers to do a numeric comparison
-     * if possible.
+     * Numbers are sorted before strings, no matter if the order is reversed.
      **/
     class Compare
     {
     public:
-	Compare( int sortCol, bool reverse )
-	    : _sortCol( sortCol )
-            , _reverse( reverse )
+	Compare( bool reverse )
+            : _reverse( reverse )
 	    {}
 
         /**
-         * The comparison itself: Return the result of  item1 < item2
+         * The comparison itself: Return the result of  key1 < key2
          **/
-	bool operator() ( YItem * item1, YItem * item2 ) const;
+	bool operator() ( const SortKey & key1, const SortKey & key2 ) const;
 
     protected:
 
-        /**
-         * Return the sort key of column no. _sortCol for an item or, if it
-         * doesn't have one, its label in that column.
-         **/
-	std::wstring smartSortKey( YItem * item ) const;
-
-        /**
-         * Try to convert a string to a number. Return the number and set the
-         * 'ok' flag to 'true' on success, to 'false' on failure.
-         **/
-	long long toNumber( const std::wstring& str, bool * ok ) const;
-
-
-        // Data members
-
-	const int  _sortCol;
 	const bool _reverse;
     };
 
@@ -57,7 +57,10 @@ void NCTreePad::ShowItem( const NCTableLine * item )
     if ( !item )
 	return;
 
-    if ( const_cast<NCTableLine *>( item )->ChangeToVisible() || _dirtyFormat )
+    if ( const_cast<NCTableLine *>( item )->ChangeToVisible() )
+	setVisibleItemsDirty();
+
+    if ( _dirtyFormat )
 	UpdateFormat();
 
     for ( unsigned i = 0; i < visibleLines(); ++i )
@@ -80,7 +83,12 @@ int NCTreePad::DoRedraw()
     }
 
     prepareRedraw();
-    drawContentLines();
+
+    if ( ! paging() )
+        drawContentLines();
+    // else
+    //   item drawing requested via directDraw()
+
     drawHeader();
 
     dirty = false;
@@ -25,6 +25,10 @@
 #include <errno.h>
 #include <iconv.h>
 #include <malloc.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
 
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
@@ -54,6 +58,14 @@ NCstring::NCstring( const NCstring & nstr )
 }
 
 
+NCstring::NCstring( NCstring && nstr ) noexcept
+	: hotk( nstr.hotk )
+	, hotp( nstr.hotp )
+	, wstr( std::move( nstr.wstr ) )
+{
+}
+
+
 NCstring::NCstring( const std::wstring & widestr )
 	: hotk( 0 )
 	, hotp( std::wstring::npos )
@@ -62,6 +74,14 @@ NCstring::NCstring( const std::wstring & widestr )
 }
 
 
+NCstring::NCstring( std::wstring && widestr )
+	: hotk( 0 )
+	, hotp( std::wstring::npos )
+	, wstr( std::move( widestr ) )
+{
+}
+
+
 NCstring::NCstring( const std::string & str )
 	: hotk( 0 )
 	, hotp( std::wstring::npos )
@@ -107,12 +127,313 @@ NCstring & NCstring::operator=( const NCstring & nstr )
 }
 
 
+NCstring & NCstring::operator=( NCstring && nstr ) noexcept
+{
+    if ( &nstr != this )
+    {
+	hotk	  = nstr.hotk;
+	hotp	  = nstr.hotp;
+	wstr	  = std::move( nstr.wstr );
+    }
+
+    return *this;
+}
+
+
 NCstring & NCstring::operator+=( const NCstring & nstr )
 {
     wstr.append( nstr.wstr );
     return *this;
 }
 
+// UTF-8 is recoded without iconv: The text of every widget is recoded,
+// and nearly all of it is plain ASCII, which is handled 8 bytes at a time.
+//
+// Invalid input is treated like iconv does: Each byte (or wide character)
+// that does not start a valid sequence becomes a '?'. After a NUL, the
+// output is dropped up to the next invalid sequence (iconv's output was
+// appended as a C string).
+
+static const uint64_t lowBits	= 0x0101010101010101ULL;
+static const uint64_t highBits	= 0x8080808080808080ULL;
+
+
+/**
+ * Return true if the 8 bytes at 'p' are ASCII characters other than NUL.
+ **/
+static inline bool asciiBlock( const unsigned char * p )
+{
+    uint64_t v;
+    memcpy( &v, p, sizeof( v ) );
+
+    // the high bit is set for non-ASCII bytes and (via the borrow) for NUL
+    return ( ( v | ( ( v - lowBits ) & ~v ) ) & highBits ) == 0;
+}
+
+
+/**
+ * Decode the UTF-8 sequence at 'p' before 'end' to 'ch' and return its
+ * length, or 0 if it is invalid or incomplete.
+ **/
+static inline size_t decodeUtf8( const unsigned char * p, const unsigned char * end, uint32_t & ch )
+{
+    uint32_t c	   = p[0];
+    size_t   avail = end - p;
+
+    if ( c < 0x80 )
+    {
+	ch = c;
+	return 1;
+    }
+    else if ( c < 0xc2 )	// continuation byte or overlong 2 byte sequence
+    {
+	return 0;
+    }
+    else if ( c < 0xe0 )
+    {
+	if ( avail < 2 || ( p[1] & 0xc0 ) != 0x80 )
+	    return 0;
+
+	ch = ( ( c & 0x1f ) << 6 ) | ( p[1] & 0x3f );
+	return 2;
+    }
+    else if ( c < 0xf0 )
+    {
+	if ( avail < 3 || ( p[1] & 0xc0 ) != 0x80 || ( p[2] & 0xc0 ) != 0x80 )
+	    return 0;
+
+	c = ( ( c & 0x0f ) << 12 ) | ( ( p[1] & 0x3f ) << 6 ) | ( p[2] & 0x3f );
+
+	if ( c < 0x800 || ( c >= 0xd800 && c <= 0xdfff ) )
+	    return 0;
+
+	ch = c;
+	return 3;
+    }
+    else if ( c < 0xf5 )
+    {
+	if ( avail < 4 || ( p[1] & 0xc0 ) != 0x80 || ( p[2] & 0xc0 ) != 0x80 || ( p[3] & 0xc0 ) != 0x80 )
+	    return 0;
+
+	c = ( ( c & 0x07 ) << 18 ) | ( ( p[1] & 0x3f ) << 12 ) | ( ( p[2] & 0x3f ) << 6 ) | ( p[3] & 0x3f );
+
+	if ( c < 0x10000 || c > 0x10ffff )
+	    return 0;
+
+	ch = c;
+	return 4;
+    }
+
+    return 0;
+}
+
+
+/**
+ * Return the length of the UTF-8 sequence for 'ch', or 0 if 'ch' is not a
+ * valid character.
+ **/
+static inline size_t utf8Length( uint32_t ch )
+{
+    if ( ch < 0x80 )
+	return 1;
+    else if ( ch < 0x800 )
+	return 2;
+    else if ( ch >= 0xd800 && ch <= 0xdfff )
+	return 0;
+    else if ( ch < 0x10000 )
+	return 3;
+    else if ( ch <= 0x10ffff )
+	return 4;
+    else
+	return 0;
+}
+
+
+static bool utf8ToWchar( const std::string & in, std::wstring * out )
+{
+    static bool complained = false;
+
+    // at most one wide character per byte
+    out->resize( in.size() );
+
+    const unsigned char * p   = (const unsigned char *) in.data();
+    const unsigned char * end = p + in.size();
+    wchar_t * dest  = &( *out )[0];
+    wchar_t * start = dest;
+    bool dropping   = false;
+
+    while ( p < end )
+    {
+	if ( !dropping )
+	{
+	    // unrolled by hand, this is compiled with -Os
+	    while ( end - p >= 8 && asciiBlock( p ) )
+	    {
+		dest[0] = p[0];
+		dest[1] = p[1];
+		dest[2] = p[2];
+		dest[3] = p[3];
+		dest[4] = p[4];
+		dest[5] = p[5];
+		dest[6] = p[6];
+		dest[7] = p[7];
+
+		p    += 8;
+		dest += 8;
+	    }
+
+	    // ASCII other than NUL: 0 wraps around to the largest value
+	    while ( p < end && (unsigned) *p - 1 < 0x7f )
+		*dest++ = *p++;
+
+	    if ( p == end )
+		break;
+	}
+
+	uint32_t ch  = 0;
+	size_t   len = decodeUtf8( p, end, ch );
+
+	if ( len == 0 )
+	{
+	    if ( !complained )
+	    {
+		yuiError() << "ERROR: invalid UTF-8 sequence" << std::endl;
+		complained = true;
+	    }
+
+	    *dest++  = L'?';
+	    dropping = false;
+	    p++;
+	}
+	else
+	{
+	    if ( ch == 0 )
+		dropping = true;
+	    else if ( !dropping )
+		*dest++ = ch;
+
+	    p += len;
+	}
+    }
+
+    out->resize( dest - start );
+
+    return true;
+}
+
+
+static bool wcharToUtf8( const std::wstring & in, std::string * out )
+{
+    static bool complained = false;
+    static const uint64_t lowLanes  = 0x0000000100000001ULL;
+    static const uint64_t highLanes = 0xffffff80ffffff80ULL;
+
+    // one byte per character, grown for multibyte characters as needed
+    out->resize( in.size() );
+
+    const wchar_t * p   = in.data();
+    const wchar_t * end = p + in.size();
+    char * dest  = &( *out )[0];
+    char * start = dest;
+    bool dropping = false;
+
+    while ( p < end )
+    {
+	if ( !dropping )
+	{
+	    // Test 4 characters at a time, 2 in each 64 bit word (like
+	    // asciiBlock). The test doesn't depend on the byte order, but
+	    // which half of a word is which character does: Copy them from
+	    // the characters themselves.
+
+	    while ( end - p >= 4 )
+	    {
+		uint64_t v, w;
+		memcpy( &v, p,	   sizeof( v ) );
+		memcpy( &w, p + 2, sizeof( w ) );
+
+		if ( ( ( v | ( v - lowLanes ) | w | ( w - lowLanes ) ) & highLanes ) != 0 )
+		    break;
+
+		dest[0] = (char) p[0];
+		dest[1] = (char) p[1];
+		dest[2] = (char) p[2];
+		dest[3] = (char) p[3];
+
+		p    += 4;
+		dest += 4;
+	    }
+
+	    // ASCII other than NUL: 0 wraps around to the largest value
+	    while ( p < end && (uint32_t) *p - 1 < 0x7f )
+		*dest++ = (char) *p++;
+
+	    if ( p == end )
+		break;
+	}
+
+	// room for this character and one byte for each of the others
+	if ( (size_t)( end - p ) + 3 > out->size() - ( dest - start ) )
+	{
+	    size_t used = dest - start;
+	    out->resize( std::max( out->size() * 3 / 2, used + ( end - p ) + 3 ) );
+	    start = &( *out )[0];
+	    dest  = start + used;
+	}
+
+	uint32_t ch  = (uint32_t) *p++;
+	size_t   len = utf8Length( ch );
+
+	if ( len == 0 )
+	{
+	    if ( !complained )
+	    {
+		yuiError() << "ERROR: invalid wide character " << std::hex << ch << std::dec << std::endl;
+		complained = true;
+	    }
+
+	    *dest++  = '?';
+	    dropping = false;
+	}
+	else if ( ch == 0 )
+	{
+	    dropping = true;
+	}
+	else if ( !dropping )
+	{
+	    switch ( len )
+	    {
+		case 1:
+		    *dest++ = (char) ch;
+		    break;
+
+		case 2:
+		    *dest++ = (char) ( 0xc0 | ( ch >> 6 ) );
+		    *dest++ = (char) ( 0x80 | ( ch & 0x3f ) );
+		    break;
+
+		case 3:
+		    *dest++ = (char) ( 0xe0 | ( ch >> 12 ) );
+		    *dest++ = (char) ( 0x80 | ( ( ch >> 6 ) & 0x3f ) );
+		    *dest++ = (char) ( 0x80 | ( ch & 0x3f ) );
+		    break;
+
+		default:
+		    *dest++ = (char) ( 0xf0 | ( ch >> 18 ) );
+		    *dest++ = (char) ( 0x80 | ( ( ch >> 12 ) & 0x3f ) );
+		    *dest++ = (char) ( 0x80 | ( ( ch >> 6 ) & 0x3f ) );
+		    *dest++ = (char) ( 0x80 | ( ch & 0x3f ) );
+		    break;
+	    }
+	}
+    }
+
+    out->resize( dest - start );
+
+    return true;
+}
+
+
 static iconv_t fromwchar_cd	= ( iconv_t )( -1 );
 static std::string  to_name		= "";
 
@@ -120,6 +441,9 @@ static std::string  to_name		= "";
 
 bool NCstring::RecodeFromWchar( const std::wstring & in, const std::string & to_encoding, std::string* out )
 {
+    if ( to_encoding == "UTF-8" && sizeof( wchar_t ) == 4 )
+	return wcharToUtf8( in, out );
+
     iconv_t cd = ( iconv_t )( -1 );
     static bool complained = false;
     *out = "";
@@ -212,6 +536,9 @@ static std::string  from_name	= "";
 
 bool NCstring::RecodeToWchar( const std::string& in, const std::string &from_encoding, std::wstring* out )
 {
+    if ( from_encoding == "UTF-8" && sizeof( wchar_t ) == 4 )
+	return utf8ToWchar( in, out );
+
     iconv_t cd = ( iconv_t )( -1 );
     static bool complained = false;
     *out = L"";
@@ -58,8 +58,12 @@ public:
 
     NCstring( const NCstring & nstr );
 
+    NCstring( NCstring && nstr ) noexcept;
+
     NCstring( const std::wstring & wstr );
 
+    NCstring( std::wstring && wstr );
+
     /// Init from a UTF-8 string.
     NCstring( const std::string & str );
 
@@ -75,6 +79,8 @@ public:
 
     NCstring & operator=( const NCstring & nstr );
 
+    NCstring & operator=( NCstring && nstr ) noexcept;
+
     NCstring & operator+=( const NCstring & nstr );
 
     const std::wstring & str()      const { return wstr; }
@@ -88,6 +94,8 @@ private:
 
 public:
 
+    /// Recode from/to wide characters. UTF-8 is recoded directly,
+    /// other encodings with iconv. Invalid characters become '?'.
     static bool RecodeToWchar  ( const std::string & in,  const std::string & from_encoding, std::wstring * out );
     static bool RecodeFromWchar( const std::wstring & in, const std::string & to_encoding,   std::string  * out );
 
@@ -27,6 +27,7 @@
 #include "NCtext.h"
 #include "stringutil.h"
 
+#include <algorithm>
 #include <wchar.h>		// wcwidth
 #include <langinfo.h>
 
@@ -35,6 +36,58 @@
 const NCstring NCtext::emptyStr;
 
 
+/**
+ * Return true if a line of 'len' characters is not broken into several rows
+ * at 'columns'.
+ **/
+static bool fitsColumns( std::wstring::size_type len, size_t columns )
+{
+    return len <= columns || columns < 2;
+}
+
+
+/**
+ * Return the number of rows a line of 'len' characters is broken into at
+ * 'columns' by wrapLine().
+ **/
+static size_t wrappedRows( std::wstring::size_type len, size_t columns )
+{
+    if ( fitsColumns( len, columns ) )
+	return 1;
+
+    return 1 + ( len - columns + columns - 2 ) / ( columns - 1 );
+}
+
+
+/**
+ * Add the line text[ start, start + len ) to 'rows', broken into rows of
+ * 'columns' characters. The continuation rows start with '~'.
+ **/
+static void wrapLine( const std::wstring & text,
+		      std::wstring::size_type start,
+		      std::wstring::size_type len,
+		      size_t columns,
+		      std::vector<NCstring> & rows )
+{
+    if ( fitsColumns( len, columns ) )
+    {
+	rows.push_back( NCstring( text.substr( start, len ) ) );
+	return;
+    }
+
+    rows.push_back( NCstring( text.substr( start, columns ) ) );
+
+    std::wstring::size_type end = start + len;
+
+    for ( std::wstring::size_type pos = start + columns; pos < end; pos += columns - 1 )
+    {
+	std::wstring row( 1, L'~' );
+	row.append( text, pos, std::min( columns - 1, end - pos ) );
+	rows.push_back( NCstring( std::move( row ) ) );
+    }
+}
+
+
 
 
 NCtext::NCtext( const NCstring & nstr )
@@ -120,24 +173,7 @@ void NCtext::lbrset( const NCstring & ntext, size_t columns )
 
     while ( cpos != std::wstring::npos )
     {
-	std::wstring line = text.substr( spos, cpos - spos );
-
-	if ( line.size() <= columns )
-	{
-	    mtext.push_back( NCstring( line ) );
-	}
-	else
-	{
-	    size_t start = columns;
-	    mtext.push_back( NCstring( line.substr( 0, columns ) ) );
-
-	    while ( start < line.size() )
-	    {
-		// yuiDebug() << "Add: " << line.substr( start, columns ) << std::endl;
-		mtext.push_back( NCstring( L'~' + line.substr( start, columns - 1 ) ) );
-		start += columns - 1;
-	    }
-	}
+	wrapLine( text, spos, cpos - spos, columns, mtext );
 
 	spos = cpos + 1;
 
@@ -171,6 +207,27 @@ void NCtext::append( const NCstring &line )
 
 
 
+void NCtext::append( const NCtext & other )
+{
+    mtext.insert( mtext.end(), other.mtext.begin(), other.mtext.end() );
+}
+
+
+
+void NCtext::removeFirstLines( unsigned count )
+{
+    mtext.erase( mtext.begin(), mtext.begin() + std::min( (size_t) count, mtext.size() ) );
+}
+
+
+
+void NCtext::removeLastLines( unsigned count )
+{
+    mtext.resize( mtext.size() - std::min( (size_t) count, mtext.size() ) );
+}
+
+
+
 size_t NCtext::Columns() const
 {
     size_t llen = 0;		// longest line
@@ -205,12 +262,7 @@ const NCstring & NCtext::operator[]( std::wstring::size_type idx ) const
     if ( idx >= Lines() )
 	return emptyStr;
 
-    const_iterator line = mtext.begin();
-
-    for ( ; idx; --idx, ++line )
-	;
-
-    return *line;
+    return mtext[ idx ];
 }
 
 
@@ -222,6 +274,158 @@ std::ostream & operator<<( std::ostream & str, const NCtext & obj )
 
 
 
+NCwrappedText::NCwrappedText()
+    : _rows( 0 )
+    , _first( 0 )
+    , _columns( 0 )
+{
+}
+
+
+void NCwrappedText::append( const NCstring & line )
+{
+    _lines.push_back( line );
+
+    // handle DOS text
+    if ( line.str().find( L'\r' ) != std::wstring::npos )
+    {
+	std::wstring text( line.str() );
+	boost::erase_all( text, L"\r" );
+	_lines.back() = NCstring( std::move( text ) );
+    }
+}
+
+
+void NCwrappedText::removeFirstLines( unsigned count )
+{
+    _first += std::min( (size_t) count, (size_t) Lines() );
+
+    // Drop the removed lines once they are the majority (so this is
+    // constant time on average)
+
+    if ( _first < 64 || _first * 2 < _lines.size() )
+	return;
+
+    size_t wrapped  = std::min( _first, _rowStart.size() );
+    size_t firstRow = rowStart( _first );
+
+    _lines.erase( _lines.begin(), _lines.begin() + _first );
+    _rowStart.erase( _rowStart.begin(), _rowStart.begin() + wrapped );
+
+    for ( size_t & start : _rowStart )
+	start -= firstRow;
+
+    _rows -= firstRow;
+    _first = 0;
+}
+
+
+void NCwrappedText::removeLastLines( unsigned count )
+{
+    _lines.resize( _lines.size() - std::min( (size_t) count, (size_t) Lines() ) );
+
+    if ( _rowStart.size() > _lines.size() )
+    {
+	_rows = _rowStart[ _lines.size() ];
+	_rowStart.resize( _lines.size() );
+    }
+}
+
+
+void NCwrappedText::clear()
+{
+    _lines.clear();
+    _rowStart.clear();
+    _rows  = 0;
+    _first = 0;
+}
+
+
+void NCwrappedText::setWrapColumns( size_t columns )
+{
+    if ( columns == _columns )
+	return;
+
+    // The lines that fit into both the old and the new columns keep their
+    // rows; count them again from the first other one on.
+
+    size_t idx = _first;
+
+    while ( idx < _rowStart.size()
+	    && fitsColumns( _lines[ idx ].str().size(), _columns )
+	    && fitsColumns( _lines[ idx ].str().size(), columns ) )
+    {
+	++idx;
+    }
+
+    if ( idx < _rowStart.size() )
+    {
+	_rows = _rowStart[ idx ];
+	_rowStart.resize( idx );
+    }
+
+    _columns = columns;
+}
+
+
+void NCwrappedText::wrap()
+{
+    _rowStart.reserve( _lines.size() );
+
+    while ( _rowStart.size() < _lines.size() )
+    {
+	_rowStart.push_back( _rows );
+	_rows += wrappedRows( _lines[ _rowStart.size() - 1 ].str().size(), _columns );
+    }
+}
+
+
+unsigned NCwrappedText::Rows()
+{
+    wrap();
+    return _rows - rowStart( _first );
+}
+
+
+void NCwrappedText::row( unsigned idx, std::wstring & result )
+{
+    wrap();
+
+    size_t row = rowStart( _first ) + idx;
+
+    if ( row >= _rows )
+    {
+	result.clear();
+	return;
+    }
+
+    // the last line starting at or before 'row'
+    size_t line = std::upper_bound( _rowStart.begin() + _first, _rowStart.end(), row )
+	- _rowStart.begin() - 1;
+
+    const std::wstring & text = _lines[ line ].str();
+    size_t part = row - _rowStart[ line ];
+
+    if ( part == 0 )
+    {
+	result.assign( text, 0, fitsColumns( text.size(), _columns ) ? text.size() : _columns );
+    }
+    else
+    {
+	result.assign( 1, L'~' );
+	result.append( text, _columns + ( part - 1 ) * ( _columns - 1 ), _columns - 1 );
+    }
+}
+
+
+unsigned NCwrappedText::firstRow( unsigned idx )
+{
+    wrap();
+    return rowStart( _first + idx ) - rowStart( _first );
+}
+
+
+
 
 void NClabel::stripHotkey()
 {
@@ -26,7 +26,7 @@
 #define NCtext_h
 
 #include <iosfwd>
-#include <list>
+#include <vector>
 
 #include "NCstring.h"
 #include "NCWidget.h"
@@ -41,8 +41,8 @@ class NCtext
 
 public:
 
-    typedef std::list<NCstring>::iterator	   iterator;
-    typedef std::list<NCstring>::const_iterator const_iterator;
+    typedef std::vector<NCstring>::iterator	     iterator;
+    typedef std::vector<NCstring>::const_iterator const_iterator;
 
 private:
 
@@ -50,7 +50,7 @@ private:
 
 protected:
 
-    std::list<NCstring> mtext;
+    std::vector<NCstring> mtext;
 
     virtual void lset( const NCstring & ntext );
     void lbrset( const NCstring & ntext, size_t columns );
@@ -67,7 +67,18 @@ public:
 
     void append( const NCstring & line );
 
-    const std::list<NCstring> & Text() const { return mtext; }
+    /**
+     * Append all lines of 'other'.
+     **/
+    void append( const NCtext & other );
+
+    /**
+     * Remove 'count' lines at the start or at the end, respectively.
+     **/
+    void removeFirstLines( unsigned count );
+    void removeLastLines( unsigned count );
+
+    const std::vector<NCstring> & Text() const { return mtext; }
 
     const NCstring &	   operator[]( std::wstring::size_type idx ) const;
 
@@ -108,7 +119,7 @@ public:
 
     wsze     size()   const { return wsze( Lines(), Columns() ); }
 
-    const std::list<NCstring> & getText() const { return Text(); }
+    const std::vector<NCstring> & getText() const { return Text(); }
 
     void drawAt( NCursesWindow & w, chtype style, chtype hotstyle,
 		 const wrect & dim,
@@ -181,4 +192,97 @@ public:
 };
 
 
+/**
+ * Lines of text that are wrapped to a number of columns on demand, e.g. the
+ * lines of a log.
+ *
+ * Like in NCtext( text, columns ), lines longer than the columns are broken
+ * into several rows, and the continuation rows start with '~'.
+ *
+ * Only the first row of each line is stored, the rows themselves are created
+ * when they are needed (see row()). Appending lines only wraps the new lines,
+ * and after the columns changed, only the lines from the first one that wraps
+ * differently on are wrapped again. Lines can also be removed at the start
+ * in (amortized) constant time.
+ **/
+class NCwrappedText
+{
+public:
+
+    NCwrappedText();
+
+    /**
+     * Return the number of lines (not rows).
+     **/
+    unsigned Lines() const { return _lines.size() - _first; }
+
+    /**
+     * Return line 'idx' (not wrapped).
+     **/
+    const NCstring & operator[]( unsigned idx ) const { return _lines[ _first + idx ]; }
+
+    /**
+     * Add a line at the end. The line should not contain a newline.
+     **/
+    void append( const NCstring & line );
+
+    /**
+     * Remove 'count' lines at the start or at the end, respectively.
+     **/
+    void removeFirstLines( unsigned count );
+    void removeLastLines( unsigned count );
+
+    /**
+     * Remove all lines.
+     **/
+    void clear();
+
+    /**
+     * Set the number of columns to wrap the lines to. 0 means no wrapping.
+     **/
+    void setWrapColumns( size_t columns );
+
+    size_t wrapColumns() const { return _columns; }
+
+    /**
+     * Return the number of rows of the wrapped lines.
+     **/
+    unsigned Rows();
+
+    /**
+     * Set 'result' to the wrapped row 'idx'. The rows are not stored, only
+     * their number per line, so this creates the row (in the buffer of
+     * 'result' if it is large enough).
+     **/
+    void row( unsigned idx, std::wstring & result );
+
+    /**
+     * Return the index of the first row of line 'idx'. For 'idx' == Lines()
+     * this is the number of rows.
+     **/
+    unsigned firstRow( unsigned idx );
+
+private:
+
+    /**
+     * Count the rows of the lines that are not wrapped yet.
+     **/
+    void wrap();
+
+    /**
+     * Return the first row of line _lines[ idx ].
+     **/
+    size_t rowStart( size_t idx ) const
+    {
+	return idx < _rowStart.size() ? _rowStart[ idx ] : _rows;
+    }
+
+    std::vector<NCstring> _lines;	///< the lines; the first _first ones are removed
+    std::vector<size_t>	  _rowStart;	///< the first row of each wrapped line
+    size_t		  _rows;	///< number of rows of the first _rowStart.size() lines
+    size_t		  _first;	///< number of removed lines at the start of _lines
+    size_t		  _columns;	///< the columns the rows are wrapped to
+};
+
+
 #endif // NCtext_h
@@ -27,6 +27,7 @@
 
 #include <cstdarg>
 #include <fstream>
+#include <limits>
 #include <list>
 #include <set>
 
@@ -48,6 +49,10 @@ using stdutil::form;
 
 NCurses * NCurses::myself = 0;
 std::set<NCDialog*> NCurses::_knownDlgs;
+int  NCurses::_updateBatches = 0;
+bool NCurses::_pendingUpdate = false;
+bool NCurses::_countBytes = false;
+NCurses::FrameStats NCurses::_frameStats = { 0, 0, 0, 0 };
 const NCursesEvent NCursesEvent::Activated( NCursesEvent::button, YEvent::Activated );
 const NCursesEvent NCursesEvent::SelectionChanged( NCursesEvent::button, YEvent::SelectionChanged );
 const NCursesEvent NCursesEvent::ValueChanged( NCursesEvent::button, YEvent::ValueChanged );
@@ -136,6 +141,8 @@ NCurses::NCurses()
 
     if ( term && *term )
 	envTerm = term;
+
+    _countBytes = getenv( "Y2NCURSES_FRAME_STATS" ) != NULL;
 }
 
 
@@ -145,6 +152,11 @@ NCurses::~NCurses()
     yuiMilestone() << "Shutdown NCurses..." << std::endl;
     myself = 0;
 
+    if ( _countBytes )
+	yuiMilestone() << "Terminal output: " << _frameStats.bytes << " bytes in "
+		       << _frameStats.frames << " frames ("
+		       << _frameStats.fullFrames << " full)" << std::endl;
+
     //restore env. variable - might have been changed by NCurses::init()
     setenv( "TERM", envTerm.c_str(), 1 );
     delete styleset;
@@ -416,12 +428,33 @@ void NCurses::Update()
 {
     if ( myself && myself->initialized() )
     {
-	//myself->stdpan->refresh();
-	myself->stdpan->redraw();
+	if ( _updateBatches )
+	{
+	    _pendingUpdate = true;
+	    return;
+	}
+
+	writeUpdate();
     }
 }
 
 
+void NCurses::writeUpdate()
+{
+    // copy only the damaged parts of the windows to the virtual screen
+    NCursesPanel::syncpanels();
+    ::update_panels();
+    writeFrame( false );
+}
+
+
+void NCurses::flushUpdateBatch()
+{
+    if ( _pendingUpdate && myself && myself->initialized() )
+	writeUpdate();
+}
+
+
 void NCurses::Refresh()
 {
     if ( myself && myself->initialized() )
@@ -430,18 +463,87 @@ void NCurses::Refresh()
 	SetTitle( myself->title_t );
 	SetStatusLine( myself->status_line );
 	::clearok( ::stdscr, true );
-	myself->stdpan->refresh();
+	NCursesPanel::syncpanels();
+	::update_panels();
+	writeFrame( true );
 	yuiDebug() << "done refresh ..." << std::endl;
     }
 }
 
 
+void NCurses::startUpdateBatch()
+{
+    ++_updateBatches;
+}
+
+
+void NCurses::endUpdateBatch()
+{
+    if ( --_updateBatches == 0 && _pendingUpdate )
+    {
+	_pendingUpdate = false;
+	Update();
+    }
+}
+
+
+/**
+ * Return the number of bytes written by the current thread so far or 0 if
+ * unknown.
+ **/
+static unsigned long long writtenBytes()
+{
+    unsigned long long bytes = 0;
+    std::ifstream io( "/proc/thread-self/io" );
+    std::string key;
+
+    while ( io >> key )
+    {
+	if ( key == "wchar:" )
+	{
+	    io >> bytes;
+	    break;
+	}
+
+	io.ignore( std::numeric_limits<std::streamsize>::max(), '\n' );
+    }
+
+    return bytes;
+}
+
+
+void NCurses::writeFrame( bool full )
+{
+    unsigned long long before = _countBytes ? writtenBytes() : 0;
+
+    ::doupdate();
+
+    _pendingUpdate = false;
+    ++_frameStats.frames;
+
+    if ( full )
+	++_frameStats.fullFrames;
+
+    if ( _countBytes )
+    {
+	_frameStats.lastBytes = writtenBytes() - before;
+	_frameStats.bytes += _frameStats.lastBytes;
+
+	yuiDebug() << "Frame " << _frameStats.frames << ( full ? " (full): " : ": " )
+		   << _frameStats.lastBytes << " bytes" << std::endl;
+    }
+}
+
+
 void NCurses::Redraw()
 {
     if ( myself && myself->initialized() )
     {
 	yuiDebug() << "start redraw ..." << std::endl;
 
+	// the recoded dialogs are written at once by Refresh()
+	UpdateBatch batch;
+
 	// initialize all dialogs rewdraw
 	PANEL * pan = ::panel_above( NULL );
 
@@ -625,7 +727,9 @@ void NCurses::ResizeEvent()
 	    ( *it )->getVisible();
 	}
 
-	Update();
+	// the whole screen has to be repainted
+	NCursesPanel::syncpanels( true );
+	::update_panels();
 
 	//FIXME: remove this once libncurses is upgraded to 20080105 patchlevel
 	//after the resize, status line window needs to be moved to the new pos.
@@ -633,7 +737,7 @@ void NCurses::ResizeEvent()
 	SetStatusLine( myself->status_line );
 	//update the screen
 	::touchwin( myself->status_w );
-	::doupdate();
+	writeFrame( true );
 
 	yuiDebug() << "done resize ..." << std::endl;
     }
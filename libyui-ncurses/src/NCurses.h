@@ -202,9 +202,62 @@ public:
 
     static const NCstyle & style();
 
+    /**
+     * Write the changed parts of the visible dialogs to the terminal.
+     * Within an UpdateBatch this is deferred to the end of the batch.
+     **/
     static void Update();
+
+    /**
+     * Recode all dialogs and repaint the whole screen, e.g. after a style
+     * change.
+     **/
     static void Redraw();
+
+    /**
+     * Repaint the whole screen without relying on its current content.
+     **/
     static void Refresh();
+
+    /**
+     * Helper class to collect all Update() calls within its scope and to
+     * write the changes to the terminal only once at its end.
+     **/
+    class UpdateBatch
+    {
+    public:
+	UpdateBatch()	{ startUpdateBatch(); }
+	~UpdateBatch()	{ endUpdateBatch(); }
+    };
+
+    /**
+     * Start and end a batch of Update() calls without an UpdateBatch
+     * object. Batches may be nested; the changes are written at the end of
+     * the outermost one.
+     **/
+    static void startUpdateBatch();
+    static void endUpdateBatch();
+
+    /**
+     * Write the changes collected so far by the current batch right away,
+     * e.g. before waiting for the user. The batch continues.
+     **/
+    static void flushUpdateBatch();
+
+    /**
+     * Statistics of the terminal output. The bytes are only counted if the
+     * Y2NCURSES_FRAME_STATS environment variable is set.
+     **/
+    struct FrameStats
+    {
+	unsigned long	   frames;	// doupdate() calls
+	unsigned long	   fullFrames;	// frames repainting the whole screen
+	unsigned long long bytes;	// bytes written in all frames
+	unsigned long	   lastBytes;	// bytes written in the last frame
+    };
+
+    static const FrameStats & frameStats() { return _frameStats; }
+
     static void SetTitle( const std::string & str );
     static void SetStatusLine( std::map <int, NCstring> fkeys );
     static void ScreenShot( const std::string & name = "screen.shot" );
@@ -220,6 +273,18 @@ public:
 
 private:
     static std::set<NCDialog*> _knownDlgs;
+
+    /**
+     * Write the damaged parts of the visible dialogs to the terminal.
+     **/
+    static void writeUpdate();
+
+    static void writeFrame( bool full );
+
+    static int	      _updateBatches;
+    static bool	      _pendingUpdate;
+    static bool	      _countBytes;
+    static FrameStats _frameStats;
 };
 
 
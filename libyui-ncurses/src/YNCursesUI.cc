@@ -156,6 +156,18 @@ void YNCursesUI::idleLoopSetEnabled( bool enabled )
     idle_loop_enabled = enabled;
 }
 
+void YNCursesUI::startBuiltinCalls()
+{
+    NCurses::startUpdateBatch();
+}
+
+
+void YNCursesUI::endBuiltinCalls()
+{
+    NCurses::endUpdateBatch();
+}
+
+
 void YNCursesUI::idleLoop( int fd_ycp )
 {
 
@@ -102,6 +102,15 @@ public:
      */
     virtual void idleLoop( int fd_ycp );
 
+    /**
+     * Collect the screen updates of the built-in calls of one command and
+     * write them at once in endBuiltinCalls().
+     *
+     * Reimplemented from YUI.
+     **/
+    virtual void startBuiltinCalls();
+    virtual void endBuiltinCalls();
+
     /**
      * Set the (text) console font according to the current encoding etc.
      * See the setfont(8) command and the console HowTo for details.
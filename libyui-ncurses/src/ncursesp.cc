@@ -108,6 +108,21 @@ NCursesPanel::redraw()
     ::doupdate();
 }
 
+void
+NCursesPanel::syncpanels( bool all )
+{
+    for ( PANEL * pan = ::panel_above( NULL ); pan; pan = ::panel_above( pan ) )
+    {
+	const NCursesPanel * panel = get_Panel_of( *pan );
+
+	if ( panel )
+	    const_cast<NCursesPanel *>( panel )->syncsubwins();
+
+	if ( all )
+	    ::touchwin( panel_window( pan ) );
+    }
+}
+
 int
 NCursesPanel::refresh()
 {
@@ -251,6 +251,13 @@ public:
      */
     static void redraw();
 
+    /**
+     * Propagate the changes of the subwindows of all panels to the panels,
+     * so that update_panels() copies only the changed parts to the virtual
+     * screen. With 'all' the panels are marked as changed completely.
+     */
+    static void syncpanels( bool all = false );
+
     // decorations
     /**
      * Put a frame around the panel and put the title centered in the top line
@@ -106,12 +106,10 @@ NCursesWindow::printw( int y, int x, const char * fmt, ... )
 int
 NCursesWindow::addwstr( int y, int x, const wchar_t * str, int n )
 {
-    const std::wstring wstr( str );
-    std::string out;
-
     if ( NCstring::terminalEncoding() != "UTF-8" )
     {
-	NCstring::RecodeFromWchar( wstr, NCstring::terminalEncoding(), &out );
+	std::string out;
+	NCstring::RecodeFromWchar( str, NCstring::terminalEncoding(), &out );
 	return ::mvwaddnstr( w, y, x, out.c_str(), n );
     }
     else
@@ -123,12 +121,10 @@ NCursesWindow::addwstr( int y, int x, const wchar_t * str, int n )
 int
 NCursesWindow::addwstr( const wchar_t* str, int n )
 {
-    const std::wstring wstr( str );
-    std::string out;
-
     if ( NCstring::terminalEncoding() != "UTF-8" )
     {
-	NCstring::RecodeFromWchar( wstr, NCstring::terminalEncoding(), &out );
+	std::string out;
+	NCstring::RecodeFromWchar( str, NCstring::terminalEncoding(), &out );
 	return ::waddnstr( w, out.c_str(), n );
     }
     else
@@ -449,6 +445,22 @@ NCursesWindow::kill_subwindows()
 }
 
 
+void
+NCursesWindow::syncsubwins()
+{
+    for ( NCursesWindow* p = subwins; p != 0; p = p->sib )
+    {
+	p->syncsubwins();
+
+	if ( p->w != 0 && p->is_wintouched() )
+	{
+	    p->syncup();
+	    p->untouchwin();
+	}
+    }
+}
+
+
 NCursesWindow::~NCursesWindow()
 {
     kill_subwindows();
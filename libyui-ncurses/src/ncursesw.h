@@ -1649,6 +1649,13 @@ public:
     */
     void	   syncup()    { ::wsyncup( w ); }
 
+    /**
+     * Propagate the changes of all descendant windows up to this window and
+     * mark the descendants as unchanged, so that refreshing this window
+     * copies only the changed parts of the subwindows
+    */
+    void	   syncsubwins();
+
     /**
      * Position the cursor in all ancestor windows corresponding to our setting
     */
@@ -18,7 +18,7 @@
 
 
 %define         parent libyui-qt-graph
-%define         so_version 15
+%define         so_version 16
 
 Name:           %{parent}-doc
 
@@ -23,7 +23,7 @@ Name:           libyui-qt-graph
 Version:        4.0.1
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         libyui_devel_version libyui-devel >= 3.9.0
 %define         libyui_qt_devel_version libyui-qt-devel >= 2.52.0
 %define         bin_name %{name}%{so_version}
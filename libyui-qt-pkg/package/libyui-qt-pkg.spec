@@ -23,7 +23,7 @@ Name:           libyui-qt-pkg
 Version:        4.0.1
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         libyui_devel_version libyui-devel >= 3.10.0
 %define         libyui_qt_devel_version libyui-qt-devel >= 2.50.1
 %define         libzypp_devel_version libzypp-devel >= 17.21.0
@@ -23,7 +23,7 @@ Name:           libyui-qt-rest-api
 Version:        4.0.1
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         libyui_devel_version libyui-devel >= 3.10.1
 %define         bin_name %{name}%{so_version}
 
@@ -20,6 +20,7 @@
 #define  YUILogComponent "qt-rest-api"
 #include <yui/YUILog.h>
 
+#include <yui/YDialog.h>
 #include <yui/rest-api/YHttpServer.h>
 
 #include "YQHttpUI.h"
@@ -51,6 +52,7 @@ void YQHttpUI::initUI()
     YQHttpUISignalReceiver *receiver = new YQHttpUISignalReceiver();
     // handle the HTTP REST API events
     receiver->createHttpNotifiers();
+    qApp->installEventFilter( receiver );
 
     _signalReceiver = receiver;
     _busyCursorTimer = new QTimer( _signalReceiver );
@@ -103,6 +105,29 @@ YQHttpUISignalReceiver::httpData()
     createHttpNotifiers();
 }
 
+bool YQHttpUISignalReceiver::eventFilter( QObject * obj, QEvent * event )
+{
+    switch ( event->type() )
+    {
+        // A widget changed and requested a repaint of its window,
+        // no matter if by user input or by the application
+        case QEvent::UpdateRequest:
+        {
+            YDialog * dialog = YDialog::topmostDialog( false );
+
+            if ( dialog )
+                dialog->contentChanged();
+
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return YQUISignalReceiver::eventFilter( obj, event );
+}
+
 void YQHttpUISignalReceiver::clearHttpNotifiers() {
     yuiDebug() << "Clearing HTTP notifiers..." << std::endl;
 
@@ -81,6 +81,13 @@ public:
     void clearHttpNotifiers();
     void createHttpNotifiers();
 
+    /**
+     * Watch the repaints of the whole application: A window is only
+     * repainted if a widget changed, so the cached REST API snapshots of the
+     * topmost dialog are outdated.
+     **/
+    virtual bool eventFilter( QObject * obj, QEvent * event );
+
 private:
     std::vector<QSocketNotifier*>  _http_notifiers;
 };
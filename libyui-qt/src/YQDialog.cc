@@ -172,6 +172,10 @@ YQDialog::chooseParent( YDialogType dialogType )
 void
 YQDialog::openInternal()
 {
+    // Events left over from the previous dialog must not be returned for
+    // this one
+    YQUI::ui()->discardEventsOfOtherDialogs( this );
+
     ensureOnlyOneDefaultButton();
     QWidget::show();
     QWidget::raise(); // FIXME: is this really necessary?
@@ -764,6 +768,7 @@ YEvent *
 YQDialog::waitForEventInternal( int timeout_millisec )
 {
     YQUI::ui()->forceUnblockEvents();
+    YQUI::ui()->discardEventsOfOtherDialogs( this );
     _eventLoop->wakeUp();
 
     YEvent * event  = 0;
@@ -818,6 +823,7 @@ YQDialog::pollEventInternal()
     YEvent * event = 0;
 
     _waitForEventTimer->stop(); // just in case it's still running
+    YQUI::ui()->discardEventsOfOtherDialogs( this );
 
     if ( ! YQUI::ui()->pendingEvent() )
     {
@@ -358,19 +358,16 @@ void YQSelectionBox::slotActivated( QListWidgetItem * qItem )
 
 void YQSelectionBox::returnImmediately()
 {
-    if ( YQUI::ui()->eventPendingFor( this ) )
-    {
-	YWidgetEvent * event = dynamic_cast<YWidgetEvent *> ( YQUI::ui()->pendingEvent() );
+    YWidgetEvent * event = YQUI::ui()->pendingEventFor( this );
 
-	if ( event && event->reason() != YEvent::SelectionChanged )
-	{
-	    // Avoid overwriting a (more important) Activated event with a
-	    // SelectionChanged event
+    if ( event && event->reason() != YEvent::SelectionChanged )
+    {
+	// Avoid overwriting a (more important) Activated event with a
+	// SelectionChanged event
 
-	    yuiDebug() << "Not overwriting more important event" << endl;
+	yuiDebug() << "Not overwriting more important event" << endl;
 
-	    return;
-	}
+	return;
     }
 
 
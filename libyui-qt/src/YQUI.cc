@@ -112,6 +112,7 @@ YQUI::YQUI( bool withThreads,  bool topmostConstructor )
     _fullscreen			= false;
     _noborder			= false;
     _blockedLevel		= 0;
+    _eventsDialog		= 0;
 
     qInstallMessageHandler( qMessageHandler );
     yuiDebug() << "YQUI constructor finished" << endl;
@@ -452,6 +453,7 @@ void YQUI::sendEvent( YEvent * event )
     {
 	_eventHandler.sendEvent( event );
 	YQDialog * dialog = (YQDialog *) YDialog::currentDialog( false ); // don't throw
+	_eventsDialog = dialog;
 
 	if ( dialog )
 	{
@@ -466,6 +468,20 @@ void YQUI::sendEvent( YEvent * event )
 }
 
 
+void YQUI::discardEventsOfOtherDialogs( YDialog * dialog )
+{
+    if ( _eventsDialog != dialog && _eventHandler.pendingEventsCount() > 0 )
+    {
+	yuiDebug() << "Discarding " << _eventHandler.pendingEventsCount()
+		   << " events of another dialog" << endl;
+
+	_eventHandler.clear();
+    }
+
+    _eventsDialog = dialog;
+}
+
+
 void YQUI::setTextdomain( const char * domain )
 {
     bindtextdomain( domain, YSettings::localeDir().c_str() );
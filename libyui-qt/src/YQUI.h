@@ -33,7 +33,7 @@
 #include <type_traits>
 
 #include <yui/YUI.h>
-#include <yui/YSimpleEventHandler.h>
+#include <yui/YEventQueue.h>
 #include <yui/YCommandLine.h>
 
 #define YQWidgetMargin	4
@@ -143,19 +143,36 @@ public:
 	{ return _eventHandler.eventPendingFor( widget ); }
 
     /**
-     * Returns the last event that isn't processed yet or 0 if there is none.
+     * Returns the newest event that isn't processed yet for the specified
+     * widget or 0 if there is none.
+     **/
+    YWidgetEvent * pendingEventFor( YWidget * widget ) const
+	{ return _eventHandler.pendingEventFor( widget ); }
+
+    /**
+     * Returns the oldest event that isn't processed yet or 0 if there is none.
      *
-     * The Qt UI keeps track of only one single (the last one) event.
+     * The Qt UI keeps several events; this one may belong to any widget.
+     * Use pendingEventFor() to check the events of one widget.
      **/
     YEvent * pendingEvent() const { return _eventHandler.pendingEvent(); }
 
     /**
-     * Return the pending event, if there is one, and mark it as "consumed".
+     * Return the oldest pending event, if there is one, and mark it as
+     * "consumed".
      *
      * This returns 0 if there is no pending event.
      **/
     YEvent * consumePendingEvent() { return _eventHandler.consumePendingEvent(); }
 
+    /**
+     * Delete the pending events if they were sent while another dialog than
+     * 'dialog' was the current one, e.g. the events left over from a popup
+     * dialog that was closed meanwhile. This is called when 'dialog' is
+     * opened and before it waits for events.
+     **/
+    void discardEventsOfOtherDialogs( YDialog * dialog );
+
     /**
      * Notification that a widget is being deleted.
      *
@@ -365,7 +382,8 @@ protected:
 
     QTimer * 		_busyCursorTimer;
 
-    YSimpleEventHandler _eventHandler;
+    YEventQueue		_eventHandler;
+    YDialog *		_eventsDialog;	// the current dialog of the last sendEvent()
     int 		_blockedLevel;
 
     bool 		_leftHandedMouse;
@@ -0,0 +1,234 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+/*
+ * Micro benchmark for the dialog snapshots of the REST API without any UI
+ * and without a HTTP server: A dialog with a large table serialized with
+ * YJsonWriter (via YJsonSerializer) and sent through the snapshot cache
+ * and ETag path of the "/dialog" handler.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include <yui/YDialog.h>
+#include <yui/YTable.h>
+#include <yui/YTableHeader.h>
+#include <yui/YTableItem.h>
+
+#include "YHttpDialogHandler.h"
+#include "YJsonSerializer.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations(0);
+
+void * operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (void * ptr = malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+    free(ptr);
+}
+
+
+/**
+ * A dialog without a UI. It is never opened.
+ *
+ * The widgets are never deleted: The YWidget destructor needs a loaded UI
+ * (YUI::ui()->deleteNotify()).
+ **/
+class BenchmarkDialog : public YDialog
+{
+public:
+
+    BenchmarkDialog() : YDialog(YMainDialog, YDialogNormalColor) {}
+
+    virtual void setSize(int, int) {}
+    virtual void activate() {}
+
+protected:
+
+    virtual void openInternal() {}
+    virtual YEvent * waitForEventInternal(int) { return 0; }
+    virtual YEvent * pollEventInternal() { return 0; }
+};
+
+
+/**
+ * A table without a UI.
+ **/
+class BenchmarkTable : public YTable
+{
+public:
+
+    BenchmarkTable(YWidget * parent, YTableHeader * header)
+        : YTable(parent, header, false) {}
+
+    virtual int preferredWidth() { return 1; }
+    virtual int preferredHeight() { return 1; }
+    virtual void setSize(int, int) {}
+    virtual void cellChanged(const YTableCell *) {}
+};
+
+
+/**
+ * The "/dialog" handler with its snapshot cache made accessible.
+ **/
+class BenchmarkHandler : public YHttpDialogHandler
+{
+public:
+
+    const std::string & cached_body(YDialog * dialog)
+    {
+        // the dialog handler does not use the connection
+        return *snapshot(dialog, nullptr).body;
+    }
+
+    using YHttpSnapshotHandler::etag;
+};
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ **/
+static void measure(const char * name, int count, std::function<void(int)> op)
+{
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < count; ++i)
+        op(i);
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    allocs = allocations - allocs;
+
+    printf("%-28s %6d %14.2f %12.1f\n", name, count,
+        std::chrono::duration<double, std::micro>(time).count() / count,
+        double(allocs) / count);
+}
+
+
+static void usage(const char * prog)
+{
+    fprintf(stderr, "Usage: %s [--rows N]\n", prog);
+    exit(1);
+}
+
+
+int main(int argc, char ** argv)
+{
+    int row_count = 50000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--rows" && i + 1 < argc)
+            row_count = atoi(argv[++i]);
+        else
+            usage(argv[0]);
+    }
+
+    if (row_count <= 0)
+        usage(argv[0]);
+
+    YTableHeader * header = new YTableHeader();
+    header->addColumn("Name");
+    header->addColumn("Version");
+    header->addColumn("Summary");
+
+    BenchmarkDialog * dialog = new BenchmarkDialog();
+    BenchmarkTable * table = new BenchmarkTable(dialog, header);
+
+    YItemCollection items;
+    items.reserve(row_count);
+
+    for (int i = 0; i < row_count; i++)
+    {
+        std::string name = "package-" + std::to_string(i);
+        items.push_back(new YTableItem(name, "1.0." + std::to_string(i % 100),
+            "The \"" + name + "\" package"));
+    }
+
+    table->addItems(items);
+
+    BenchmarkHandler handler;
+    std::string body;
+
+    printf("%d rows\n\n", row_count);
+    printf("%-28s %6s %14s %12s\n", "Operation", "Count", "usec/op", "allocs/op");
+
+    measure("serialize to string", 10, [&](int)
+    {
+        body.clear();
+        YJsonSerializer::serialize(dialog, body);
+    });
+
+    measure("serialize to stream", 10, [&](int)
+    {
+        std::ostringstream stream;
+        YJsonSerializer::serialize(dialog, stream);
+    });
+
+    // A new revision invalidates the cache: The snapshot is written again
+    measure("snapshot, changed dialog", 10, [&](int)
+    {
+        dialog->contentChanged();
+        handler.cached_body(dialog);
+    });
+
+    // A client polling an unchanged dialog gets the cached snapshot
+    measure("snapshot, unchanged dialog", 10000, [&](int) { handler.cached_body(dialog); });
+
+    // ...or just revalidates it with its ETag ("304 Not Modified")
+    std::string tag;
+    measure("etag", 10000, [&](int) { tag = handler.etag(dialog); });
+
+    const std::string & cached = handler.cached_body(dialog);
+
+    if (cached != body || cached.find("package-" + std::to_string(row_count - 1)) == std::string::npos)
+    {
+        fprintf(stderr, "The snapshot does not contain the table\n");
+        return 1;
+    }
+
+    printf("\nsnapshot size: %zu bytes, ETag: %s\n", cached.size(), tag.c_str());
+
+    return 0;
+}
@@ -22,7 +22,7 @@ Name:           libyui-rest-api
 Version:        4.0.0
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         bin_name %{name}%{so_version}
 %define         libyui_devel_version libyui-devel >= 3.10.1
 
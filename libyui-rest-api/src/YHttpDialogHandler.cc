@@ -21,17 +21,15 @@
 #include "YHttpDialogHandler.h"
 
 
-void YHttpDialogHandler::process_request(struct MHD_Connection* connection,
-    const char* url, const char* method, const char* upload_data,
-    size_t* upload_data_size, std::ostream& body, int& error_code,
-    std::string& content_type, bool *redraw)
+void YHttpDialogHandler::process_snapshot(struct MHD_Connection* connection,
+    std::string& body, int& error_code, std::string& content_type)
 {
     if (auto dialog = YDialog::topmostDialog(false))  {
         YJsonSerializer::serialize(dialog, body);
         error_code = MHD_HTTP_OK;
     }
     else {
-        body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
+        body += "{ \"error\" : \"No dialog is open\" }\n";
         error_code = MHD_HTTP_NOT_FOUND;
     }
 
@@ -17,9 +17,9 @@
 #ifndef YHttpDialogHandler_h
 #define YHttpDialogHandler_h
 
-#include "YHttpHandler.h"
+#include "YHttpSnapshotHandler.h"
 
-class YHttpDialogHandler : public YHttpHandler
+class YHttpDialogHandler : public YHttpSnapshotHandler
 {
 
 public:
@@ -29,10 +29,8 @@ public:
 
 protected:
 
-    virtual void process_request(struct MHD_Connection* connection,
-        const char* url, const char* method, const char* upload_data,
-        size_t* upload_data_size, std::ostream& body, int& error_code,
-        std::string& content_type, bool *redraw);
+    virtual void process_snapshot(struct MHD_Connection* connection,
+        std::string& body, int& error_code, std::string& content_type);
 
 };
 
@@ -0,0 +1,231 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <json/json.h>
+#include <microhttpd.h>
+#include <sstream>
+
+#define YUILogComponent "rest-api"
+#include <yui/YUILog.h>
+
+#include <yui/YDialog.h>
+#include <yui/YEvent.h>
+#include <yui/YWidgetID.h>
+
+#include "YJsonSerializer.h"
+#include "YHttpEventsHandler.h"
+
+// keep only the last notifications, a client which is too late
+// has to read the whole dialog again
+static const size_t max_notifications = 256;
+
+
+YHttpEventsHandler::YHttpEventsHandler()
+    : _last_id(0), _sent_id(0), _since(0)
+{
+}
+
+MHD_RESULT YHttpEventsHandler::handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw)
+{
+    auto resumed = std::find_if(_resumed.begin(), _resumed.end(),
+        [connection](const Requests::value_type &r) { return r.first == connection; });
+
+    if (resumed != _resumed.end())
+    {
+        // answer with the notifications received while waiting
+        _since = resumed->second;
+        _resumed.erase(resumed);
+    }
+    else
+    {
+        _since = _last_id;
+
+        if (const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "since"))
+            _since = strtoul(val, nullptr, 10);
+
+        if (_since == _last_id)
+        {
+            // nothing new, wait for the next notification
+            yuiDebug() << "Suspending the events request" << std::endl;
+            MHD_suspend_connection(connection);
+            _suspended.push_back(std::make_pair(connection, _since));
+            return MHD_YES;
+        }
+    }
+
+    return YHttpHandler::handle(connection, url, method, upload_data, upload_data_size, redraw);
+}
+
+void YHttpEventsHandler::process_request(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, std::ostream& body, int& error_code,
+    std::string& content_type, bool *redraw)
+{
+    unsigned long since = _since;
+    Json::Value response;
+    Json::Value notifications(Json::arrayValue);
+
+    response["last_id"] = (Json::Value::UInt64) _last_id;
+
+    // some notifications have been dropped already
+    // or the client has seen another instance of the application
+    if (since > _last_id || (!_notifications.empty() && since + 1 < _notifications.front().id))
+    {
+        response["missed"] = true;
+        since = 0;
+    }
+
+    for (const Notification &n: _notifications)
+    {
+        if (n.id <= since)
+            continue;
+
+        Json::Value json;
+        json["id"] = (Json::Value::UInt64) n.id;
+        json["type"] = n.type;
+        json["dialog_revision"] = (Json::Value::UInt64) n.dialog_revision;
+
+        if (!n.event_type.empty())
+            json["event_type"] = n.event_type;
+
+        if (!n.reason.empty())
+            json["reason"] = n.reason;
+
+        if (!n.widget_id.empty())
+            json["widget_id"] = n.widget_id;
+
+        if (!n.widget_class.empty())
+            json["widget_class"] = n.widget_class;
+
+        if (!n.key_symbol.empty())
+            json["key_symbol"] = n.key_symbol;
+
+        if (n.type == "changed")
+        {
+            Json::Value widgets(Json::arrayValue);
+
+            for (const std::string &id: n.widgets)
+                widgets.append(id);
+
+            json["widgets"] = widgets;
+            json["any_widget"] = n.any_widget;
+        }
+
+        notifications.append(json);
+    }
+
+    response["notifications"] = notifications;
+    _sent_id = _last_id;
+
+    YJsonSerializer::save(response, body);
+    error_code = MHD_HTTP_OK;
+    content_type = "application/json";
+}
+
+void YHttpEventsHandler::resume_all()
+{
+    if (_suspended.empty())
+        return;
+
+    yuiDebug() << "Resuming " << _suspended.size() << " events requests" << std::endl;
+
+    // the not handled connections from the last time have been closed
+    _resumed.clear();
+
+    for (const Requests::value_type &request: _suspended)
+    {
+        MHD_resume_connection(request.first);
+        _resumed.push_back(request);
+    }
+
+    _suspended.clear();
+}
+
+YHttpEventsHandler::Notification & YHttpEventsHandler::add(const std::string &type,
+    YDialog * dialog, unsigned long dialog_revision)
+{
+    if (_notifications.size() >= max_notifications)
+        _notifications.pop_front();
+
+    Notification n;
+    n.id = ++_last_id;
+    n.type = type;
+    n.dialog = dialog;
+    n.dialog_revision = dialog_revision;
+    n.any_widget = false;
+    _notifications.push_back(n);
+
+    resume_all();
+
+    return _notifications.back();
+}
+
+void YHttpEventsHandler::dialogOpened( YDialog * dialog )
+{
+    add("dialog_opened", dialog, dialog->revision());
+}
+
+void YHttpEventsHandler::dialogClosed( YDialog * dialog )
+{
+    // the dialog is already destroyed
+    add("dialog_closed", dialog, 0);
+}
+
+void YHttpEventsHandler::eventReturned( YDialog * dialog, const YEvent * event )
+{
+    Notification & n = add("event", dialog, dialog->revision());
+    n.event_type = YEvent::toString(event->eventType());
+
+    if (auto widget_event = dynamic_cast<const YWidgetEvent*>(event))
+        n.reason = YEvent::toString(widget_event->reason());
+
+    if (auto key_event = dynamic_cast<const YKeyEvent*>(event))
+        n.key_symbol = key_event->keySymbol();
+
+    if (YWidget * widget = event->widget())
+    {
+        n.widget_class = widget->widgetClass();
+
+        if (widget->hasId())
+            n.widget_id = widget->id()->toString();
+    }
+}
+
+void YHttpEventsHandler::dialogChanged( YDialog * dialog, YWidget * widget )
+{
+    Notification * n;
+
+    // merge with the last change if no client has seen it yet
+    if (!_notifications.empty() && _notifications.back().type == "changed"
+        && _notifications.back().dialog == dialog && _notifications.back().id > _sent_id)
+    {
+        n = &_notifications.back();
+        n->dialog_revision = dialog->revision();
+    }
+    else
+    {
+        n = &add("changed", dialog, dialog->revision());
+    }
+
+    if (widget && widget->hasId())
+        n->widgets.insert(widget->id()->toString());
+    else
+        n->any_widget = true;
+}
@@ -0,0 +1,107 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YHttpEventsHandler_h
+#define YHttpEventsHandler_h
+
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <yui/YDialogObserver.h>
+
+#include "YHttpHandler.h"
+
+/**
+ * Long polling handler for the UI notifications: The events returned to the
+ * application, opened and closed dialogs and dialog changes. Each
+ * notification has an increasing ID, a request returns the notifications
+ * after the "since" ID. If there are none yet the request is suspended
+ * until the next notification.
+ **/
+class YHttpEventsHandler : public YHttpHandler, public YDialogObserver
+{
+
+public:
+
+    YHttpEventsHandler();
+    virtual ~YHttpEventsHandler() {}
+
+    virtual MHD_RESULT handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw = nullptr);
+
+    /**
+     * Answer all suspended requests (with the new notifications if there
+     * are any).
+     **/
+    void resume_all();
+
+    // YDialogObserver
+    virtual void dialogOpened( YDialog * dialog );
+    virtual void dialogClosed( YDialog * dialog );
+    virtual void eventReturned( YDialog * dialog, const YEvent * event );
+    virtual void dialogChanged( YDialog * dialog, YWidget * widget );
+
+protected:
+
+    virtual void process_request(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, std::ostream& body, int& error_code,
+        std::string& content_type, bool *redraw);
+
+private:
+
+    struct Notification
+    {
+        unsigned long id;
+        std::string type;
+        YDialog * dialog;
+        unsigned long dialog_revision;
+
+        // for the events
+        std::string event_type;
+        std::string reason;
+        std::string widget_id;
+        std::string widget_class;
+        std::string key_symbol;
+
+        // for the dialog changes: the IDs of the changed widgets,
+        // 'any_widget' if a widget without an ID has changed, too
+        std::set<std::string> widgets;
+        bool any_widget;
+    };
+
+    Notification & add(const std::string &type, YDialog * dialog, unsigned long dialog_revision);
+
+    // the last notifications, the oldest first
+    std::deque<Notification> _notifications;
+    unsigned long _last_id;
+
+    // the highest ID sent to a client, older notifications are not changed
+    unsigned long _sent_id;
+
+    // the waiting requests with their "since" ID
+    typedef std::vector<std::pair<struct MHD_Connection*, unsigned long>> Requests;
+    Requests _suspended;
+    Requests _resumed;
+
+    // the "since" ID of the currently processed request
+    unsigned long _since;
+};
+
+#endif // YHttpEventsHandler_h
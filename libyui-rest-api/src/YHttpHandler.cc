@@ -36,14 +36,37 @@ MHD_RESULT YHttpHandler::handle(struct MHD_Connection* connection,
     process_request(connection, url, method, upload_data, upload_data_size,
       body_s, error_code, content_type, redraw);
 
-    std::string body_str = body_s.str();
-    struct MHD_Response *response = MHD_create_response_from_buffer (body_str.length(),
-		      (void *) body_str.c_str(), MHD_RESPMEM_MUST_COPY);
+    return send_response(connection, std::make_shared<const std::string>(body_s.str()),
+        error_code, content_type);
+}
+
+#if MHD_VERSION >= 0x00097302
+static void release_body(void *cls)
+{
+    delete static_cast<std::shared_ptr<const std::string> *>(cls);
+}
+#endif
+
+MHD_RESULT YHttpHandler::send_response(struct MHD_Connection* connection,
+        const std::shared_ptr<const std::string>& body, int error_code,
+        const std::string& content_type, const std::string& etag)
+{
+#if MHD_VERSION >= 0x00097302
+    // keep a reference to the body until the response is destroyed
+    struct MHD_Response *response = MHD_create_response_from_buffer_with_free_callback_cls(
+        body->length(), body->data(), release_body, new std::shared_ptr<const std::string>(body));
+#else
+    struct MHD_Response *response = MHD_create_response_from_buffer (body->length(),
+		      (void *) body->data(), MHD_RESPMEM_MUST_COPY);
+#endif
 
     if (!content_type.empty())
         MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, content_type.c_str());
 
-    yuiMilestone() << "Sending response: code: " << error_code << ", body size: " << body_str.length()
+    if (!etag.empty())
+        MHD_add_response_header(response, MHD_HTTP_HEADER_ETAG, etag.c_str());
+
+    yuiMilestone() << "Sending response: code: " << error_code << ", body size: " << body->length()
       << ", content type: " << content_type << std::endl;
 
     MHD_RESULT ret = MHD_queue_response(connection, error_code, response);
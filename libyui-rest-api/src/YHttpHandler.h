@@ -33,6 +33,7 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 
 struct MHD_Connection;
 
@@ -57,6 +58,15 @@ protected:
         std::string& content_type, bool *redraw) = 0;
 
     int handle_error(std::ostream& body, std::string error, int error_code);
+
+    /**
+     * Queue the response. The body is not copied, it is referenced until
+     * it has been sent (with libmicrohttpd >= 0.9.73). A non-empty 'etag'
+     * is sent in the ETag header.
+     **/
+    MHD_RESULT send_response(struct MHD_Connection* connection,
+        const std::shared_ptr<const std::string>& body, int error_code,
+        const std::string& content_type, const std::string& etag = std::string());
 };
 
 #endif // YHttpHandler_h
@@ -42,6 +42,11 @@
 #include "YHttpServer.h"
 
 
+// older libmicrohttpd versions
+#ifndef MHD_ALLOW_SUSPEND_RESUME
+#define MHD_ALLOW_SUSPEND_RESUME MHD_USE_SUSPEND_RESUME
+#endif
+
 YHttpServer * YHttpServer::_yserver = 0;
 YHttpWidgetsActionHandler * YHttpServer::_widget_action_handler = 0;
 
@@ -94,7 +99,7 @@ struct in6_addr listen_address_v6(bool remote)
 }
 
 YHttpServer::YHttpServer(YHttpWidgetsActionHandler * widgets_action_handler)
-    : server_v4(nullptr), server_v6(nullptr), redraw(false)
+    : server_v4(nullptr), server_v6(nullptr), redraw(false), _events_handler(nullptr)
 {
     _yserver = this;
     _widget_action_handler = widgets_action_handler;
@@ -124,6 +129,12 @@ YHttpServer::~YHttpServer()
 {
     yuiMilestone() << "Finishing the REST API HTTP server..." << std::endl;
 
+    // the daemons cannot be stopped with suspended requests
+    if (_events_handler) {
+        _events_handler->resume_all();
+        process_data();
+    }
+
     if (server_v4) {
         yuiMilestone() << "Stopping IPv4 HTTP server" << std::endl;
         MHD_stop_daemon(server_v4);
@@ -181,7 +192,18 @@ MHD_RESULT YHttpServer::handle(struct MHD_Connection* connection,
     for(YHttpMount m: _mounts)
     {
         if (m.handles(url, method))
-            return m.handler()->handle(connection, url, method, upload_data, upload_data_size, &redraw);
+        {
+            MHD_RESULT ret = m.handler()->handle(connection, url, method, upload_data, upload_data_size, &redraw);
+
+            // an action might have changed the dialog content
+            if (strcmp(method, MHD_HTTP_METHOD_GET) != 0)
+            {
+                if (YDialog *dialog = YDialog::topmostDialog(false))
+                    dialog->contentChanged();
+            }
+
+            return ret;
+        }
     }
 
     // if not found create an empty 404 error response
@@ -214,18 +236,28 @@ requestHandler(void *srv,
           const char *version,
           const char *upload_data, size_t *upload_data_size, void **ptr)
 {
-    // remember the callback status
-    static int aptr;
-
-    if (&aptr != *ptr)
+    if (!*ptr)
     {
-        // do not respond on first call, it's used for the initial check to close invalid requests early
-        *ptr = &aptr;
+        // do not respond on first call, it's used for the initial check to close invalid requests early,
+        // remember the uploaded data until the request is complete
+        *ptr = new std::string();
         // continue processing the request
         return MHD_YES;
     }
-    // reset
-    *ptr = NULL;
+
+    std::string *upload = static_cast<std::string *>(*ptr);
+
+    if (*upload_data_size != 0)
+    {
+        upload->append(upload_data, *upload_data_size);
+        *upload_data_size = 0;
+        return MHD_YES;
+    }
+
+    // the request is complete, the uploaded data is released in requestCompleted()
+    size_t upload_size = upload->size();
+    upload_data = upload->c_str();
+    upload_data_size = &upload_size;
 
     YHttpServer *server = (YHttpServer *)srv;
 
@@ -241,6 +273,14 @@ requestHandler(void *srv,
     return server->handle(connection, url, method, upload_data, upload_data_size);
 }
 
+// callback called when a request is finished (also when it failed)
+static void requestCompleted(void *srv, struct MHD_Connection *connection,
+    void **ptr, enum MHD_RequestTerminationCode toe)
+{
+    delete static_cast<std::string *>(*ptr);
+    *ptr = NULL;
+}
+
 // callback called when a new client connects to the HTTP server,
 // could be used for access control, we just use it for access logging
 static MHD_RESULT onConnect(void *srv, const struct sockaddr *addr, socklen_t addrlen) {
@@ -270,6 +310,9 @@ void YHttpServer::start()
     mount("/dialog", "GET", new YHttpDialogHandler());
     mount("/widgets", "GET", new YHttpWidgetsHandler());
     mount("/widgets", "POST", get_widget_action_handler());
+    mount("/widgets/batch", "POST", get_widget_action_handler());
+    _events_handler = new YHttpEventsHandler();
+    mount("/events", "GET", _events_handler);
     mount("/application", "GET", new YHttpAppHandler());
     mount("/version", "GET", new YHttpVersionHandler(), false);
 
@@ -282,7 +325,9 @@ void YHttpServer::start()
     server_socket.sin_addr.s_addr = listen_address_v4(remote);
     server_v4 = MHD_start_daemon (
                         // enable debugging output (on STDERR)
-                        MHD_USE_DEBUG,
+                        MHD_USE_DEBUG |
+                        // allow suspending the events requests
+                        MHD_ALLOW_SUSPEND_RESUME,
                         // the port number to use
                         port_num(),
                         // handler for new connections
@@ -293,6 +338,8 @@ void YHttpServer::start()
                         MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
                         // set the port and interface to listen to
                         MHD_OPTION_SOCK_ADDR, &server_socket,
+                        // release the uploaded data
+                        MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
                         // finish the argument list
                         MHD_OPTION_END);
 
@@ -304,6 +351,8 @@ void YHttpServer::start()
     server_v6 = MHD_start_daemon (
                         // enable debugging output (on STDERR)
                         MHD_USE_DEBUG |
+                        // allow suspending the events requests
+                        MHD_ALLOW_SUSPEND_RESUME |
                         // use IPv6
                         MHD_USE_IPv6,
                         // the port number to use
@@ -317,6 +366,8 @@ void YHttpServer::start()
                         MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
                         // set the port and interface to listen to
                         MHD_OPTION_SOCK_ADDR, &server_socket_v6,
+                        // release the uploaded data
+                        MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
                         // finish the argument list
                         MHD_OPTION_END);
 
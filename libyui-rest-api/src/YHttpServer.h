@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 
+#include "YHttpEventsHandler.h"
 #include "YHttpMount.h"
 #include "YHttpHandler.h"
 #include "YHttpServerSockets.h"
@@ -100,6 +101,7 @@ private:
     bool redraw;
     static YHttpServer * _yserver;
     static YHttpWidgetsActionHandler * _widget_action_handler;
+    YHttpEventsHandler * _events_handler;
     // HTTP Basic Auth credentials
     std::string auth_user;
     std::string auth_passwd;
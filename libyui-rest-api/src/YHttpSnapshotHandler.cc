@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <cstring>
+#include <microhttpd.h>
+#include <unistd.h>
+
+#define YUILogComponent "rest-api"
+#include <yui/YUILog.h>
+#include <yui/YDialog.h>
+
+#include "YHttpSnapshotHandler.h"
+
+// keep only a few different requests (queries) per revision
+static const size_t max_snapshots = 32;
+
+
+MHD_RESULT YHttpSnapshotHandler::handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw)
+{
+    YDialog *dialog = YDialog::topmostDialog(false);
+
+    // nothing to cache
+    if (!dialog)
+    {
+        std::shared_ptr<std::string> body = std::make_shared<std::string>();
+        std::string content_type;
+        int error_code;
+
+        process_snapshot(connection, *body, error_code, content_type);
+        return send_response(connection, body, error_code, content_type);
+    }
+
+    std::string tag = etag(dialog);
+    const char *if_none_match = MHD_lookup_connection_value(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+    const Snapshot &snap = snapshot(dialog, connection);
+
+    if (snap.error_code != MHD_HTTP_OK)
+        return send_response(connection, snap.body, snap.error_code, snap.content_type);
+
+    if (if_none_match && strstr(if_none_match, tag.c_str()))
+    {
+        static const std::shared_ptr<const std::string> empty = std::make_shared<const std::string>();
+        return send_response(connection, empty, MHD_HTTP_NOT_MODIFIED, std::string(), tag);
+    }
+
+    return send_response(connection, snap.body, snap.error_code, snap.content_type, tag);
+}
+
+std::string YHttpSnapshotHandler::etag(YDialog *dialog)
+{
+    // the PID distinguishes the revisions of a restarted application
+    return "\"" + std::to_string(getpid()) + "-" + std::to_string(dialog->revision()) + "\"";
+}
+
+const YHttpSnapshotHandler::Snapshot& YHttpSnapshotHandler::snapshot(YDialog *dialog, struct MHD_Connection* connection)
+{
+    if (_revision != dialog->revision())
+    {
+        _snapshots.clear();
+        _revision = dialog->revision();
+    }
+
+    std::string key = snapshot_key(connection);
+    auto it = _snapshots.find(key);
+
+    if (it == _snapshots.end())
+    {
+        std::shared_ptr<std::string> body = std::make_shared<std::string>();
+        std::string content_type;
+        int error_code;
+
+        body->reserve(_last_size);
+        process_snapshot(connection, *body, error_code, content_type);
+        _last_size = body->size();
+
+        if (_snapshots.size() >= max_snapshots)
+            _snapshots.clear();
+
+        it = _snapshots.emplace(key, Snapshot{ body, error_code, content_type }).first;
+    }
+    else
+    {
+        yuiDebug() << "Using the cached snapshot, revision " << _revision << std::endl;
+    }
+
+    return it->second;
+}
+
+void YHttpSnapshotHandler::process_request(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, std::ostream& body, int& error_code,
+    std::string& content_type, bool *redraw)
+{
+    std::string snapshot;
+    process_snapshot(connection, snapshot, error_code, content_type);
+    body << snapshot;
+}
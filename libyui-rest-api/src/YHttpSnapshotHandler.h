@@ -0,0 +1,93 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YHttpSnapshotHandler_h
+#define YHttpSnapshotHandler_h
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "YHttpHandler.h"
+
+class YDialog;
+
+/**
+ * Base class for the handlers which return a snapshot of the topmost
+ * dialog. The responses are cached until the revision of the dialog
+ * changes and they are sent with an ETag so a client can revalidate
+ * an unchanged snapshot with "If-None-Match" (answered with 304).
+ **/
+class YHttpSnapshotHandler : public YHttpHandler
+{
+
+public:
+
+    YHttpSnapshotHandler() : _revision(0), _last_size(0) {}
+    virtual ~YHttpSnapshotHandler() {}
+
+    virtual MHD_RESULT handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw = nullptr);
+
+protected:
+
+    struct Snapshot
+    {
+        std::shared_ptr<const std::string> body;
+        int error_code;
+        std::string content_type;
+    };
+
+    /**
+     * Return the snapshot of the current revision of 'dialog' for this
+     * request. It is only written if there is none in the cache yet.
+     **/
+    const Snapshot& snapshot(YDialog* dialog, struct MHD_Connection* connection);
+
+    /**
+     * Return the ETag of the current revision of 'dialog'.
+     **/
+    static std::string etag(YDialog* dialog);
+
+    /**
+     * Write the snapshot to 'body' (which is empty), like process_request().
+     **/
+    virtual void process_snapshot(struct MHD_Connection* connection,
+        std::string& body, int& error_code, std::string& content_type) = 0;
+
+    /**
+     * The key for caching the snapshot of this request, different requests
+     * returning different data must have different keys.
+     **/
+    virtual std::string snapshot_key(struct MHD_Connection* connection) { return std::string(); }
+
+    virtual void process_request(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, std::ostream& body, int& error_code,
+        std::string& content_type, bool *redraw);
+
+private:
+
+    // the revision of the cached snapshots
+    unsigned long _revision;
+    std::map<std::string, Snapshot> _snapshots;
+
+    // the size of the last snapshot, used to reserve the next buffer
+    size_t _last_size;
+};
+
+#endif // YHttpSnapshotHandler_h
@@ -15,6 +15,7 @@
 */
 
 #include <codecvt>
+#include <json/json.h>
 #include <vector>
 #include <sstream>
 #include <cstdlib>
@@ -37,8 +38,30 @@
 #include <yui/YTree.h>
 #include <yui/YTreeItem.h>
 #include <yui/YWidgetID.h>
+#include <yui/YWidget_OptimizeChanges.h>
 
 #include "YHttpWidgetsActionHandler.h"
+#include "YJsonSerializer.h"
+
+
+// returns nullptr if the parameter is missing
+static const char* action_param(const YHttpWidgetsActionHandler::ActionParams &params, const char* name)
+{
+    auto it = params.find(name);
+    return it == params.end() ? nullptr : it->second.c_str();
+}
+
+// Store a string (or a number, if 'numeric') from a batch step in 'result';
+// returns false for other types, asString() would throw for them
+static bool step_param(const Json::Value &value, bool numeric, std::string &result)
+{
+    if ( !value.isString() && !( numeric && value.isNumeric() ) )
+        return false;
+
+    result = value.asString();
+    return true;
+}
+
 
 
 void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connection,
@@ -46,7 +69,12 @@ void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connectio
     size_t* upload_data_size, std::ostream& body, int& error_code,
     std::string& content_type, bool *redraw)
 {
-    if ( YDialog::topmostDialog(false) )
+    if ( YDialog::topmostDialog(false) && boost::algorithm::ends_with( url, "/batch" ) )
+    {
+        content_type = "application/json";
+        process_batch( upload_data, *upload_data_size, body, error_code, redraw );
+    }
+    else if ( YDialog::topmostDialog(false) )
     {
         WidgetArray widgets;
 
@@ -83,7 +111,15 @@ void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connectio
                 return;
             }
 
-            error_code = do_action(widgets[0], action, connection, body);
+            ActionParams params;
+
+            for ( const char* name: { "value", "row", "column" } )
+            {
+                if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, name) )
+                    params[name] = val;
+            }
+
+            error_code = do_action(widgets[0], action, params, body);
 
             // the action possibly changed something in the UI, signalize redraw needed
             if ( redraw && error_code == MHD_HTTP_OK )
@@ -101,7 +137,144 @@ void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connectio
     }
 }
 
-int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &action, struct MHD_Connection *connection, std::ostream& body)
+void YHttpWidgetsActionHandler::process_batch(const char* upload_data, size_t upload_data_size,
+    std::ostream& body, int& error_code, bool *redraw)
+{
+    Json::Value steps;
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    std::string parse_error;
+
+    if ( !reader->parse( upload_data, upload_data + upload_data_size, &steps, &parse_error ) || !steps.isArray() )
+    {
+        std::string error ( "Expected a JSON array of actions" );
+
+        if ( !parse_error.empty() )
+            error.append( ": " ).append( parse_error );
+
+        error_code = handle_error( body, error, MHD_HTTP_BAD_REQUEST );
+        return;
+    }
+
+    yuiMilestone() << "Received a batch of " << steps.size() << " actions" << std::endl;
+
+    Json::Value results(Json::arrayValue);
+    error_code = MHD_HTTP_OK;
+
+    {
+        // update the screen only once after all actions
+        YWidget::OptimizeChanges below( *YDialog::topmostDialog() );
+
+        for ( const Json::Value &step: steps )
+        {
+            std::ostringstream step_body;
+            int step_code = do_batch_step( step, step_body );
+
+            Json::Value result;
+            result["status"] = step_code;
+
+            // pass the error message from the step
+            if ( step_code != MHD_HTTP_OK )
+            {
+                Json::Value step_error;
+                std::string step_str = step_body.str();
+
+                if ( reader->parse( step_str.data(), step_str.data() + step_str.size(), &step_error, nullptr )
+                     && step_error.isObject() && step_error.isMember( "error" ) )
+                {
+                    result["error"] = step_error["error"];
+                }
+            }
+
+            results.append( result );
+
+            // the actions might depend on each other, stop at the first failure
+            if ( step_code != MHD_HTTP_OK )
+            {
+                error_code = step_code;
+                break;
+            }
+        }
+    }
+
+    // the actions possibly changed something in the UI, signalize redraw needed
+    if ( redraw && !results.empty() && results[0]["status"].asInt() == MHD_HTTP_OK )
+        *redraw = true;
+
+    Json::Value response;
+    response["results"] = results;
+    YJsonSerializer::save( response, body );
+}
+
+int YHttpWidgetsActionHandler::do_batch_step(const Json::Value &step, std::ostream& body)
+{
+    if ( !step.isObject() || !step["action"].isString() )
+        return handle_error( body, "Missing action parameter", MHD_HTTP_BAD_REQUEST );
+
+    const Json::Value &selector = step["selector"];
+    std::string criteria[3];
+    const char* label = nullptr;
+    const char* id = nullptr;
+    const char* type = nullptr;
+
+    if ( !selector.isNull() && !selector.isObject() )
+        return handle_error( body, "The selector must be an object", MHD_HTTP_BAD_REQUEST );
+
+    if ( selector.isObject() )
+    {
+        if ( selector.isMember( "label" ) )
+        {
+            if ( !step_param( selector["label"], false, criteria[0] ) )
+                return handle_error( body, "The label must be a string", MHD_HTTP_BAD_REQUEST );
+
+            label = criteria[0].c_str();
+        }
+
+        if ( selector.isMember( "id" ) )
+        {
+            if ( !step_param( selector["id"], true, criteria[1] ) )
+                return handle_error( body, "The id must be a string or a number", MHD_HTTP_BAD_REQUEST );
+
+            id = criteria[1].c_str();
+        }
+
+        if ( selector.isMember( "type" ) )
+        {
+            if ( !step_param( selector["type"], false, criteria[2] ) )
+                return handle_error( body, "The type must be a string", MHD_HTTP_BAD_REQUEST );
+
+            type = criteria[2].c_str();
+        }
+    }
+
+    if ( !label && !id && !type )
+        return handle_error( body, "No search criteria provided", MHD_HTTP_NOT_FOUND );
+
+    WidgetArray widgets = YWidgetFinder::find(label, id, type);
+
+    if ( widgets.empty() )
+        return handle_error( body, "Widget not found", MHD_HTTP_NOT_FOUND );
+
+    if ( widgets.size() != 1 )
+        return handle_error( body, "Multiple widgets found to act on, try using multicriteria search (label+id+type)", MHD_HTTP_NOT_FOUND );
+
+    // the values might be also sent as numbers
+    ActionParams params;
+
+    for ( const char* name: { "value", "row", "column" } )
+    {
+        if ( step.isMember( name ) && !step_param( step[name], true, params[name] ) )
+        {
+            std::string error ( "The " );
+            error.append( name ).append( " must be a string or a number" );
+            return handle_error( body, error, MHD_HTTP_BAD_REQUEST );
+        }
+    }
+
+    return do_action( widgets[0], step["action"].asString(), params, body );
+}
+
+int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &action, const ActionParams &params, std::ostream& body)
 {
 
     // TODO improve this, maybe use better names for the actions...
@@ -149,7 +322,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = action_param(params, "value") )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -195,7 +368,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = action_param(params, "value") )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -243,7 +416,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = action_param(params, "value") )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -269,7 +442,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
     else if ( action == "enter_text" )
     {
         std::string value;
-        if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+        if ( const char* val = action_param(params, "value") )
             value = val;
 
         if ( dynamic_cast<YInputField*>(widget) )
@@ -339,7 +512,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
     else if ( action == "select" )
     {
         std::string value;
-        if (const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value"))
+        if (const char* val = action_param(params, "value"))
             value = val;
         if ( dynamic_cast<YComboBox*>(widget) )
         {
@@ -362,11 +535,11 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else if( auto tbl = dynamic_cast<YTable*>(widget) )
         {
             int row_id = -1;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "row") )
+            if ( const char* val = action_param(params, "row") )
                 row_id = atoi(val);
 
             int column_id = 0;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "column") )
+            if ( const char* val = action_param(params, "column") )
                 column_id = atoi(val);
 
             return action_handler<YTable>( widget, body, get_table_handler()->get_handler( tbl, value, column_id, row_id) );
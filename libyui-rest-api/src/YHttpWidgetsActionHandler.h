@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <functional>
+#include <map>
 #include <microhttpd.h>
 #include <sstream>
 #include <boost/algorithm/string.hpp>
@@ -44,6 +45,10 @@
 #include "YHttpHandler.h"
 
 
+namespace Json {
+    class Value;
+}
+
 class YHttpWidgetsActionHandler : public YHttpHandler
 {
 
@@ -52,6 +57,11 @@ public:
     YHttpWidgetsActionHandler() {};
     virtual ~YHttpWidgetsActionHandler() {};
 
+    /**
+     * The optional action parameters ("value", "row" and "column").
+     **/
+    typedef std::map<std::string, std::string> ActionParams;
+
 protected:
 
     virtual void process_request(struct MHD_Connection* connection,
@@ -59,7 +69,22 @@ protected:
         size_t* upload_data_size, std::ostream& body, int& error_code,
         std::string& content_type, bool *redraw);
 
-    int do_action( YWidget *widget, const std::string &action, struct MHD_Connection *connection, std::ostream& body );
+    int do_action( YWidget *widget, const std::string &action, const ActionParams &params, std::ostream& body );
+
+    /**
+     * Run the JSON array of actions from the request body in order,
+     * stop at the first failing action. The dialog is updated only once
+     * after all actions.
+     **/
+    void process_batch( const char* upload_data, size_t upload_data_size,
+        std::ostream& body, int& error_code, bool *redraw );
+
+    /**
+     * Run one action of a batch: find the widget by the "selector"
+     * object and do the "action" with the other parameters.
+     * @return HTTP status code
+     **/
+    int do_batch_step( const Json::Value &step, std::ostream& body );
 
     /**
      * Define widgets handlers to override in case need to implement
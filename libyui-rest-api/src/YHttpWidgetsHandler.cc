@@ -22,10 +22,8 @@
 #include "YHttpWidgetsHandler.h"
 
 
-void YHttpWidgetsHandler::process_request(struct MHD_Connection* connection,
-    const char* url, const char* method, const char* upload_data,
-    size_t* upload_data_size, std::ostream& body, int& error_code,
-    std::string& content_type, bool *redraw)
+void YHttpWidgetsHandler::process_snapshot(struct MHD_Connection* connection,
+    std::string& body, int& error_code, std::string& content_type)
 {
     if (YDialog::topmostDialog(false))  {
         WidgetArray widgets;
@@ -44,7 +42,7 @@ void YHttpWidgetsHandler::process_request(struct MHD_Connection* connection,
         }
 
         if (widgets.empty()) {
-            body << "{ \"error\" : \"Widget not found\" }" << std::endl;
+            body += "{ \"error\" : \"Widget not found\" }\n";
             error_code = MHD_HTTP_NOT_FOUND;
         }
         else {
@@ -54,9 +52,31 @@ void YHttpWidgetsHandler::process_request(struct MHD_Connection* connection,
         }
     }
     else {
-        body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
+        body += "{ \"error\" : \"No dialog is open\" }\n";
         error_code = MHD_HTTP_NOT_FOUND;
     }
 
     content_type = "application/json";
 }
+
+std::string YHttpWidgetsHandler::snapshot_key(struct MHD_Connection* connection)
+{
+    std::string key;
+
+    // a missing argument is different from an empty one
+    for (const char *arg: { "label", "id", "type" })
+    {
+        const char* value = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, arg);
+
+        if (value)
+        {
+            key += arg;
+            key += '=';
+            key += value;
+        }
+
+        key += '\0';
+    }
+
+    return key;
+}
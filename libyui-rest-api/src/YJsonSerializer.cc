@@ -14,6 +14,7 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
+#include <algorithm>
 #include <json/json.h>
 
 #include <yui/YBarGraph.h>
@@ -42,34 +43,108 @@
 #include <yui/YWizard.h>
 
 #include "YJsonSerializer.h"
+#include "YJsonWriter.h"
 
-static void serialize_widget_properties(YWidget *widget, Json::Value &json);
-static void serialize_widget_data(YWidget *widget, Json::Value &json);
-static void serialize_widget_specific_data(YWidget *widget, Json::Value &json);
+namespace
+{
+    /**
+     * The scalar attributes of one widget. Like in a Json::Value a key set
+     * again replaces the previous value and the keys are written sorted.
+     **/
+    class JsonFields
+    {
+    public:
+
+        JsonFields() : _next(0) {}
+
+        template<typename T>
+        void set(const std::string &key, const T &value)
+        {
+            std::string json;
+            YJsonWriter writer(json, false);
+            writer.value(value);
+            set_raw(key, json);
+        }
+
+        void set_raw(const std::string &key, const std::string &json)
+        {
+            for (auto &field: _fields)
+            {
+                if (field.first == key)
+                {
+                    field.second = json;
+                    return;
+                }
+            }
+
+            _fields.emplace_back(key, json);
+        }
+
+        void sort()
+        {
+            std::sort(_fields.begin(), _fields.end());
+        }
+
+        // write the not yet written fields sorted before 'limit' (all if empty)
+        void write(YJsonWriter &writer, const std::string &limit = std::string())
+        {
+            for (; _next < _fields.size(); ++_next)
+            {
+                if (!limit.empty() && _fields[_next].first >= limit)
+                    break;
+
+                writer.key(_fields[_next].first);
+                writer.raw_value(_fields[_next].second);
+            }
+        }
+
+    private:
+
+        std::vector<std::pair<std::string, std::string>> _fields;
+        size_t _next;
+    };
+}
+
+static void serialize_widget_properties(YWidget *widget, JsonFields &json);
+static void serialize_widget_data(YWidget *widget, JsonFields &json);
+static void serialize_widget_specific_data(YWidget *widget, JsonFields &json);
+static void serialize_items(YSelectionWidget *selection, YJsonWriter &writer);
 
-Json::Value serialize_rec(YWidget *w, bool recursive = true) {
-    Json::Value ret;
+static void serialize_rec(YWidget *w, YJsonWriter &writer, bool recursive = true) {
+    JsonFields fields;
 
-    serialize_widget_properties(w, ret);
-    serialize_widget_data(w, ret);
-    serialize_widget_specific_data(w, ret);
+    serialize_widget_properties(w, fields);
+    serialize_widget_data(w, fields);
+    serialize_widget_specific_data(w, fields);
+    fields.sort();
+
+    writer.start_object();
+
+    // the items and the children are written directly, at the same
+    // position as the sorted scalar fields
+    if (auto selection = dynamic_cast<YSelectionWidget*>(w))
+    {
+        fields.write(writer, "items");
+        writer.key("items");
+        serialize_items(selection, writer);
+    }
 
     if (recursive && w->hasChildren()) {
-        Json::Value widgets;
+        fields.write(writer, "widgets");
+        writer.key("widgets");
+        writer.start_array();
 
         for ( YWidgetListConstIterator it = w->childrenBegin(); it != w->childrenEnd(); ++it )
         {
             if (*it)
-            {
-                Json::Value widget = serialize_rec(*it);
-                widgets.append(widget);
-            }
+                serialize_rec(*it, writer);
         }
 
-        ret["widgets"] = widgets;
+        writer.end_array();
     }
 
-    return ret;
+    fields.write(writer);
+    writer.end_object();
 }
 
 void YJsonSerializer::save(const Json::Value &json, std::ostream &output)
@@ -83,51 +158,68 @@ void YJsonSerializer::save(const Json::Value &json, std::ostream &output)
 }
 
 void YJsonSerializer::serialize(YWidget *w, std::ostream &output, bool recursive) {
-    if (!w) return;
-    Json::Value json = serialize_rec(w, recursive);
-    save(json, output);
+    std::string json;
+    serialize(w, json, recursive);
+    output << json;
 }
 
 void YJsonSerializer::serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive) {
-    Json::Value array;
+    std::string json;
+    serialize(widgets, json, recursive);
+    output << json;
+}
 
-    for(YWidget *widget: widgets)
+void YJsonSerializer::serialize(YWidget *w, std::string &output, bool recursive) {
+    if (!w) return;
+    YJsonWriter writer(output);
+    serialize_rec(w, writer, recursive);
+}
+
+void YJsonSerializer::serialize(const std::vector<YWidget*> &widgets, std::string &output, bool recursive) {
+    YJsonWriter writer(output);
+
+    if (widgets.empty())
     {
-        Json::Value json = serialize_rec(widget, recursive);
-        array.append(json);
+        writer.null_value();
+        return;
     }
 
-    save(array, output);
+    writer.start_array();
+
+    for(YWidget *widget: widgets)
+        serialize_rec(widget, writer, recursive);
+
+    writer.end_array();
 }
 
 namespace {
-    void add_opt_string_property(YWidget *w, const std::string &name, Json::Value &json, const std::string &key)
+    void add_opt_string_property(YWidget *w, const std::string &name, JsonFields &json, const std::string &key)
     {
         // only when not empty
         if (w->propertySet().contains(name) && !w->getProperty(name).stringVal().empty())
-            json[key] = w->getProperty(name).stringVal();
+            json.set(key, w->getProperty(name).stringVal());
     }
 }
 
-void serialize_widget_properties(YWidget *widget, Json::Value &json) {
-    auto propSet = widget->propertySet();
+void serialize_widget_properties(YWidget *widget, JsonFields &json) {
+    const YPropertySet &propSet = widget->propertySet();
 
     if (propSet.contains("WidgetClass"))
-        json["class"] = widget->getProperty("WidgetClass").stringVal();
+        json.set("class", widget->getProperty("WidgetClass").stringVal());
 
     if (widget->hasId())
-        json["id"] = widget->id()->toString();
+        json.set("id", widget->id()->toString());
 
     if (propSet.contains("Label"))
-        json["label"] = widget->getProperty("Label").stringVal();
+        json.set("label", widget->getProperty("Label").stringVal());
 
     // only when false
     if (propSet.contains("Enabled") && !widget->getProperty("Enabled").boolVal())
-        json["enabled"] = widget->getProperty("Enabled").boolVal();
+        json.set("enabled", widget->getProperty("Enabled").boolVal());
 
     // only when true
     if (propSet.contains("Notify") && widget->getProperty("Notify").boolVal())
-        json["notify"] = widget->getProperty("Notify").boolVal();
+        json.set("notify", widget->getProperty("Notify").boolVal());
 
     add_opt_string_property(widget, "DebugLabel", json, "debug_label");
     add_opt_string_property(widget, "Text", json, "text");
@@ -137,57 +229,95 @@ void serialize_widget_properties(YWidget *widget, Json::Value &json) {
 
     // only when set
     if (propSet.contains("InputMaxLength") && widget->getProperty("InputMaxLength").integerVal() >= 0)
-        json["input_max_length"] = (Json::Value::Int64)widget->getProperty("InputMaxLength").integerVal();
+        json.set("input_max_length", (long long)widget->getProperty("InputMaxLength").integerVal());
 
 }
 
-void serialize_widget_data(YWidget *widget, Json::Value &json) {
+void serialize_widget_data(YWidget *widget, JsonFields &json) {
     // generic data
     if (!widget->isEnabled())
-        json["enabled"] = widget->isEnabled();
+        json.set("enabled", widget->isEnabled());
 
     if (widget->notify())
-        json["notify"] = widget->notify();
+        json.set("notify", widget->notify());
 
     if (widget->hasFunctionKey())
-        json["fkey"] = widget->functionKey();
+        json.set("fkey", widget->functionKey());
 
     if (widget->stretchable(YD_HORIZ))
-        json["hstretch"] = widget->stretchable(YD_HORIZ);
+        json.set("hstretch", widget->stretchable(YD_HORIZ));
 
     if (widget->stretchable(YD_VERT))
-        json["vstretch"] = widget->stretchable(YD_VERT);
+        json.set("vstretch", widget->stretchable(YD_VERT));
 
     if (widget->hasWeight(YD_HORIZ))
-        json["hweight"] = widget->weight(YD_HORIZ);
+        json.set("hweight", widget->weight(YD_HORIZ));
 
     if (widget->hasWeight(YD_VERT))
-        json["vweight"] = widget->weight(YD_VERT);
+        json.set("vweight", widget->weight(YD_VERT));
 }
 
 namespace
 {
-    void add_items_rec(Json::Value &jitem, const YItem *yitem)
+    // the keys are written in the alphabetical order, like from a Json::Value
+    void add_items_rec(YJsonWriter &writer, const YItem *yitem)
     {
-        if (yitem->selected())
-            jitem["selected"] = true;
+        writer.start_object();
+
+        // this is mainly for the generic widgets like YSelectionBox, YComboBox,...
+        if (yitem->hasChildren())
+        {
+            writer.key("children");
+            writer.start_array();
+
+            // recursively add the children
+            std::for_each(yitem->childrenBegin(), yitem->childrenEnd(), [&](const YItem *ychild)
+            {
+                add_items_rec(writer, ychild);
+            });
+
+            writer.end_array();
+        }
 
         // handle YTableItem specifically
         if (auto tabitem = dynamic_cast<const YTableItem*>(yitem))
         {
-            Json::Value icons, labels;
             // add icons only if not empty
-            bool no_icon = true;
-            std::for_each(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
+            bool no_icon = std::all_of(tabitem->cellsBegin(), tabitem->cellsEnd(), [](const YTableCell *ycell)
             {
-                no_icon &= ycell->iconName().empty();
-                icons.append(ycell->iconName());
-                labels.append(ycell->label());
+                return ycell->iconName().empty();
             });
+
             if (!no_icon)
-                jitem["icons"] = icons;
+            {
+                writer.key("icons");
+                writer.start_array();
+
+                std::for_each(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
+                {
+                    writer.value(ycell->iconName());
+                });
+
+                writer.end_array();
+            }
+
+            writer.key("labels");
 
-            jitem["labels"] = labels;
+            if (tabitem->cellsBegin() != tabitem->cellsEnd())
+            {
+                writer.start_array();
+
+                std::for_each(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
+                {
+                    writer.value(ycell->label());
+                });
+
+                writer.end_array();
+            }
+            else
+            {
+                writer.null_value();
+            }
         }
         // else if (auto treeitem = dynamic_cast<const YTreeItem*>(yitem))
         // {
@@ -195,31 +325,68 @@ namespace
         // }
         else
         {
-            jitem["label"] = yitem->label();
-
             if (yitem->hasIconName())
-                jitem["icon_name"] = yitem->iconName();
+            {
+                writer.key("icon_name");
+                writer.value(yitem->iconName());
+            }
+
+            writer.key("label");
+            writer.value(yitem->label());
         }
 
-        // this is mainly for the generic widgets like YSelectionBox, YComboBox,...
-        if (yitem->hasChildren())
+        if (yitem->selected())
         {
-            Json::Value children;
+            writer.key("selected");
+            writer.value(true);
+        }
 
-            // recursively add the children
-            std::for_each(yitem->childrenBegin(), yitem->childrenEnd(), [&](const YItem *ychild)
-            {
-                Json::Value child;
-                add_items_rec(child, ychild);
-                children.append(child);
-            });
+        writer.end_object();
+    }
+
+    // encode a list of strings as a JSON array, null if empty
+    std::string string_array(const std::vector<std::string> &strings)
+    {
+        std::string json;
+        YJsonWriter writer(json, false);
 
-            jitem["children"] = children;
+        if (strings.empty())
+        {
+            writer.null_value();
+            return json;
         }
+
+        writer.start_array();
+
+        for (const std::string &str: strings)
+            writer.value(str);
+
+        writer.end_array();
+
+        return json;
     }
 }
+
+static void serialize_items(YSelectionWidget *selection, YJsonWriter &writer)
+{
+    if (!selection->hasItems())
+    {
+        writer.null_value();
+        return;
+    }
+
+    writer.start_array();
+
+    std::for_each(selection->itemsBegin(), selection->itemsEnd(), [&](const YItem *yitem)
+    {
+        add_items_rec(writer, yitem);
+    });
+
+    writer.end_array();
+}
+
 // widget specific data
-static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
+static void serialize_widget_specific_data(YWidget *widget, JsonFields &json) {
 
     // check all classes, some widgets might be derived from others
     // TODO: group the base classes and the final classes
@@ -233,69 +400,69 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
         case YGnomeButtonOrder  : order = "Gnome"; break;
         }
 
-        json["button_order"] = order;
+        json.set("button_order", order);
     }
 
     if (auto cb = dynamic_cast<YComboBox*>(widget))
     {
-        json["value"] = cb->value();
+        json.set("value", cb->value());
 
         if (cb->editable())
-            json["editable"] = true;
+            json.set("editable", true);
     }
 
     if (auto ch = dynamic_cast<YCheckBox*>(widget))
     {
         if (ch->value() != YCheckBoxState::YCheckBox_dont_care)
-            json["value"] = ch->isChecked();
+            json.set("value", ch->isChecked());
     }
 
     if (auto cbframe = dynamic_cast<YCheckBoxFrame*>(widget))
     {
-        json["auto_enable"] = cbframe->autoEnable();
+        json.set("auto_enable", cbframe->autoEnable());
     }
 
     if (auto img = dynamic_cast<YImage*>(widget))
     {
-        json["image_file_name"] = img->imageFileName();
-        json["animated"] = img->animated();
-        json["auto_scale"] = img->autoScale();
+        json.set("image_file_name", img->imageFileName());
+        json.set("animated", img->animated());
+        json.set("auto_scale", img->autoScale());
     }
 
     if (auto inp = dynamic_cast<YInputField*>(widget))
     {
-        json["value"] = inp->value();
-        json["password_mode"] = inp->passwordMode();
+        json.set("value", inp->value());
+        json.set("password_mode", inp->passwordMode());
     }
 
     if (auto inp = dynamic_cast<YMultiLineEdit*>(widget))
     {
-        json["value"] = inp->value();
+        json.set("value", inp->value());
     }
 
     if (auto inp = dynamic_cast<YProgressBar*>(widget))
     {
-        json["value"] = inp->value();
+        json.set("value", inp->value());
     }
 
     if (auto intf = dynamic_cast<YIntField*>(widget))
     {
-        json["value"] = intf->value();
-        json["min_value"] = intf->minValue();
-        json["max_value"] = intf->maxValue();
+        json.set("value", intf->value());
+        json.set("min_value", intf->minValue());
+        json.set("max_value", intf->maxValue());
     }
 
     if (auto rb = dynamic_cast<YRadioButton*>(widget))
     {
-        json["value"] = rb->value();
+        json.set("value", rb->value());
     }
 
     if (auto sp = dynamic_cast<YSpacing*>(widget))
     {
         if (sp->dimension() == YD_HORIZ)
-            json["value"] = sp->preferredWidth();
+            json.set("value", sp->preferredWidth());
         else
-            json["value"] = sp->preferredHeight();
+            json.set("value", sp->preferredHeight());
     }
 
     if (auto dg = dynamic_cast<YDialog*>(widget))
@@ -303,13 +470,13 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
         switch (dg->dialogType())
         {
             case YMainDialog:
-                json["type"] = "main";
+                json.set("type", "main");
                 break;
             case YPopupDialog:
-                json["type"] = "popup";
+                json.set("type", "popup");
                 break;
             case YWizardDialog:
-                json["type"] = "wizard";
+                json.set("type", "wizard");
                 break;
         }
     }
@@ -317,72 +484,63 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
     if (auto label = dynamic_cast<YLabel*>(widget))
     {
         if (label->isHeading())
-            json["is_heading"] = true;
+            json.set("is_heading", true);
 
         if (label->isOutputField())
-            json["is_output_field"] = true;
+            json.set("is_output_field", true);
 
         if (label->useBoldFont())
-            json["use_bold_font"] = true;
+            json.set("use_bold_font", true);
     }
 
     if (auto lv = dynamic_cast<YLogView*>(widget))
     {
-        json["lines"] = lv->lines();
-        json["log_text"] = lv->logText();
-        json["max_lines"] = lv->maxLines();
-        json["visible_lines"] = lv->visibleLines();
+        json.set("lines", lv->lines());
+        json.set("log_text", lv->logText());
+        json.set("max_lines", lv->maxLines());
+        json.set("visible_lines", lv->visibleLines());
     }
 
     if (auto mle = dynamic_cast<YMultiLineEdit*>(widget))
     {
-        json["input_max_length"] = mle->inputMaxLength();
-        json["default_visible_lines"] = mle->defaultVisibleLines();
+        json.set("input_max_length", mle->inputMaxLength());
+        json.set("default_visible_lines", mle->defaultVisibleLines());
     }
 
     if (auto pkg = dynamic_cast<YPackageSelector*>(widget))
     {
-        json["test_mode"] = pkg->testMode();
-        json["online_update_mode"] = pkg->onlineUpdateMode();
-        json["update_mode"] = pkg->updateMode();
-        json["search_mode"] = pkg->searchMode();
-        json["summary_mode"] = pkg->summaryMode();
-        json["repo_mode"] = pkg->repoMode();
-        json["repo_mgr_enabled"] = pkg->repoMgrEnabled();
-        json["confirm_unsupported"] = pkg->confirmUnsupported();
+        json.set("test_mode", pkg->testMode());
+        json.set("online_update_mode", pkg->onlineUpdateMode());
+        json.set("update_mode", pkg->updateMode());
+        json.set("search_mode", pkg->searchMode());
+        json.set("summary_mode", pkg->summaryMode());
+        json.set("repo_mode", pkg->repoMode());
+        json.set("repo_mgr_enabled", pkg->repoMgrEnabled());
+        json.set("confirm_unsupported", pkg->confirmUnsupported());
     }
 
+    // the items are written by serialize_items()
     if (auto selection = dynamic_cast<YSelectionWidget*>(widget))
     {
-        json["items_count"] = selection->itemsCount();
-        json["icon_base_path"] = selection->iconBasePath();
-
-        Json::Value items;
-        std::for_each(selection->itemsBegin(), selection->itemsEnd(), [&](const YItem *yitem)
-        {
-            Json::Value item;
-            add_items_rec(item, yitem);
-            items.append(item);
-        });
-
-        json["items"] = items;
+        json.set("items_count", selection->itemsCount());
+        json.set("icon_base_path", selection->iconBasePath());
     }
 
     if (auto progress = dynamic_cast<YProgressBar*>(widget))
     {
-        json["max_value"] = progress->maxValue();
+        json.set("max_value", progress->maxValue());
     }
 
     if (auto tb = dynamic_cast<YTable*>(widget))
     {
-        Json::Value header;
+        std::vector<std::string> header;
         for ( auto idx = 0; idx < tb->columns(); ++idx )
         {
-            header.append(tb->header(idx));
+            header.push_back(tb->header(idx));
         }
-        json["header"] = header;
+        json.set_raw("header", string_array(header));
 
-        Json::Value alignment;
+        std::vector<std::string> alignment;
         for ( auto idx = 0; idx < tb->columns(); ++idx )
         {
             std::string alignment_str;
@@ -401,38 +559,53 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
                     alignment_str = "center";
                     break;
             }
-            alignment.append(alignment_str);
+            alignment.push_back(alignment_str);
         }
-        json["alignment"] = alignment;
+        json.set_raw("alignment", string_array(alignment));
 
-        json["columns"] = tb->columns();
-        json["immediate_mode"] = tb->immediateMode();
-        json["keep_sorting"] = tb->keepSorting();
-        json["hasMultiSelection"] = tb->hasMultiSelection();
+        json.set("columns", tb->columns());
+        json.set("immediate_mode", tb->immediateMode());
+        json.set("keep_sorting", tb->keepSorting());
+        json.set("hasMultiSelection", tb->hasMultiSelection());
     }
 
     if ( auto bargraph = dynamic_cast<YBarGraph*>(widget) )
     {
-        Json::Value jsegment, jsegments;
-        for ( auto idx = 0; idx < bargraph->segments(); ++idx )
+        std::string jsegments;
+        YJsonWriter writer(jsegments, false);
+
+        if (bargraph->segments() > 0)
+        {
+            writer.start_array();
+
+            for ( auto idx = 0; idx < bargraph->segments(); ++idx )
+            {
+                YBarGraphSegment segment = bargraph->segment(idx);
+                writer.start_object();
+                writer.key("label");
+                writer.value(segment.label());
+                writer.key("value");
+                writer.value(segment.value());
+                writer.end_object();
+            }
+
+            writer.end_array();
+        }
+        else
         {
-            std::string label;
-            YBarGraphSegment segment = bargraph->segment(idx);
-            jsegment["label"] = segment.label();
-            jsegment["value"] = segment.value();
-            jsegments.append(jsegment);
+            writer.null_value();
         }
-        json["segments"] = jsegments;
 
+        json.set_raw("segments", jsegments);
     }
 
     if (auto df = dynamic_cast<YDateField*>(widget))
     {
-        json["value"] = df->value();
+        json.set("value", df->value());
     }
 
     if (auto tf = dynamic_cast<YTimeField*>(widget))
     {
-        json["value"] = tf->value();
+        json.set("value", tf->value());
     }
 }
@@ -18,6 +18,7 @@
 #define YJsonSerializer_h
 
 #include <iostream>
+#include <string>
 #include <vector>
 
 class YWidget;
@@ -37,6 +38,12 @@ public:
     // serialize widget array (by default recursively with all children)
     static void serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive = true);
 
+    // serialize one widget, append the JSON text to the output string
+    static void serialize(YWidget *, std::string &output, bool recursive = true);
+
+    // serialize widget array, append the JSON text to the output string
+    static void serialize(const std::vector<YWidget*> &widgets, std::string &output, bool recursive = true);
+
     // save the JSON value as a text into the output stream
     static void save(const Json::Value &json, std::ostream &output);
 };
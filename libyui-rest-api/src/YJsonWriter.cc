@@ -0,0 +1,200 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include "YJsonWriter.h"
+
+
+YJsonWriter::YJsonWriter(std::string &buffer, bool pretty)
+    : _out(buffer), _pretty(pretty), _after_key(false)
+{
+}
+
+void YJsonWriter::start_object()
+{
+    separate();
+    _out += '{';
+    _empty.push_back(true);
+}
+
+void YJsonWriter::end_object()
+{
+    close('}');
+}
+
+void YJsonWriter::start_array()
+{
+    separate();
+    _out += '[';
+    _empty.push_back(true);
+}
+
+void YJsonWriter::end_array()
+{
+    close(']');
+}
+
+void YJsonWriter::key(const std::string &key)
+{
+    separate();
+    append_string(_out, key);
+    _out += _pretty ? " : " : ": ";
+    _after_key = true;
+}
+
+void YJsonWriter::value(const std::string &str)
+{
+    separate();
+    append_string(_out, str);
+}
+
+void YJsonWriter::value(const char *str)
+{
+    separate();
+    append_string(_out, str ? str : "");
+}
+
+void YJsonWriter::value(bool b)
+{
+    separate();
+    _out += b ? "true" : "false";
+}
+
+void YJsonWriter::value(int i)
+{
+    separate();
+    _out += std::to_string(i);
+}
+
+void YJsonWriter::value(unsigned u)
+{
+    separate();
+    _out += std::to_string(u);
+}
+
+void YJsonWriter::value(long l)
+{
+    separate();
+    _out += std::to_string(l);
+}
+
+void YJsonWriter::value(unsigned long ul)
+{
+    separate();
+    _out += std::to_string(ul);
+}
+
+void YJsonWriter::value(long long ll)
+{
+    separate();
+    _out += std::to_string(ll);
+}
+
+void YJsonWriter::value(unsigned long long ull)
+{
+    separate();
+    _out += std::to_string(ull);
+}
+
+void YJsonWriter::null_value()
+{
+    separate();
+    _out += "null";
+}
+
+void YJsonWriter::raw_value(const std::string &json)
+{
+    separate();
+    _out += json;
+}
+
+void YJsonWriter::separate()
+{
+    // the value of a key follows directly
+    if (_after_key)
+    {
+        _after_key = false;
+        return;
+    }
+
+    if (_empty.empty())
+        return;
+
+    if (_empty.back())
+        _empty.back() = false;
+    else
+        _out += _pretty ? "," : ", ";
+
+    newline(_empty.size());
+}
+
+void YJsonWriter::close(char bracket)
+{
+    bool empty = _empty.back();
+    _empty.pop_back();
+
+    if (!empty)
+        newline(_empty.size());
+
+    _out += bracket;
+}
+
+void YJsonWriter::newline(size_t depth)
+{
+    if (!_pretty)
+        return;
+
+    _out += '\n';
+    _out.append(2 * depth, ' ');
+}
+
+void YJsonWriter::append_string(std::string &out, const std::string &str)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    out += '"';
+
+    // copy the characters which don't need escaping in chunks
+    size_t start = 0;
+
+    for (size_t i = 0; i < str.size(); ++i)
+    {
+        unsigned char c = str[i];
+
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        out.append(str, start, i - start);
+        start = i + 1;
+
+        switch (c)
+        {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += hex[c >> 4];
+                out += hex[c & 0xf];
+        }
+    }
+
+    out.append(str, start, std::string::npos);
+    out += '"';
+}
@@ -0,0 +1,86 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YJsonWriter_h
+#define YJsonWriter_h
+
+#include <string>
+#include <vector>
+
+/**
+ * Streaming JSON writer: Writes JSON text directly to the end of a string
+ * buffer without building a JSON document first.
+ *
+ * Objects and arrays are written with start_object()/end_object() and
+ * start_array()/end_array(); inside objects each value must be preceded by
+ * key(). The caller is responsible for not writing the same key twice.
+ **/
+class YJsonWriter
+{
+
+public:
+
+    /**
+     * Constructor. With 'pretty' the output is indented (with two spaces
+     * per level), otherwise it is written on a single line.
+     **/
+    YJsonWriter(std::string &buffer, bool pretty = true);
+
+    void start_object();
+    void end_object();
+
+    void start_array();
+    void end_array();
+
+    void key(const std::string &key);
+
+    void value(const std::string &str);
+    void value(const char *str);
+    void value(bool b);
+    void value(int i);
+    void value(unsigned u);
+    void value(long l);
+    void value(unsigned long ul);
+    void value(long long ll);
+    void value(unsigned long long ull);
+    void null_value();
+
+    /**
+     * Write an already encoded JSON value, e.g. from another YJsonWriter.
+     **/
+    void raw_value(const std::string &json);
+
+    /**
+     * Append 'str' as a quoted and escaped JSON string to 'out'.
+     **/
+    static void append_string(std::string &out, const std::string &str);
+
+private:
+
+    // prepare writing the next value
+    void separate();
+    void close(char bracket);
+    void newline(size_t depth);
+
+    std::string &_out;
+    bool _pretty;
+
+    // one entry for each open object or array: 'true' if it is still empty
+    std::vector<bool> _empty;
+    bool _after_key;
+};
+
+#endif // YJsonWriter_h
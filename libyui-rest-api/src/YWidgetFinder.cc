@@ -14,9 +14,8 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
-// boost::erase_all
-#include <boost/algorithm/string.hpp>
-#include <functional>
+#include <algorithm>
+#include <unordered_map>
 
 #include <yui/YDialog.h>
 #include <yui/YWidget.h>
@@ -25,102 +24,171 @@
 #include "YWidgetFinder.h"
 
 
-// internal helper methods
-static bool filter_by_label_rec(YWidget *w, const std::string &label);
-static bool filter_by_id_rec(YWidget *w, const std::string &id);
-static bool filter_by_type_rec(YWidget *w, const std::string &type);
-static void find_widgets(YWidget *w, WidgetArray &array, std::function<bool (YWidget*)> filter_func);
+// internal helper types and methods
+namespace
+{
+    // the indexed attributes of one widget
+    struct IndexEntry
+    {
+        YWidget *   widget;
+        bool        hasId;
+        std::string id;
+        std::string widget_class;
+        bool        hasLabel;
+        std::string label;          // without the '&' shortcut markers
+    };
+
+    // positions in WidgetIndex::entries
+    typedef std::vector<size_t> Positions;
+    typedef std::unordered_map<std::string, Positions> PositionsMap;
+
+    struct WidgetIndex
+    {
+        WidgetIndex() : dialog( nullptr ), revision( 0 ) {}
+
+        YDialog *               dialog;
+        unsigned long           revision;
+        std::vector<IndexEntry> entries;    // in the widget tree order
+        PositionsMap            by_id;
+        PositionsMap            by_type;
+        PositionsMap            by_label;
+    };
+
+    WidgetIndex widget_index;
+}
+
+static const WidgetIndex & topmost_dialog_index();
+static void index_widgets(YWidget *w, WidgetIndex &index);
+static WidgetArray find_widgets(const char* label, const char* id, const char* type);
+
 
 // WidgetArray YWidgetFinder::find(const std::string &label, const std::string &id, const std::string &type)
 WidgetArray YWidgetFinder::find( const char* label, const char* id, const char* type )
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& label, & id, & type] (YWidget *w) {
-        return (!label || filter_by_label_rec(w, label)) &&
-               (!id || filter_by_id_rec(w, id)) &&
-               (!type || filter_by_type_rec(w, type));
-    } );
-    return ret;
+    return find_widgets(label, id, type);
 }
 
 WidgetArray YWidgetFinder::by_label(const std::string &label)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& label] (YWidget *w) {
-        return filter_by_label_rec(w, label);
-    } );
-    return ret;
+    return find_widgets(label.c_str(), nullptr, nullptr);
 }
 
 WidgetArray YWidgetFinder::by_id(const std::string &id)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& id] (YWidget *w) {
-        return filter_by_id_rec(w, id);
-    } );
-    return ret;
+    return find_widgets(nullptr, id.c_str(), nullptr);
 }
 
 WidgetArray YWidgetFinder::by_type(const std::string &type)
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [& type] (YWidget *w) {
-        return filter_by_type_rec(w, type);
-    } );
-    return ret;
+    return find_widgets(nullptr, nullptr, type.c_str());
 }
 
 WidgetArray YWidgetFinder::all()
 {
-    WidgetArray ret;
-    find_widgets(YDialog::topmostDialog(), ret, [] (YWidget *w) {
-        return true;
-    } );
-    return ret;
+    return find_widgets(nullptr, nullptr, nullptr);
 }
 
-void find_widgets(YWidget *w, WidgetArray &array, std::function<bool (YWidget*)> filter_func) {
-    if ( !w )
-        return;
-
-    if( filter_func(w) )
-        array.push_back(w);
+static const WidgetIndex & topmost_dialog_index()
+{
+    YDialog *dialog = YDialog::topmostDialog();
 
-    for(YWidget *child: *w)
+    if ( widget_index.dialog != dialog || widget_index.revision != dialog->widgetsRevision() )
     {
-        find_widgets(child, array, filter_func);
-    };
+        widget_index = WidgetIndex();
+        index_widgets(dialog, widget_index);
+        widget_index.dialog = dialog;
+        widget_index.revision = dialog->widgetsRevision();
+    }
+
+    return widget_index;
 }
 
-static bool filter_by_label_rec(YWidget *w, const std::string &label)
+static void index_widgets(YWidget *w, WidgetIndex &index)
 {
+    IndexEntry entry;
+    entry.widget = w;
+    entry.hasId = w->hasId();
+    entry.hasLabel = false;
+
+    if ( entry.hasId )
+        entry.id = w->id()->toString();
+
+    const YPropertySet & propSet = w->propertySet();
+
+    if ( propSet.contains("WidgetClass") )
+        entry.widget_class = w->getProperty("WidgetClass").stringVal();
+
     // check the widget label if it is defined
-    if ( w->propertySet().contains("Label") )
+    if ( propSet.contains("Label") )
     {
-        std::string widget_label = w->getProperty("Label").stringVal();
-        boost::erase_all(widget_label, "&");
-
-        if ( widget_label == label )
-            return true;
+        entry.hasLabel = true;
+        entry.label = w->getProperty("Label").stringVal();
+        entry.label.erase(std::remove(entry.label.begin(), entry.label.end(), '&'), entry.label.end());
     }
-    return false;
+
+    size_t pos = index.entries.size();
+
+    if ( entry.hasId )
+        index.by_id[entry.id].push_back(pos);
+
+    if ( !entry.widget_class.empty() )
+        index.by_type[entry.widget_class].push_back(pos);
+
+    if ( entry.hasLabel )
+        index.by_label[entry.label].push_back(pos);
+
+    index.entries.push_back(std::move(entry));
+
+    for(YWidget *child: *w)
+    {
+        index_widgets(child, index);
+    };
 }
 
-static bool filter_by_id_rec(YWidget *w, const std::string &id)
+static const Positions * lookup(const PositionsMap &map, const char *key)
 {
-    if ( w->hasId() && w->id()->toString() == id )
-        return true;
+    static const Positions none;
+    PositionsMap::const_iterator it = map.find(key);
 
-    return false;
+    return it == map.end() ? &none : &it->second;
 }
 
-
-static bool filter_by_type_rec(YWidget *w, const std::string &type)
+static WidgetArray find_widgets(const char* label, const char* id, const char* type)
 {
-    auto propSet = w->propertySet();
+    const WidgetIndex & index = topmost_dialog_index();
+    WidgetArray ret;
 
-    if ( propSet.contains("WidgetClass") && w->getProperty("WidgetClass").stringVal() == type )
-        return true;
+    if ( !label && !id && !type )
+    {
+        ret.reserve(index.entries.size());
+
+        for (const IndexEntry &entry: index.entries)
+            ret.push_back(entry.widget);
+
+        return ret;
+    }
 
-    return false;
+    // start with the most selective criterion and check the others
+    const Positions * candidates;
+
+    if ( id )
+        candidates = lookup(index.by_id, id);
+    else if ( label )
+        candidates = lookup(index.by_label, label);
+    else
+        candidates = lookup(index.by_type, type);
+
+    for (size_t pos: *candidates)
+    {
+        const IndexEntry &entry = index.entries[pos];
+
+        if ( ( !label || ( entry.hasLabel && entry.label == label ) ) &&
+             ( !id || ( entry.hasId && entry.id == id ) ) &&
+             ( !type || entry.widget_class == type ) )
+        {
+            ret.push_back(entry.widget);
+        }
+    }
+
+    return ret;
 }
@@ -24,6 +24,17 @@ class YWidget;
 
 typedef std::vector<YWidget*> WidgetArray;
 
+/**
+ * Find widgets in the topmost dialog by label, ID or widget class.
+ *
+ * The widgets of the dialog are indexed by their ID, widget class and label
+ * (without shortcut markers) the first time the dialog is searched. The index
+ * is reused until widgets are added to or removed from the dialog or get a
+ * new ID or label (see YDialog::widgetsRevision()), so repeated requests
+ * don't have to walk the widget tree.
+ *
+ * The widgets are always returned in the order of the widget tree.
+ **/
 class YWidgetFinder
 {
 
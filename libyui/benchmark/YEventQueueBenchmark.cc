@@ -0,0 +1,205 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YEventQueueBenchmark.cc
+
+  Micro benchmark for YEventQueue without any UI: Events sent in bursts
+  like a busy UI does, merged and consumed in batches by the application.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "YEvent.h"
+#include "YEventQueue.h"
+#include "YWidget.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * A widget without a UI to send events for.
+ *
+ * The widgets are never deleted: The YWidget destructor needs a loaded UI
+ * (YUI::ui()->deleteNotify()).
+ **/
+class BenchmarkWidget : public YWidget
+{
+public:
+
+    BenchmarkWidget()
+	: YWidget( 0 )
+	{}
+
+    virtual const char * widgetClass() const { return "BenchmarkWidget"; }
+    virtual int	 preferredWidth()	     { return 1; }
+    virtual int	 preferredHeight()	     { return 1; }
+    virtual void setSize( int, int )	     {}
+};
+
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ **/
+static void measure( const char * name, int count, std::function<void( int )> op )
+{
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	op( i );
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    allocs = allocations - allocs;
+
+    printf( "%-28s %8d %12.3f %12.2f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( allocs ) / count );
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--events N] [--burst N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int eventCount = 1000000;
+    int burstSize  = 100;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--events" && i + 1 < argc )
+	    eventCount = atoi( argv[ ++i ] );
+	else if ( arg == "--burst" && i + 1 < argc )
+	    burstSize = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( eventCount <= 0 || burstSize <= 0 )
+	usage( argv[0] );
+
+    const int widgetCount = 16;
+    std::vector<YWidget *> widgets;
+
+    for ( int i = 0; i < widgetCount; i++ )
+	widgets.push_back( new BenchmarkWidget() );
+
+    printf( "%-28s %8s %12s %12s\n", "Operation", "Count", "usec/op", "allocs/op" );
+
+    YEventQueue queue;
+    std::vector<YEvent *> events;
+    events.reserve( burstSize );
+
+    // One event at a time, like a quiet UI
+
+    measure( "send and consume", eventCount, [&]( int i )
+    {
+	queue.sendEvent( new YWidgetEvent( widgets[ i % widgetCount ], YEvent::ValueChanged ) );
+	queue.deleteEvent( queue.consumePendingEvent() );
+    } );
+
+    // Bursts of mixed events, like a busy UI; many of them are merged
+
+    long   consumed   = 0;
+    double maxLatency = 0.0;	// microseconds from the start of a burst
+    int	   bursts     = ( eventCount + burstSize - 1 ) / burstSize;
+
+    measure( "send burst and consume", bursts, [&]( int burst )
+    {
+	auto burstStart = std::chrono::steady_clock::now();
+
+	for ( int j = 0; j < burstSize; j++ )
+	{
+	    int i = burst * burstSize + j;
+
+	    switch ( i % 4 )
+	    {
+		case 0: queue.sendEvent( new YWidgetEvent( widgets[ i % widgetCount ], YEvent::ValueChanged ) ); break;
+		case 1: queue.sendEvent( new YWidgetEvent( widgets[ i % widgetCount ], YEvent::Activated    ) ); break;
+		case 2: queue.sendEvent( new YTimeoutEvent() );	break;
+		case 3: queue.sendEvent( new YMenuEvent( "menu" ) );	break;
+	    }
+	}
+
+	events.clear();
+	consumed += queue.consumePendingEvents( events );
+
+	for ( YEvent * event : events )
+	    queue.deleteEvent( event );
+
+	std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - burstStart;
+	maxLatency = std::max( maxLatency, latency.count() );
+    } );
+
+    printf( "\n%d events in bursts of %d: %ld consumed, %lu merged, %lu lost, max. burst latency %.1f usec\n",
+	    bursts * burstSize, burstSize, consumed, queue.mergedEventsCount(), queue.discardedEventsCount(),
+	    maxLatency );
+
+    // Nothing is lost: Every event was either consumed or merged
+
+    if ( queue.discardedEventsCount() != 0 || consumed + (long) queue.mergedEventsCount() != bursts * burstSize )
+    {
+	fprintf( stderr, "Events were lost\n" );
+	return 1;
+    }
+
+    return 0;
+}
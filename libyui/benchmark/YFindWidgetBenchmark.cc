@@ -0,0 +1,270 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YFindWidgetBenchmark.cc
+
+  Micro benchmark for looking up widgets by ID without any UI: A generated
+  dialog with many widgets that all have an ID, searched with
+  YWidget::findWidget() (using the widget ID index of the dialog) and with
+  a recursive walk over the widget tree like findWidget() did before.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "YDialog.h"
+#include "YChildrenManager.h"
+#include "YWidgetID.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * A container widget without a UI.
+ *
+ * The widgets are never deleted: The YWidget destructor needs a loaded UI
+ * (YUI::ui()->deleteNotify()).
+ **/
+class BenchmarkWidget : public YWidget
+{
+public:
+
+    BenchmarkWidget( YWidget * parent )
+	: YWidget( parent )
+	{ setChildrenManager( new YWidgetChildrenManager( this ) ); }
+
+    virtual const char * widgetClass() const { return "BenchmarkWidget"; }
+    virtual int	 preferredWidth()	     { return 1; }
+    virtual int	 preferredHeight()	     { return 1; }
+    virtual void setSize( int, int )	     {}
+};
+
+
+/**
+ * A dialog without a UI. It is never opened.
+ **/
+class BenchmarkDialog : public YDialog
+{
+public:
+
+    BenchmarkDialog()
+	: YDialog( YMainDialog, YDialogNormalColor )
+	{}
+
+    virtual void setSize( int, int ) {}
+    virtual void activate() {}
+
+protected:
+
+    virtual void     openInternal() {}
+    virtual YEvent * waitForEventInternal( int ) { return 0; }
+    virtual YEvent * pollEventInternal()	 { return 0; }
+};
+
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ **/
+static void measure( const char * name, int count, std::function<void( int )> op )
+{
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	op( i );
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    allocs = allocations - allocs;
+
+    printf( "%-28s %6d %14.2f %12.1f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( allocs ) / count );
+}
+
+
+/**
+ * Create 'count' widgets with IDs below 'parent' like in a dialog: boxes
+ * with a few widgets each, nested a few levels deep.
+ **/
+static void createWidgets( YWidget * parent, std::vector<YWidgetID *> & ids, int count )
+{
+    std::vector<YWidget *> level( 1, parent );
+
+    while ( (int) ids.size() < count )
+    {
+	std::vector<YWidget *> nextLevel;
+
+	for ( YWidget * box : level )
+	{
+	    for ( int i = 0; i < 6 && (int) ids.size() < count; i++ )
+	    {
+		YWidget * widget = new BenchmarkWidget( box );
+		ids.push_back( new YStringWidgetID( "widget" + std::to_string( ids.size() ) ) );
+		widget->setId( ids.back() );
+		nextLevel.push_back( widget );
+	    }
+	}
+
+	level.swap( nextLevel );
+    }
+}
+
+
+/**
+ * Search the tree below 'widget' for a widget with ID 'id' like
+ * YWidget::findWidget() did without the widget ID index.
+ **/
+static YWidget * findInTree( const YWidget * widget, YWidgetID * id )
+{
+    for ( YWidgetListConstIterator it = widget->childrenBegin(); it != widget->childrenEnd(); ++it )
+    {
+	YWidget * child = *it;
+
+	if ( child->id() && child->id()->isEqual( id ) )
+	    return child;
+
+	if ( child->hasChildren() )
+	{
+	    YWidget * found = findInTree( child, id );
+
+	    if ( found )
+		return found;
+	}
+    }
+
+    return 0;
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--widgets N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int widgetCount = 5000;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--widgets" && i + 1 < argc )
+	    widgetCount = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( widgetCount <= 0 )
+	usage( argv[0] );
+
+    printf( "%d widgets\n\n", widgetCount );
+    printf( "%-28s %6s %14s %12s\n", "Operation", "Count", "usec/op", "allocs/op" );
+
+    BenchmarkDialog * dialog = new BenchmarkDialog();
+    BenchmarkWidget * vbox   = new BenchmarkWidget( dialog );
+    std::vector<YWidgetID *> ids;
+
+    measure( "create widgets with IDs", 1, [&]( int ) { createWidgets( vbox, ids, widgetCount ); } );
+
+    // Look up the widgets in a scattered order; both ways must find the
+    // same widget
+
+    YStringWidgetID missing( "missing" );
+    int lookups = 10000;
+    int wrong   = 0;
+
+    std::vector<YWidget *> found( lookups );
+
+    measure( "findWidget()", lookups, [&]( int i )
+    {
+	found[ i ] = dialog->findWidget( ids[ ( i * 7919 ) % widgetCount ] );
+    } );
+
+    measure( "tree walk", lookups / 10, [&]( int i )
+    {
+	wrong += findInTree( dialog, ids[ ( i * 7919 ) % widgetCount ] ) != found[ i ];
+    } );
+
+    measure( "findWidget(), not found", lookups, [&]( int )
+    {
+	wrong += dialog->findWidget( &missing, false ) != 0;
+    } );
+
+    measure( "tree walk, not found", lookups / 10, [&]( int )
+    {
+	wrong += findInTree( dialog, &missing ) != 0;
+    } );
+
+    // A script updating the widgets after an event changes some IDs, too
+
+    measure( "change ID", lookups, [&]( int i )
+    {
+	YWidget * widget = found[ i ];
+	ids[ ( i * 7919 ) % widgetCount ] = new YStringWidgetID( "changed" + std::to_string( i ) );
+	widget->setId( ids[ ( i * 7919 ) % widgetCount ] );
+    } );
+
+    for ( int i = 0; i < lookups; i++ )
+	wrong += dialog->findWidget( ids[ ( i * 7919 ) % widgetCount ] ) != found[ i ];
+
+    if ( wrong != 0 )
+    {
+	fprintf( stderr, "%d lookups found the wrong widget\n", wrong );
+	return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,439 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YLayoutBenchmark.cc
+
+  Micro benchmark for the layout engine without any UI: Dialogs modeled
+  after the ManyWidgets and Table-many-items examples and a deeply nested
+  one are laid out with the preferred sizes memoized during the layout
+  pass (YDialog::recalcLayout()) and without, like before. It counts how
+  often the preferred size of a widget is computed.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "YUI.h"
+#include "YApplication.h"
+#include "YDialog.h"
+#include "YAlignment.h"
+#include "YLayoutBox.h"
+#include "YSquash.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * Number of preferred size computations of all widgets.
+ **/
+static unsigned long preferredSizeCalls = 0;
+
+
+//
+// Widgets without a UI that count their preferred size computations.
+//
+// The widgets are never deleted: The YWidget destructor needs a loaded UI
+// (YUI::ui()->deleteNotify()).
+//
+
+/**
+ * A leaf widget, like a label or a push button. If it has items, like a
+ * table, it checks all of them for its preferred width, like a UI would
+ * to find the widest one.
+ **/
+class BenchmarkLeaf : public YWidget
+{
+public:
+
+    BenchmarkLeaf( YWidget * parent, const std::string & label, int itemCount = 0 )
+	: YWidget( parent )
+	, _label( label )
+    {
+	for ( int i = 1; i <= itemCount; i++ )
+	    _items.push_back( "Pizza #" + std::to_string( i ) );
+    }
+
+    virtual const char * widgetClass() const { return "BenchmarkLeaf"; }
+
+    virtual int preferredWidth()
+    {
+	++preferredSizeCalls;
+	int width = _label.size() + 4;
+
+	for ( const std::string & item : _items )
+	    width = std::max( width, (int) item.size() + 2 );
+
+	return width;
+    }
+
+    virtual int preferredHeight()
+    {
+	++preferredSizeCalls;
+	return _items.empty() ? 1 : 10;
+    }
+
+    virtual void setSize( int, int ) {}
+
+private:
+
+    std::string		     _label;
+    std::vector<std::string> _items;
+};
+
+
+class BenchmarkBox : public YLayoutBox
+{
+public:
+
+    BenchmarkBox( YWidget * parent, YUIDimension dim )
+	: YLayoutBox( parent, dim )
+	{}
+
+    virtual int preferredSize( YUIDimension dim )
+    {
+	++preferredSizeCalls;
+	return YLayoutBox::preferredSize( dim );
+    }
+
+    virtual void moveChild( YWidget *, int, int ) {}
+};
+
+
+class BenchmarkAlignment : public YAlignment
+{
+public:
+
+    BenchmarkAlignment( YWidget * parent, YAlignmentType horAlign, YAlignmentType vertAlign )
+	: YAlignment( parent, horAlign, vertAlign )
+	{}
+
+    virtual int preferredSize( YUIDimension dim )
+    {
+	++preferredSizeCalls;
+	return YAlignment::preferredSize( dim );
+    }
+
+    virtual void moveChild( YWidget *, int, int ) {}
+};
+
+
+class BenchmarkSquash : public YSquash
+{
+public:
+
+    BenchmarkSquash( YWidget * parent )
+	: YSquash( parent, true, true )
+	{}
+
+    virtual int preferredSize( YUIDimension dim )
+    {
+	++preferredSizeCalls;
+	return YSquash::preferredSize( dim );
+    }
+};
+
+
+/**
+ * A dialog without a UI. It is never opened.
+ **/
+class BenchmarkDialog : public YDialog
+{
+public:
+
+    BenchmarkDialog()
+	: YDialog( YMainDialog, YDialogNormalColor )
+	{}
+
+    virtual void activate() {}
+
+protected:
+
+    virtual void     openInternal() {}
+    virtual YEvent * waitForEventInternal( int ) { return 0; }
+    virtual YEvent * pollEventInternal()	 { return 0; }
+};
+
+
+
+/**
+ * An application without a UI. The layout only needs reverseLayout().
+ **/
+class BenchmarkApplication : public YApplication
+{
+public:
+
+    BenchmarkApplication() {}
+
+    virtual std::string askForExistingDirectory( const std::string &, const std::string & ) { return ""; }
+    virtual std::string askForExistingFile( const std::string &, const std::string &, const std::string & ) { return ""; }
+    virtual std::string askForSaveFileName( const std::string &, const std::string &, const std::string & ) { return ""; }
+
+    virtual int	 displayWidth()		{ return 80; }
+    virtual int	 displayHeight()	{ return 25; }
+    virtual int	 displayDepth()		{ return 24; }
+    virtual long displayColors()	{ return 256; }
+    virtual int	 defaultWidth()		{ return 80; }
+    virtual int	 defaultHeight()	{ return 25; }
+    virtual bool isTextMode()		{ return true; }
+    virtual bool hasImageSupport()	{ return false; }
+    virtual bool hasIconSupport()	{ return false; }
+    virtual bool hasAnimationSupport()	{ return false; }
+    virtual bool hasFullUtf8Support()	{ return true; }
+    virtual bool richTextSupportsTable()	{ return false; }
+    virtual bool leftHandedMouse()	{ return false; }
+};
+
+
+/**
+ * A UI that only provides the application.
+ **/
+class BenchmarkUI : public YUI
+{
+public:
+
+    BenchmarkUI()
+	: YUI( false )
+	{}
+
+protected:
+
+    virtual YWidgetFactory *	     createWidgetFactory()	   { return 0; }
+    virtual YOptionalWidgetFactory * createOptionalWidgetFactory() { return 0; }
+    virtual YApplication *	     createApplication()	   { return new BenchmarkApplication(); }
+    virtual YEvent *		     runPkgSelection( YWidget * )  { return 0; }
+    virtual void		     idleLoop( int )		   {}
+};
+
+
+//
+// The dialogs
+//
+
+static YWidget * vbox( YWidget * parent ) { return new BenchmarkBox( parent, YD_VERT  ); }
+static YWidget * hbox( YWidget * parent ) { return new BenchmarkBox( parent, YD_HORIZ ); }
+
+static YWidget * left( YWidget * parent )
+{
+    return new BenchmarkAlignment( parent, YAlignBegin, YAlignUnchanged );
+}
+
+
+/**
+ * Like the ManyWidgets example.
+ **/
+static void manyWidgets( YDialog * dialog )
+{
+    YWidget * top = vbox( dialog );
+    new BenchmarkLeaf( top, "Many Widgets" );
+
+    YWidget * columns = hbox( top );
+    YWidget * leftColumn  = vbox( columns );
+    YWidget * rightColumn = vbox( columns );
+
+    new BenchmarkLeaf( leftColumn, "&Name" );
+    new BenchmarkLeaf( leftColumn, "&Password" );
+    new BenchmarkLeaf( leftColumn, "&Count" );
+    new BenchmarkLeaf( leftColumn, "C&olor", 3 );
+
+    // Not new BenchmarkLeaf( left( ... ) ): YWidget checks that it was
+    // created with operator new, and that only works for one at a time
+
+    for ( int i = 1; i <= 3; i++ )
+    {
+	YWidget * alignment = left( leftColumn );
+	new BenchmarkLeaf( alignment, "Check box " + std::to_string( i ) );
+    }
+
+    YWidget * radioGroup = new BenchmarkSquash( rightColumn );
+    YWidget * radioBox	 = vbox( radioGroup );
+
+    for ( int i = 1; i <= 3; i++ )
+    {
+	YWidget * alignment = left( radioBox );
+	new BenchmarkLeaf( alignment, "Radio button " + std::to_string( i ) );
+    }
+
+    new BenchmarkLeaf( rightColumn, "Status" );
+    new BenchmarkLeaf( rightColumn, "Progress" );
+
+    YWidget * buttons = hbox( top );
+
+    for ( int i = 1; i <= 3; i++ )
+	new BenchmarkLeaf( buttons, "Button " + std::to_string( i ) );
+}
+
+
+/**
+ * Like the Table-many-items example.
+ **/
+static void tableManyItems( YDialog * dialog, int itemCount )
+{
+    YWidget * top = vbox( dialog );
+    YAlignment * minSize = new BenchmarkAlignment( top, YAlignUnchanged, YAlignUnchanged );
+    minSize->setMinWidth( 50 );
+    minSize->setMinHeight( 16 );
+
+    new BenchmarkLeaf( minSize, "Table", itemCount );
+
+    YWidget * buttons = hbox( top );
+    new BenchmarkLeaf( buttons, "&Sort" );
+    new BenchmarkLeaf( buttons, "&Close" );
+}
+
+
+/**
+ * Boxes nested 'depth' levels deep with two children each, alternating
+ * between HBox and VBox, like the pages of a wizard in a wizard dialog.
+ **/
+static void nested( YWidget * parent, int depth )
+{
+    if ( depth == 0 )
+    {
+	new BenchmarkLeaf( parent, "Leaf" );
+	return;
+    }
+
+    YWidget * box = depth % 2 ? hbox( parent ) : vbox( parent );
+    nested( box, depth - 1 );
+    nested( box, depth - 1 );
+}
+
+
+
+/**
+ * Lay out 'dialog' 'count' times and print the time, the preferred size
+ * computations and the allocations per layout.
+ **/
+static void measure( const char * name, int count, std::function<void()> layout )
+{
+    unsigned long calls  = preferredSizeCalls;
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	layout();
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    calls  = preferredSizeCalls - calls;
+    allocs = allocations - allocs;
+
+    printf( "%-28s %6d %14.2f %12.1f %12.1f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( calls ) / count,
+	    double( allocs ) / count );
+}
+
+
+/**
+ * Measure the layout of 'dialog' without and with memoized preferred sizes.
+ **/
+static void measureLayout( const std::string & name, YDialog * dialog, int count )
+{
+    // Outside of a layout pass, YWidget::cachedPreferredSize() doesn't
+    // memoize anything, so this is what a layout cost before
+    measure( ( name + ", uncached" ).c_str(), count, [dialog]()
+    {
+	dialog->setSize( dialog->preferredWidth(), dialog->preferredHeight() );
+    } );
+
+    measure( ( name + ", memoized" ).c_str(), count, [dialog]()
+    {
+	dialog->recalcLayout();
+    } );
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--items N] [--depth N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int itemCount = 1000;
+    int depth     = 8;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--items" && i + 1 < argc )
+	    itemCount = atoi( argv[ ++i ] );
+	else if ( arg == "--depth" && i + 1 < argc )
+	    depth = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( itemCount <= 0 || depth <= 0 || depth > 16 )
+	usage( argv[0] );
+
+    new BenchmarkUI();
+
+    printf( "%-28s %6s %14s %12s %12s\n", "Layout", "Count", "usec/op", "sizes/op", "allocs/op" );
+
+    YDialog * dialog = new BenchmarkDialog();
+    manyWidgets( dialog );
+    measureLayout( "many widgets", dialog, 1000 );
+
+    dialog = new BenchmarkDialog();
+    tableManyItems( dialog, itemCount );
+    measureLayout( "table " + std::to_string( itemCount ) + " items", dialog, 100 );
+
+    dialog = new BenchmarkDialog();
+    nested( dialog, depth );
+    measureLayout( "nested depth " + std::to_string( depth ), dialog, 10 );
+
+    return 0;
+}
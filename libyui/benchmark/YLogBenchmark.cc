@@ -0,0 +1,284 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YLogBenchmark.cc
+
+  Micro benchmark for the UI logging: The cost of one yuiDebug() or
+  yuiMilestone() statement if its log level is disabled and if it is
+  enabled, with a logger function that only counts the lines and with the
+  standard logger writing to a log file. Then the same from several
+  threads at once to check that logging scales with the threads and
+  doesn't lose or mix up any lines.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define YUILogComponent "benchmark"
+#include "YUILog.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ **/
+static void measure( const char * name, int count, std::function<void( int )> op )
+{
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	op( i );
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    allocs = allocations - allocs;
+
+    printf( "%-28s %6d %14.3f %12.1f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( allocs ) / count );
+}
+
+
+/**
+ * Run 'op' 'count' times in each of 'threadCount' threads at the same time
+ * and print the time per run, i.e. the wall clock time divided by the
+ * number of runs in all threads.
+ **/
+static void measureThreads( const char * name, int threadCount, int count, std::function<void( int )> op )
+{
+    std::atomic<int> waiting( threadCount );
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int t = 0; t < threadCount; t++ )
+    {
+	threads.emplace_back( [&]()
+	{
+	    // start all threads as close together as possible
+	    --waiting;
+
+	    while ( waiting > 0 )
+		std::this_thread::yield();
+
+	    for ( int i = 0; i < count; ++i )
+		op( i );
+	} );
+    }
+
+    for ( std::thread & thread : threads )
+	thread.join();
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    std::string label = std::string( name ) + ", " + std::to_string( threadCount ) + " threads";
+
+    printf( "%-28s %6d %14.3f\n", label.c_str(), threadCount * count,
+	    std::chrono::duration<double, std::micro>( time ).count() / ( threadCount * count ) );
+}
+
+
+static std::atomic<long> loggedLines( 0 );
+static std::atomic<long> brokenLines( 0 );
+
+/**
+ * Logger function that only counts the lines it gets and checks that they
+ * are complete, i.e. not mixed up with lines from other threads.
+ **/
+static void countingLogger( YUILogLevel_t, const char *, const char *, int, const char *, const char * message )
+{
+    loggedLines.fetch_add( 1, std::memory_order_relaxed );
+
+    if ( strncmp( message, "Creating widget #", 17 ) != 0 || !strstr( message, " in dialog 42" ) )
+	brokenLines.fetch_add( 1, std::memory_order_relaxed );
+}
+
+
+// A typical log statement: a few strings and numbers
+
+static void logDebug( int i )
+{
+    yuiDebug() << "Creating widget #" << i << " in dialog " << 42 << std::endl;
+}
+
+
+static void logMilestone( int i )
+{
+    yuiMilestone() << "Creating widget #" << i << " in dialog " << 42 << std::endl;
+}
+
+
+// The same statement from a component with its own log level
+
+#undef	YUILogComponent
+#define YUILogComponent "benchmark-quiet"
+
+static void logQuietMilestone( int i )
+{
+    yuiMilestone() << "Creating widget #" << i << " in dialog " << 42 << std::endl;
+}
+
+#undef	YUILogComponent
+#define YUILogComponent "benchmark"
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--lines N] [--threads N] [--log-file FILE]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int lineCount   = 100000;
+    int threadCount = std::max( 4U, std::thread::hardware_concurrency() );
+    std::string logFile = "/dev/null";
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--lines" && i + 1 < argc )
+	    lineCount = atoi( argv[ ++i ] );
+	else if ( arg == "--threads" && i + 1 < argc )
+	    threadCount = atoi( argv[ ++i ] );
+	else if ( arg == "--log-file" && i + 1 < argc )
+	    logFile = argv[ ++i ];
+	else
+	    usage( argv[0] );
+    }
+
+    if ( lineCount <= 0 || threadCount <= 0 )
+	usage( argv[0] );
+
+    printf( "%-28s %6s %14s %12s\n", "Log statement", "Count", "usec/op", "allocs/op" );
+
+    YUILog::enableDebugLogging( false );
+    YUILog::setLoggerFunction( countingLogger );
+
+    measure( "debug, disabled", lineCount, logDebug );
+
+    YUILog::setComponentLogLevel( "benchmark-quiet", YUI_LOG_WARNING );
+    measure( "milestone, component quiet", lineCount, logQuietMilestone );
+    YUILog::resetComponentLogLevels();
+
+    if ( loggedLines != 0 )
+    {
+	fprintf( stderr, "%ld disabled lines were logged\n", (long) loggedLines );
+	return 1;
+    }
+
+    YUILog::enableDebugLogging( true );
+    measure( "debug, counting logger", lineCount, logDebug );
+    YUILog::enableDebugLogging( false );
+
+    measure( "milestone, counting logger", lineCount, logMilestone );
+
+    if ( loggedLines != 2L * lineCount )
+    {
+	fprintf( stderr, "%ld lines were logged instead of %ld\n", (long) loggedLines, 2L * lineCount );
+	return 1;
+    }
+
+    YUILog::setLoggerFunction( 0 );
+
+    if ( !YUILog::setLogFileName( logFile ) )
+    {
+	fprintf( stderr, "Can't open log file %s\n", logFile.c_str() );
+	return 1;
+    }
+
+    measure( "milestone, log file", lineCount, logMilestone );
+
+    YUILog::setAsyncLogging( true );
+    measure( "milestone, async log file", lineCount, logMilestone );
+    YUILog::flushLog();
+    YUILog::setAsyncLogging( false );
+
+    // Many threads logging at once
+
+    printf( "\n%-28s %6s %14s\n", "Threads", "Count", "usec/op" );
+
+    YUILog::setLoggerFunction( countingLogger );
+    loggedLines = 0;
+    long expectedLines = 0;
+
+    for ( int threads = 1; threads <= threadCount; threads *= 2 )
+    {
+	measureThreads( "counting logger", threads, lineCount, logMilestone );
+	expectedLines += long( threads ) * lineCount;
+    }
+
+    if ( loggedLines != expectedLines || brokenLines != 0 )
+    {
+	fprintf( stderr, "%ld lines were logged instead of %ld, %ld of them broken\n",
+		 (long) loggedLines, expectedLines, (long) brokenLines );
+	return 1;
+    }
+
+    YUILog::setLoggerFunction( 0 );
+
+    for ( int threads = 1; threads <= threadCount; threads *= 2 )
+	measureThreads( "log file", threads, lineCount, logMilestone );
+
+    YUILog::setAsyncLogging( true );
+
+    for ( int threads = 1; threads <= threadCount; threads *= 2 )
+	measureThreads( "async log file", threads, lineCount, logMilestone );
+
+    YUILog::setAsyncLogging( false );
+
+    return 0;
+}
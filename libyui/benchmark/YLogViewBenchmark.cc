@@ -0,0 +1,187 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YLogViewBenchmark.cc
+
+  Micro benchmark for the line storage of YLogView without any UI:
+  Appending many lines with and without a line limit, and getting and
+  setting the complete log text.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "YLogView.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * A log view without a UI that only counts the display updates.
+ *
+ * The log views are never deleted: The YWidget destructor needs a loaded
+ * UI (YUI::ui()->deleteNotify()).
+ **/
+class BenchmarkLogView : public YLogView
+{
+public:
+
+    BenchmarkLogView( int maxLines )
+	: YLogView( 0, "", 10, maxLines )
+	, fullUpdates( 0 )
+	, appendUpdates( 0 )
+	{}
+
+    virtual int	 preferredWidth()	{ return 10; }
+    virtual int	 preferredHeight()	{ return 10; }
+    virtual void setSize( int, int )	{}
+
+    int fullUpdates;
+    int appendUpdates;
+
+protected:
+
+    virtual void displayLogText( const std::string & )
+	{ fullUpdates++; }
+
+    virtual void displayAppendedLines( const std::vector<std::string> &, bool, int )
+	{ appendUpdates++; }
+};
+
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ **/
+static void measure( const char * name, int count, std::function<void( int )> op )
+{
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	op( i );
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    allocs = allocations - allocs;
+
+    printf( "%-28s %6d %14.2f %12.1f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( allocs ) / count );
+}
+
+
+static std::string logLine( int i )
+{
+    return "Installing package #" + std::to_string( i ) + " (42 MB)\n";
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--lines N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int lineCount = 100000;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--lines" && i + 1 < argc )
+	    lineCount = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( lineCount <= 0 )
+	usage( argv[0] );
+
+    printf( "%d lines\n\n", lineCount );
+    printf( "%-28s %6s %14s %12s\n", "Operation", "Count", "usec/op", "allocs/op" );
+
+    std::vector<std::string> lines;
+
+    for ( int i = 0; i < lineCount; i++ )
+	lines.push_back( logLine( i ) );
+
+    // Appending must not get slower with the size of the log
+
+    BenchmarkLogView * unlimited = new BenchmarkLogView( 0 );
+    measure( "append line", lineCount, [&]( int i ) { unlimited->appendLines( lines[ i ] ); } );
+
+    BenchmarkLogView * limited = new BenchmarkLogView( 1000 );
+    measure( "append line, max 1000", lineCount, [&]( int i ) { limited->appendLines( lines[ i ] ); } );
+
+    std::string text;
+    measure( "logText()", 10, [&]( int ) { text = unlimited->logText(); } );
+
+    BenchmarkLogView * copy = new BenchmarkLogView( 0 );
+    measure( "setLogText()", 10, [&]( int )
+    {
+	copy->clearText();
+	copy->setLogText( text );
+    } );
+
+    if ( unlimited->lines() != lineCount || limited->lines() != std::min( lineCount, 1000 ) ||
+	 unlimited->fullUpdates != 0 || limited->fullUpdates != 0 )
+    {
+	fprintf( stderr, "Appending lines went wrong: %d / %d lines, %d / %d full updates\n",
+		 unlimited->lines(), limited->lines(), unlimited->fullUpdates, limited->fullUpdates );
+	return 1;
+    }
+
+    return 0;
+}
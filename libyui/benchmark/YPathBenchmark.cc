@@ -0,0 +1,222 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YPathBenchmark.cc
+
+  Micro benchmark for finding icons and other files with YPath without
+  any UI: A few hundred lookups in a synthetic icon theme like an
+  application starting up, with the uncached recursive directory walk
+  YPath did before, and with the directory index of YPath the first time
+  and once it is filled.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "YPath.h"
+
+
+/**
+ * A synthetic icon theme in a temporary directory:
+ * <size>/<context>/icon-<context>-<n>.png
+ **/
+struct ThemeTree
+{
+    ThemeTree( int sizes, int contexts, int icons )
+    {
+	char tmpl[] = "/tmp/yui-path-benchmark-XXXXXX";
+
+	if ( mkdtemp( tmpl ) )
+	    dir = tmpl;
+
+	for ( int s = 0; s < sizes && ! dir.empty(); s++ )
+	{
+	    std::string size	= std::to_string( 16 + 8 * s );
+	    std::string sizeDir = dir + "/" + size + "x" + size;
+	    mkdir( sizeDir.c_str(), 0755 );
+
+	    for ( int c = 0; c < contexts; c++ )
+	    {
+		std::string contextDir = sizeDir + "/context" + std::to_string( c );
+		mkdir( contextDir.c_str(), 0755 );
+
+		for ( int i = 0; i < icons; i++ )
+		    std::ofstream( contextDir + "/" + iconName( c, i ) );
+	    }
+	}
+    }
+
+    ~ThemeTree()
+    {
+	if ( ! dir.empty() )
+	    nftw( dir.c_str(), removeFile, 16, FTW_DEPTH | FTW_PHYS );
+    }
+
+    static int removeFile( const char * path, const struct stat *, int, struct FTW * )
+    {
+	return remove( path );
+    }
+
+    static std::string iconName( int context, int n )
+    {
+	return "icon-" + std::to_string( context ) + "-" + std::to_string( n ) + ".png";
+    }
+
+    std::string dir;
+};
+
+
+/**
+ * The uncached recursive lookup YPath did before.
+ **/
+static std::string lookRecursive( const std::string & directory, const std::string & filename )
+{
+    std::vector<std::string> fileList;
+    DIR * dir = opendir( directory.c_str() );
+
+    if ( dir )
+    {
+	while ( struct dirent * ent = readdir( dir ) )
+	    fileList.push_back( ent->d_name );
+
+	closedir( dir );
+    }
+
+    for ( const std::string & name : fileList )
+    {
+	if ( name == "." || name == ".." )
+	    continue;
+
+	std::string fullname = directory + "/" + name;
+
+	if ( name == filename )
+	    return fullname;
+
+	std::string file = lookRecursive( fullname, filename );
+
+	if ( ! file.empty() )
+	    return file;
+    }
+
+    return "";
+}
+
+
+/**
+ * Run 'op' 'count' times and print the time per run and for all of them.
+ **/
+static void measure( const char * name, int count, std::function<void( int )> op )
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	op( i );
+
+    std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+
+    printf( "%-28s %6d %14.2f %12.2f\n", name, count, time.count() / count, time.count() / 1000 );
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--lookups N] [--icons N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    const int sizes    = 8;
+    const int contexts = 10;
+    int lookups	       = 300;
+    int icons	       = 50;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--lookups" && i + 1 < argc )
+	    lookups = atoi( argv[ ++i ] );
+	else if ( arg == "--icons" && i + 1 < argc )
+	    icons = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( lookups <= 0 || icons <= 0 )
+	usage( argv[0] );
+
+    ThemeTree tree( sizes, contexts, icons );
+
+    if ( tree.dir.empty() )
+    {
+	fprintf( stderr, "Can't create a temporary directory\n" );
+	return 1;
+    }
+
+    printf( "%d files\n\n", sizes * contexts * icons );
+    printf( "%-28s %6s %14s %12s\n", "Lookup", "Count", "usec/op", "msec total" );
+
+    std::vector<std::string> names;
+
+    for ( int i = 0; i < lookups; i++ )
+	names.push_back( ThemeTree::iconName( i % contexts, ( i * 7 ) % icons ) );
+
+    std::vector<std::string> expected( lookups );
+    std::vector<std::string> found( lookups );
+    int wrong = 0;
+
+    measure( "recursive walk, uncached", lookups, [&]( int i )
+    {
+	expected[ i ] = lookRecursive( tree.dir, names[ i ] );
+    } );
+
+    YPath::clearCache();
+
+    measure( "YPath, first run", lookups, [&]( int i )
+    {
+	found[ i ] = YPath( tree.dir, names[ i ] ).path();
+    } );
+
+    measure( "YPath, second run", lookups, [&]( int i )
+    {
+	wrong += YPath( tree.dir, names[ i ] ).path() != expected[ i ];
+    } );
+
+    for ( int i = 0; i < lookups; i++ )
+	wrong += found[ i ] != expected[ i ];
+
+    if ( wrong != 0 )
+    {
+	fprintf( stderr, "%d lookups found the wrong file\n", wrong );
+	return 1;
+    }
+
+    return 0;
+}
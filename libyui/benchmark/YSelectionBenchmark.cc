@@ -0,0 +1,323 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YSelectionBenchmark.cc
+
+  Micro benchmark for the item and selection bookkeeping of
+  YSelectionWidget with many items, without any UI: Adding items, selecting
+  them, querying the selection and looking them up by label, and creating
+  table items.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "YSelectionWidget.h"
+#include "YTableItem.h"
+#include "YTreeItem.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * A selection widget without a UI.
+ *
+ * The widgets are never deleted: The YWidget destructor needs a loaded UI
+ * (YUI::ui()->deleteNotify()).
+ **/
+class BenchmarkSelectionWidget : public YSelectionWidget
+{
+public:
+
+    BenchmarkSelectionWidget( bool singleSelection )
+	: YSelectionWidget( 0, "Benchmark", singleSelection )
+	{}
+
+    virtual const char * widgetClass() const { return "BenchmarkSelectionWidget"; }
+    virtual int	 preferredWidth()	     { return 1; }
+    virtual int	 preferredHeight()	     { return 1; }
+    virtual void setSize( int, int )	     {}
+};
+
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ * 'prepare' is called before each run and not measured.
+ **/
+static void measure( const char * name, int count,
+		     std::function<void( int )> op,
+		     std::function<void( int )> prepare = std::function<void( int )>() )
+{
+    unsigned long allocs = 0;
+    std::chrono::steady_clock::duration time( 0 );
+
+    for ( int i = 0; i < count; ++i )
+    {
+	if ( prepare )
+	    prepare( i );
+
+	unsigned long allocs_before = allocations;
+	auto start = std::chrono::steady_clock::now();
+
+	op( i );
+
+	time   += std::chrono::steady_clock::now() - start;
+	allocs += allocations - allocs_before;
+    }
+
+    printf( "%-28s %6d %14.2f %12.1f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( allocs ) / count );
+}
+
+
+static std::string itemLabel( int i )
+{
+    char label[ 80 ];
+    sprintf( label, "Pizza #%06d", i );
+
+    return label;
+}
+
+
+/**
+ * Create 'count' items, every 'selectEvery'th one selected (none if 0).
+ **/
+static YItemCollection items( int count, int selectEvery = 0 )
+{
+    YItemCollection items;
+    items.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+	items.push_back( new YItem( itemLabel( i ), selectEvery && i % selectEvery == 0 ) );
+
+    return items;
+}
+
+
+/**
+ * Create a two level tree with 'count' items in total.
+ **/
+static YItemCollection treeItems( int count )
+{
+    YItemCollection items;
+
+    for ( int i = 0; i < count; i += 100 )
+    {
+	YTreeItem * parent = new YTreeItem( itemLabel( i ) );
+	items.push_back( parent );
+
+	for ( int j = i + 1; j < i + 100 && j < count; j++ )
+	    new YTreeItem( parent, itemLabel( j ) );
+    }
+
+    return items;
+}
+
+
+/**
+ * Create 'count' table items with three columns with the convenience
+ * constructor.
+ **/
+static YItemCollection tableItems( int count )
+{
+    YItemCollection items;
+    items.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+	items.push_back( new YTableItem( std::to_string( i ), itemLabel( i ), "Vegetarian" ) );
+
+    return items;
+}
+
+
+/**
+ * Create 'count' table items with three columns, moving the labels into
+ * the items.
+ **/
+static YItemCollection movedTableItems( int count )
+{
+    YItemCollection items;
+    items.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+	std::vector<std::string> labels;
+	labels.reserve( 3 );
+	labels.push_back( std::to_string( i ) );
+	labels.push_back( itemLabel( i ) );
+	labels.push_back( "Vegetarian" );
+
+	items.push_back( new YTableItem( std::move( labels ) ) );
+    }
+
+    return items;
+}
+
+
+static void deleteItems( YItemCollection & items )
+{
+    for ( YItem * item : items )
+	delete item;
+
+    items.clear();
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--items N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int itemCount = 100000;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--items" && i + 1 < argc )
+	    itemCount = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( itemCount <= 0 )
+	usage( argv[0] );
+
+    printf( "%d items\n\n", itemCount );
+    printf( "%-28s %6s %14s %12s\n", "Operation", "Count", "usec/op", "allocs/op" );
+
+    YItemCollection collection;
+
+    // Single selection
+
+    BenchmarkSelectionWidget * single = new BenchmarkSelectionWidget( true );
+
+    measure( "add items", 1,
+	     [&]( int ) { single->addItems( collection ); },
+	     [&]( int ) { collection = items( itemCount ); } );
+
+    measure( "delete all items", 1, [&]( int ) { single->deleteAllItems(); } );
+
+    measure( "add items, 1% selected", 1,
+	     [&]( int ) { single->addItems( collection ); },
+	     [&]( int ) { collection = items( itemCount, 100 ); } );
+
+    measure( "select item", 1000, [&]( int i )
+    {
+	single->selectItem( single->itemAt( ( i * 7919 ) % itemCount ) );
+    } );
+
+    measure( "selected item", 1000, [&]( int ) { single->selectedItem(); } );
+    measure( "selected items", 1000, [&]( int ) { single->selectedItems(); } );
+
+    measure( "find item", 1000, [&]( int i )
+    {
+	single->findItem( itemLabel( ( i * 7919 ) % itemCount ) );
+    } );
+
+    single->deleteAllItems();
+
+    // Single selection in a tree
+
+    BenchmarkSelectionWidget * tree = new BenchmarkSelectionWidget( true );
+    tree->addItems( treeItems( itemCount ) );
+
+    YItemCollection treeItemsInOrder;
+
+    for ( YItemConstIterator it = tree->itemsBegin(); it != tree->itemsEnd(); ++it )
+    {
+	treeItemsInOrder.push_back( *it );
+	treeItemsInOrder.insert( treeItemsInOrder.end(), (*it)->childrenBegin(), (*it)->childrenEnd() );
+    }
+
+    measure( "select tree item", 1000, [&]( int i )
+    {
+	tree->selectItem( treeItemsInOrder[ ( i * 7919 ) % treeItemsInOrder.size() ] );
+    } );
+
+    measure( "find tree item", 1000, [&]( int i )
+    {
+	tree->findItem( itemLabel( ( i * 7919 ) % itemCount ) );
+    } );
+
+    tree->deleteAllItems();
+
+    // Multi selection
+
+    BenchmarkSelectionWidget * multi = new BenchmarkSelectionWidget( false );
+    multi->addItems( items( itemCount ) );
+
+    measure( "multi: select item", 1000, [&]( int i )
+    {
+	multi->selectItem( multi->itemAt( ( i * 7919 ) % itemCount ) );
+    } );
+
+    measure( "multi: selected items", 10, [&]( int ) { multi->selectedItems(); } );
+    measure( "multi: deselect all items", 1, [&]( int ) { multi->deselectAllItems(); } );
+
+    multi->deleteAllItems();
+
+    // Table items
+
+    measure( "create table items", 1, [&]( int ) { collection = tableItems( itemCount ); } );
+    measure( "delete table items", 1, [&]( int ) { deleteItems( collection ); } );
+    measure( "create moved table items", 1, [&]( int ) { collection = movedTableItems( itemCount ); } );
+    measure( "delete moved table items", 1, [&]( int ) { deleteItems( collection ); } );
+
+    return 0;
+}
@@ -0,0 +1,253 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YUIThreadHandoffBenchmark.cc
+
+  Micro benchmark for handing commands over to the UI thread without any
+  UI: Round trips between the application thread and a UI thread main
+  loop like YUI::uiThreadMainLoop() with YUIThreadHandoff, with the pipes
+  that were used before for comparison, and batches of builtin calls
+  handed over with one round trip.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "YBuiltinCaller.h"
+#include "YUIThreadHandoff.h"
+
+
+class CountingCaller : public YBuiltinCaller
+{
+public:
+
+    CountingCaller() : calls( 0 ) {}
+    virtual void call() { calls++; }
+
+    int calls;
+};
+
+
+/**
+ * Wait for 'fd' like the idle loop of a UI.
+ **/
+static void idleLoop( int fd )
+{
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    while ( poll( &pfd, 1, -1 ) < 1 )
+	;
+}
+
+
+/**
+ * The UI thread main loop like YUI::uiThreadMainLoop(): Handle 'commands'
+ * commands, each a single call of 'caller' or a batch of calls.
+ **/
+static void uiThread( YUIThreadHandoff * handoff, CountingCaller * caller, int commands )
+{
+    while ( commands > 0 )
+    {
+	if ( ! handoff->spinForCommand() )
+	{
+	    if ( handoff->waitingForCommand( true ) )
+		idleLoop( handoff->fd() );
+
+	    handoff->waitingForCommand( false );
+	}
+
+	if ( ! handoff->takeCommand() )
+	    continue;
+
+	YBuiltinCaller * batchCaller = handoff->popCaller();
+
+	if ( batchCaller )
+	{
+	    do {
+		batchCaller->call();
+	    } while ( ( batchCaller = handoff->popCaller() ) );
+	}
+	else
+	    caller->call();
+
+	commands--;
+	handoff->signalDone();
+    }
+}
+
+
+/**
+ * Run 'op' and print the time per round trip and per call.
+ **/
+static void measure( const char * name, int roundTrips, int calls, std::function<void()> op )
+{
+    auto start = std::chrono::steady_clock::now();
+
+    op();
+
+    std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+
+    printf( "%-28s %8d %14.3f %12.3f\n", name, roundTrips,
+	    time.count() / roundTrips, time.count() / calls );
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--round-trips N] [--batch N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int roundTrips = 100000;
+    int batchSize  = 50;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--round-trips" && i + 1 < argc )
+	    roundTrips = atoi( argv[ ++i ] );
+	else if ( arg == "--batch" && i + 1 < argc )
+	    batchSize = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( roundTrips <= 0 || batchSize <= 0 || batchSize > 64 )
+	usage( argv[0] );
+
+    printf( "%-28s %8s %14s %12s\n", "Handoff", "Count", "usec/trip", "usec/call" );
+
+    YUIThreadHandoff handoff;
+
+    if ( ! handoff.init() )
+    {
+	fprintf( stderr, "Can't initialize the thread handoff\n" );
+	return 1;
+    }
+
+    // One builtin call per round trip
+
+    CountingCaller caller;
+
+    measure( "eventfd/futex", roundTrips, roundTrips, [&]()
+    {
+	std::thread thread( uiThread, &handoff, &caller, roundTrips );
+
+	for ( int i = 0; i < roundTrips; i++ )
+	{
+	    handoff.postCommand();
+	    handoff.waitForDone();
+	}
+
+	thread.join();
+    } );
+
+    // The same with the pipes that were used before
+
+    int toUI[2];
+    int fromUI[2];
+
+    if ( pipe( toUI ) != 0 || pipe( fromUI ) != 0 )
+    {
+	fprintf( stderr, "Can't create pipes\n" );
+	return 1;
+    }
+
+    fcntl( toUI[0], F_SETFL, fcntl( toUI[0], F_GETFL ) | O_NONBLOCK );
+
+    CountingCaller pipeCaller;
+    bool pipeError = false;
+
+    measure( "pipes", roundTrips, roundTrips, [&]()
+    {
+	std::thread thread( [&]()
+	{
+	    char byte;
+
+	    for ( int i = 0; i < roundTrips; )
+	    {
+		idleLoop( toUI[0] );
+
+		if ( read( toUI[0], &byte, 1 ) != 1 )
+		    continue;
+
+		pipeCaller.call();
+		i++;
+		pipeError |= write( fromUI[1], &byte, 1 ) != 1;
+	    }
+	} );
+
+	char byte = 42;
+
+	for ( int i = 0; i < roundTrips; i++ )
+	{
+	    pipeError |= write( toUI[1], &byte, 1 ) != 1;
+	    pipeError |= read( fromUI[0], &byte, 1 ) != 1;
+	}
+
+	thread.join();
+    } );
+
+    for ( int fd : { toUI[0], toUI[1], fromUI[0], fromUI[1] } )
+	close( fd );
+
+    // Batches of builtin calls with one round trip each
+
+    int batches = std::max( 1, roundTrips / batchSize );
+    CountingCaller batchCaller;
+    std::string label = "batches of " + std::to_string( batchSize );
+
+    measure( label.c_str(), batches, batches * batchSize, [&]()
+    {
+	std::thread thread( uiThread, &handoff, &caller, batches );
+
+	for ( int i = 0; i < batches; i++ )
+	{
+	    for ( int j = 0; j < batchSize; j++ )
+		handoff.pushCaller( &batchCaller );
+
+	    handoff.postCommand();
+	    handoff.waitForDone();
+	}
+
+	thread.join();
+    } );
+
+    if ( caller.calls != roundTrips || pipeCaller.calls != roundTrips ||
+	 batchCaller.calls != batches * batchSize || pipeError )
+    {
+	fprintf( stderr, "Calls were lost: %d / %d / %d\n", caller.calls, pipeCaller.calls, batchCaller.calls );
+	return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YWidgetTreeBenchmark.cc
+
+  Micro benchmark for the widget tree without any UI: Building a large
+  tree of widgets, walking over it recursively like layout or shortcut
+  checking do, and removing and adding children.
+
+/-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "YWidget.h"
+#include "YChildrenManager.h"
+
+
+//
+// Allocation counting: every operator new in the process goes through here.
+//
+
+static std::atomic<unsigned long> allocations( 0 );
+
+void * operator new( std::size_t size )
+{
+    ++allocations;
+
+    if ( void * ptr = malloc( size ? size : 1 ) )
+	return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void * ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void * ptr, std::size_t ) noexcept
+{
+    free( ptr );
+}
+
+
+
+/**
+ * A container widget without a UI.
+ *
+ * The widgets are never deleted: The YWidget destructor needs a loaded UI
+ * (YUI::ui()->deleteNotify()).
+ **/
+class BenchmarkWidget : public YWidget
+{
+public:
+
+    BenchmarkWidget( YWidget * parent )
+	: YWidget( parent )
+	{ setChildrenManager( new YWidgetChildrenManager( this ) ); }
+
+    virtual const char * widgetClass() const { return "BenchmarkWidget"; }
+    virtual int	 preferredWidth()	     { return 1; }
+    virtual int	 preferredHeight()	     { return 1; }
+    virtual void setSize( int, int )	     {}
+};
+
+
+
+/**
+ * Run 'op' 'count' times and print the time and the allocations per run.
+ **/
+static void measure( const char * name, int count, std::function<void( int )> op )
+{
+    unsigned long allocs = allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for ( int i = 0; i < count; ++i )
+	op( i );
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    allocs = allocations - allocs;
+
+    printf( "%-28s %6d %14.2f %12.1f\n", name, count,
+	    std::chrono::duration<double, std::micro>( time ).count() / count,
+	    double( allocs ) / count );
+}
+
+
+/**
+ * Create a tree of 'count' widgets below 'parent' with 'fanOut' children
+ * per widget.
+ **/
+static void createTree( YWidget * parent, int & count, int fanOut )
+{
+    std::vector<YWidget *> level( 1, parent );
+
+    while ( count > 0 )
+    {
+	std::vector<YWidget *> nextLevel;
+
+	for ( YWidget * widget : level )
+	{
+	    for ( int i = 0; i < fanOut && count > 0; i++, count-- )
+		nextLevel.push_back( new BenchmarkWidget( widget ) );
+	}
+
+	level.swap( nextLevel );
+    }
+}
+
+
+/**
+ * Walk over the tree below 'widget' and count the widgets.
+ **/
+static int walk( const YWidget * widget )
+{
+    int count = 1;
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin(); it != widget->childrenEnd(); ++it )
+	count += walk( *it );
+
+    return count;
+}
+
+
+static void usage( const char * prog )
+{
+    fprintf( stderr, "Usage: %s [--widgets N]\n", prog );
+    exit( 1 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    int widgetCount = 100000;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+	std::string arg = argv[ i ];
+
+	if ( arg == "--widgets" && i + 1 < argc )
+	    widgetCount = atoi( argv[ ++i ] );
+	else
+	    usage( argv[0] );
+    }
+
+    if ( widgetCount <= 0 )
+	usage( argv[0] );
+
+    printf( "%d widgets\n\n", widgetCount );
+    printf( "%-28s %6s %14s %12s\n", "Operation", "Count", "usec/op", "allocs/op" );
+
+    BenchmarkWidget * root = new BenchmarkWidget( 0 );
+    int walked = 0;
+
+    measure( "create tree", 1, [&]( int )
+    {
+	int count = widgetCount;
+	createTree( root, count, 4 );
+    } );
+
+    measure( "walk tree", 10, [&]( int ) { walked = walk( root ); } );
+
+    if ( walked != widgetCount + 1 )
+    {
+	fprintf( stderr, "Walked over %d widgets instead of %d\n", walked, widgetCount + 1 );
+	return 1;
+    }
+
+    // A wide widget, like a layout box with many children
+
+    BenchmarkWidget * wide = new BenchmarkWidget( 0 );
+    std::vector<YWidget *> children;
+
+    measure( "add 1000 children", 1, [&]( int )
+    {
+	for ( int i = 0; i < 1000; i++ )
+	    children.push_back( new BenchmarkWidget( wide ) );
+    } );
+
+    int found = 0;
+    measure( "contains child", 1000, [&]( int i ) { found += wide->contains( children[ ( i * 7919 ) % 1000 ] ); } );
+
+    if ( found != 1000 )
+    {
+	fprintf( stderr, "Found %d children instead of 1000\n", found );
+	return 1;
+    }
+
+    measure( "remove first child", 1000, [&]( int i )
+    {
+	wide->removeChild( children[ i ] );
+    } );
+
+    for ( YWidget * child : children )
+	wide->addChild( child );
+
+    measure( "remove last child", 1000, [&]( int i )
+    {
+	wide->removeChild( children[ 999 - i ] );
+    } );
+
+    return 0;
+}
@@ -22,7 +22,7 @@ Name:           libyui
 Version:        4.0.1
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         bin_name %{name}%{so_version}
 
 BuildRequires:  cmake >= 3.17
@@ -106,6 +106,11 @@ cmake .. \
 make %{?jobs:-j%jobs}
 
 
+%check
+cd build
+make test
+
+
 %install
 cd build
 make install DESTDIR="$RPM_BUILD_ROOT"
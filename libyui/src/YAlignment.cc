@@ -196,7 +196,7 @@ int YAlignment::preferredWidth()
     if ( ! hasChildren() )
 	return minWidth();
 
-    int preferredWidth = firstChild()->preferredWidth();
+    int preferredWidth = firstChild()->cachedPreferredSize( YD_HORIZ );
     preferredWidth    += leftMargin() + rightMargin();
 
     return std::max( minWidth(), preferredWidth );
@@ -208,7 +208,7 @@ int YAlignment::preferredHeight()
     if ( ! hasChildren() )
 	return minHeight();
 
-    int preferredHeight = firstChild()->preferredHeight();
+    int preferredHeight = firstChild()->cachedPreferredSize( YD_VERT );
     preferredHeight    += topMargin() + bottomMargin();
 
     return std::max( minHeight(), preferredHeight );
@@ -242,7 +242,7 @@ void YAlignment::setSize( int newWidth, int newHeight )
     YUIDimension dim = YD_HORIZ;
     while ( true ) // only toggle
     {
-	int childPreferredSize = firstChild()->preferredSize( dim );
+	int childPreferredSize = firstChild()->cachedPreferredSize( dim );
 	int preferredSize      = childPreferredSize + totalMargin[ dim ];
 
 	if ( newSize[ dim ] >= preferredSize )
@@ -0,0 +1,248 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YArena.cc
+
+/-*/
+
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+
+#include "YArena.h"
+
+
+/**
+ * Blocks are handed out in size classes of ArenaGranularity bytes, up to
+ * ArenaSizeClasses * ArenaGranularity bytes. Larger objects always come
+ * from the heap. The granularity is the alignment of anything from the
+ * heap, so every block has it, too.
+ **/
+#define ArenaGranularity	16
+#define ArenaSizeClasses	64
+#define ArenaChunkSize		( 64 * 1024 )
+
+static_assert( ArenaGranularity % alignof( std::max_align_t ) == 0,
+	       "arena blocks have to be aligned like heap memory" );
+
+
+/**
+ * The current arena. It is only read without locking arenaMutex(); the
+ * arenas themselves are protected by it: Items and IDs might be created in
+ * other threads than the UI thread, e.g. while preparing a large list of
+ * items in the background.
+ **/
+static std::atomic<YArena *> currentArena( 0 );
+
+/**
+ * The number of arenas that exist. As long as there are none, which is the
+ * default (see YDialog::setUseArena()), all memory comes from the heap and
+ * goes back there without locking anything.
+ **/
+static std::atomic<int> arenaCount( 0 );
+
+
+static std::mutex &
+arenaMutex()
+{
+    static std::mutex mutex;
+
+    return mutex;
+}
+
+
+/**
+ * The chunks of all arenas by their start address, to find the arena a block
+ * belongs to. Protected by arenaMutex().
+ **/
+static std::map<const char *, YArena *> &
+arenaChunks()
+{
+    static std::map<const char *, YArena *> chunks;
+
+    return chunks;
+}
+
+
+/**
+ * Return the arena whose chunks contain 'ptr' or 0 if it is from the heap.
+ * arenaMutex() has to be locked.
+ **/
+static YArena *
+chunkArena( const void * ptr )
+{
+    std::map<const char *, YArena *> & chunks = arenaChunks();
+    std::map<const char *, YArena *>::const_iterator it = chunks.upper_bound( (const char *) ptr );
+
+    if ( it == chunks.begin() )
+	return 0;
+
+    --it;
+
+    return (const char *) ptr < it->first + ArenaChunkSize ? it->second : 0;
+}
+
+
+static inline size_t
+arenaSizeClass( size_t size )
+{
+    return ( size + ArenaGranularity - 1 ) / ArenaGranularity - 1;
+}
+
+
+
+YArena::YArena()
+    : _freeLists( ArenaSizeClasses, (FreeBlock *) 0 )
+    , _chunkPos( 0 )
+    , _chunkEnd( 0 )
+    , _usedBlocks( 0 )
+    , _released( false )
+{
+    arenaCount++;
+}
+
+
+YArena::~YArena()
+{
+    // arenaMutex() is locked: The last block was just freed or the arena
+    // was released without any in use
+
+    for ( char * chunk : _chunks )
+    {
+	arenaChunks().erase( chunk );
+	::operator delete( chunk );
+    }
+
+    arenaCount--;
+}
+
+
+void
+YArena::release()
+{
+    std::lock_guard<std::mutex> lock( arenaMutex() );
+
+    YArena * self = this;
+    currentArena.compare_exchange_strong( self, 0 );
+
+    _released = true;
+
+    if ( _usedBlocks == 0 )
+	delete this;
+}
+
+
+YArena *
+YArena::current()
+{
+    return currentArena;
+}
+
+
+void
+YArena::setCurrent( YArena * arena )
+{
+    currentArena = arena;
+}
+
+
+void *
+YArena::allocate( size_t size )
+{
+    size_t sizeClass = arenaSizeClass( size );
+
+    if ( currentArena && size > 0 && sizeClass < ArenaSizeClasses )
+    {
+	std::lock_guard<std::mutex> lock( arenaMutex() );
+	YArena * arena = currentArena;	// might have been released meanwhile
+
+	if ( arena )
+	    return arena->allocateBlock( sizeClass, ( sizeClass + 1 ) * ArenaGranularity );
+    }
+
+    return ::operator new( size );
+}
+
+
+void
+YArena::deallocate( void * ptr, size_t size )
+{
+    if ( ! ptr )
+	return;
+
+    if ( arenaCount > 0 )
+    {
+	std::lock_guard<std::mutex> lock( arenaMutex() );
+	YArena * arena = chunkArena( ptr );
+
+	if ( arena )
+	{
+	    arena->freeBlock( ptr, arenaSizeClass( size ) );
+	    return;
+	}
+    }
+
+    ::operator delete( ptr );
+}
+
+
+void *
+YArena::allocateBlock( size_t sizeClass, size_t blockSize )
+{
+    FreeBlock * block = _freeLists[ sizeClass ];
+
+    if ( block )
+    {
+	_freeLists[ sizeClass ] = block->next;
+    }
+    else
+    {
+	if ( (size_t) ( _chunkEnd - _chunkPos ) < blockSize )
+	{
+	    // The rest of the last chunk is left unused
+
+	    _chunks.push_back( 0 ); // first, so the new chunk can't leak
+	    _chunks.back() = (char *) ::operator new( ArenaChunkSize );
+	    arenaChunks().emplace( _chunks.back(), this );
+	    _chunkPos = _chunks.back();
+	    _chunkEnd = _chunkPos + ArenaChunkSize;
+	}
+
+	block = (FreeBlock *) _chunkPos;
+	_chunkPos += blockSize;
+    }
+
+    _usedBlocks++;
+
+    return block;
+}
+
+
+void
+YArena::freeBlock( void * ptr, size_t sizeClass )
+{
+    FreeBlock * block = (FreeBlock *) ptr;
+    block->next = _freeLists[ sizeClass ];
+    _freeLists[ sizeClass ] = block;
+
+    if ( --_usedBlocks == 0 && _released )
+	delete this;
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YArena.h
+
+/-*/
+
+#ifndef YArena_h
+#define YArena_h
+
+#include <stddef.h>
+#include <vector>
+
+
+/**
+ * Pool allocator for the many small objects that make up a dialog: its
+ * widgets, their private data and children managers, items, table cells
+ * and widget IDs.
+ *
+ * A dialog can have an arena of its own (see YDialog::setUseArena()). Those
+ * classes allocate their objects from the arena of the topmost dialog (the
+ * current arena) or from the heap if it doesn't have one. Freed memory goes
+ * back to the arena and is reused for the next objects of the same size
+ * class, e.g. when the content of a replace point is replaced. The memory of
+ * an arena is returned to the heap in bulk when its dialog is destroyed.
+ *
+ * Objects may outlive the dialog whose arena they were allocated from, e.g.
+ * items that the application takes out of a widget: Then the arena is only
+ * deleted when the last of them is freed.
+ *
+ * As long as there is no arena at all, allocate() and deallocate() are
+ * plain heap allocations without any overhead.
+ **/
+class YArena
+{
+public:
+
+    /**
+     * Constructor. The arena belongs to its creator until it calls
+     * release().
+     **/
+    YArena();
+
+    /**
+     * Give up ownership of this arena: It deletes itself as soon as all its
+     * memory is freed, right away if none is in use. If this is the current
+     * arena, there is no current arena any more.
+     *
+     * Don't use this arena afterwards.
+     **/
+    void release();
+
+    /**
+     * Allocate 'size' bytes from the current arena or, if there is none or
+     * 'size' is too large for its size classes, from the heap. This throws
+     * std::bad_alloc if there is not enough memory.
+     *
+     * Memory from here has to be freed with deallocate() with the same
+     * 'size'.
+     **/
+    static void * allocate( size_t size );
+
+    /**
+     * Free memory from allocate() of 'size' bytes. 'ptr' may be 0.
+     **/
+    static void deallocate( void * ptr, size_t size );
+
+    /**
+     * Return the current arena or 0 if there is none.
+     **/
+    static YArena * current();
+
+    /**
+     * Set the current arena. 'arena' may be 0 to allocate from the heap.
+     **/
+    static void setCurrent( YArena * arena );
+
+    /**
+     * Return the number of blocks of this arena that are in use.
+     **/
+    size_t usedBlocks() const { return _usedBlocks; }
+
+    /**
+     * Return the number of chunks this arena got from the heap so far.
+     **/
+    size_t chunkCount() const { return _chunks.size(); }
+
+
+private:
+
+    /**
+     * Destructor. Returns all chunks to the heap. Private since the arena
+     * deletes itself (see release()).
+     **/
+    ~YArena();
+
+    // Disable copying
+    YArena( const YArena & );
+    YArena & operator=( const YArena & );
+
+    /**
+     * Return a block of size class 'sizeClass' and of 'blockSize' bytes.
+     **/
+    void * allocateBlock( size_t sizeClass, size_t blockSize );
+
+    /**
+     * Put a block of size class 'sizeClass' back to its free list.
+     **/
+    void freeBlock( void * block, size_t sizeClass );
+
+
+    struct FreeBlock
+    {
+	FreeBlock * next;
+    };
+
+    std::vector<FreeBlock *>	_freeLists;	// one for each size class
+    std::vector<char *>		_chunks;
+    char *			_chunkPos;	// unused rest of the last chunk
+    char *			_chunkEnd;
+    size_t			_usedBlocks;
+    bool			_released;
+};
+
+
+#endif // YArena_h
@@ -193,15 +193,14 @@ YBarGraph::propertySet()
 
 
 bool
-YBarGraph::setProperty( const string & propertyName, const YPropertyValue & val )
+YBarGraph::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Values )	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Labels )	return false; // Needs special handling
-    else
+    switch ( propertyId )
     {
-	YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Values:	return false; // Needs special handling
+	case YUIPropertyId_Labels:	return false; // Needs special handling
+	default:
+	    YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -209,15 +208,14 @@ YBarGraph::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YBarGraph::getProperty( const string & propertyName )
+YBarGraph::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Values	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Labels	)	return YPropertyValue( YOtherProperty );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Values:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Labels:	return YPropertyValue( YOtherProperty );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
 
@@ -80,6 +80,7 @@ string YBusyIndicator::label()
 void YBusyIndicator::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -131,16 +132,15 @@ YBusyIndicator::propertySet()
 
 
 bool
-YBusyIndicator::setProperty( const string & propertyName, const YPropertyValue & val )
+YBusyIndicator::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Timeout	)	setTimeout( val.integerVal() );
-    else if ( propertyName == YUIProperty_Alive		)	setAlive( val.boolVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Timeout:	setTimeout( val.integerVal() );	break;
+	case YUIPropertyId_Alive:	setAlive( val.boolVal() );	break;
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -148,15 +148,14 @@ YBusyIndicator::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YBusyIndicator::getProperty( const string & propertyName )
+YBusyIndicator::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Timeout	)	return YPropertyValue( timeout() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_Alive		)	return YPropertyValue( alive() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Timeout:	return YPropertyValue( timeout() );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	case YUIPropertyId_Alive:	return YPropertyValue( alive() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -105,22 +105,25 @@ public:
      * Set a property.
      * Reimplemented from YWidget.
      *
-     * This function may throw YUIPropertyExceptions.
+     * The property and the type of 'val' were already checked against
+     * propertySet().
      *
      * This function returns 'true' if the value was successfully set and
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setProperty( YPropertyId propertyId, const YPropertyValue & val );
 
     /**
      * Get a property.
      * Reimplemented from YWidget.
      *
-     * This method may throw YUIPropertyExceptions.
+     * The property was already checked against propertySet().
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getProperty( YPropertyId propertyId );
+
+    using YWidget::setProperty;
+    using YWidget::getProperty;
 
     /**
      * Return this class's property set.
@@ -534,7 +534,7 @@ YButtonBox::maxChildSize( YUIDimension dim ) const
 	  it != childrenEnd();
 	  ++it )
     {
-	maxSize = std::max( maxSize, (*it)->preferredSize( dim ) );
+	maxSize = std::max( maxSize, (*it)->cachedPreferredSize( dim ) );
     }
 
     return maxSize;
@@ -550,7 +550,7 @@ YButtonBox::totalChildrenWidth() const
 	  it != childrenEnd();
 	  ++it )
     {
-	totalWidth += (*it)->preferredWidth();
+	totalWidth += (*it)->cachedPreferredSize( YD_HORIZ );
     }
 
     return totalWidth;
@@ -61,6 +61,7 @@ YCheckBox::~YCheckBox()
 void YCheckBox::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    labelChanged();
 }
 
 
@@ -104,15 +105,14 @@ YCheckBox::propertySet()
 
 
 bool
-YCheckBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YCheckBox::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Value )	return false; // need special processing
-    else if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	return false; // need special processing
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -120,14 +120,13 @@ YCheckBox::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YCheckBox::getProperty( const string & propertyName )
+YCheckBox::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Value )	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
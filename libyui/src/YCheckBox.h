@@ -146,26 +146,22 @@ public:
      * Set a property.
      * Reimplemented from YWidget.
      *
-     * This method may throw exceptions, for example
-     *   - if there is no property with that name
-     *   - if the expected type and the type mismatch
-     *   - if the value is out of range
+     * This method may throw exceptions if the value is out of range.
      *
      * This function returns 'true' if the value was successfully set and
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setProperty( YPropertyId propertyId, const YPropertyValue & val );
 
     /**
      * Get a property.
      * Reimplemented from YWidget.
-     *
-     * This method may throw exceptions, for example
-     *   - if there is no property with that name
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getProperty( YPropertyId propertyId );
+
+    using YWidget::setProperty;
+    using YWidget::getProperty;
 
     /**
      * Return this class's property set.
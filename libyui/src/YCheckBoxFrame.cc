@@ -73,6 +73,7 @@ string YCheckBoxFrame::label() const
 void YCheckBoxFrame::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -137,15 +138,14 @@ YCheckBoxFrame::propertySet()
 
 
 bool
-YCheckBoxFrame::setProperty( const string & propertyName, const YPropertyValue & val )
+YCheckBoxFrame::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Value )	setValue( val.boolVal() );
-    else if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	setValue( val.boolVal() );	break;
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -153,14 +153,13 @@ YCheckBoxFrame::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YCheckBoxFrame::getProperty( const string & propertyName )
+YCheckBoxFrame::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Value )	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( value() );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -0,0 +1,221 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YChildrenList.h
+
+/-*/
+
+#ifndef YChildrenList_h
+#define YChildrenList_h
+
+#include <string.h>
+#include <iterator>
+
+#include "YArena.h"
+
+
+/**
+ * Contiguous list of pointers to children, e.g. child widgets.
+ *
+ * The first few children are stored in the list itself, more in an array
+ * from the current arena (see YArena), so most widgets don't need any
+ * allocation for their children at all, and walking over the children
+ * doesn't have to chase list nodes.
+ *
+ * The iterators are plain pointers. Unlike with a vector, removing a child
+ * never moves the children after it: The children before it are moved
+ * instead. So removing the first child takes constant time, and iterators
+ * to the children after a removed one stay valid. This is what deleting
+ * all children one by one from first to last needs (see
+ * YWidget::deleteChildren()): Every child removes itself from its parent
+ * when it is deleted. Adding a child might move all of them, though, like
+ * with a vector.
+ **/
+template<class T> class YChildrenList
+{
+public:
+
+    typedef T *					value_type;
+    typedef T **				iterator;
+    typedef T * const *				const_iterator;
+    typedef std::reverse_iterator<iterator>	reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    /**
+     * Constructor: Create an empty list.
+     **/
+    YChildrenList()
+	: _storage( _inline )
+	, _first( 0 )
+	, _size( 0 )
+	, _capacity( InlineCapacity )
+	{}
+
+    /**
+     * Copy constructor.
+     **/
+    YChildrenList( const YChildrenList & other )
+	: _storage( _inline )
+	, _first( 0 )
+	, _size( 0 )
+	, _capacity( InlineCapacity )
+	{ assign( other ); }
+
+    /**
+     * Destructor.
+     **/
+    ~YChildrenList()
+	{ freeStorage(); }
+
+    /**
+     * Assignment operator.
+     **/
+    YChildrenList & operator=( const YChildrenList & other )
+    {
+	if ( this != &other )
+	{
+	    clear();
+	    assign( other );
+	}
+
+	return *this;
+    }
+
+    iterator	   begin()		{ return _storage + _first; }
+    iterator	   end()		{ return _storage + _first + _size; }
+    const_iterator begin() const	{ return _storage + _first; }
+    const_iterator end()   const	{ return _storage + _first + _size; }
+
+    reverse_iterator	   rbegin()	  { return reverse_iterator( end() );	       }
+    reverse_iterator	   rend()	  { return reverse_iterator( begin() );       }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator( end() );   }
+    const_reverse_iterator rend()   const { return const_reverse_iterator( begin() ); }
+
+    bool     empty() const { return _size == 0; }
+    unsigned size()  const { return _size; }
+
+    T * front() const { return _storage[ _first ]; }
+    T * back()	const { return _storage[ _first + _size - 1 ]; }
+
+    T * operator[]( unsigned index ) const { return _storage[ _first + index ]; }
+
+    /**
+     * Append a child at the end.
+     **/
+    void push_back( T * child )
+    {
+	if ( _first + _size == _capacity )
+	    makeRoom();
+
+	_storage[ _first + _size++ ] = child;
+    }
+
+    /**
+     * Remove all occurrences of 'child' (like std::list::remove()).
+     * See erase() for the iterators this invalidates.
+     **/
+    void remove( T * child )
+    {
+	for ( iterator it = begin(); it != end(); )
+	{
+	    if ( *it == child )
+		it = erase( it );
+	    else
+		++it;
+	}
+    }
+
+    /**
+     * Remove the child at 'pos' and move the children before it one up.
+     * Return an iterator to the child after the removed one, which didn't
+     * move.
+     *
+     * Unlike with std::list, this invalidates the iterators to all
+     * children before 'pos', not only 'pos' itself.
+     **/
+    iterator erase( iterator pos )
+    {
+	iterator first = begin();
+	memmove( first + 1, first, ( pos - first ) * sizeof( T * ) );
+	_first++;
+	_size--;
+
+	return pos + 1;
+    }
+
+    /**
+     * Remove all children. This keeps the storage.
+     **/
+    void clear()
+    {
+	_first = 0;
+	_size  = 0;
+    }
+
+
+private:
+
+    enum { InlineCapacity = 4 };
+
+    /**
+     * Make room for another child at the end: Move the children to the
+     * start of the storage if at least half of it is free there, otherwise
+     * get storage twice as large.
+     **/
+    void makeRoom()
+    {
+	if ( _first > 0 && _first >= _capacity / 2 )
+	{
+	    memmove( _storage, _storage + _first, _size * sizeof( T * ) );
+	}
+	else
+	{
+	    unsigned capacity = _capacity * 2;
+	    T ** storage = (T **) YArena::allocate( capacity * sizeof( T * ) );
+	    memcpy( storage, _storage + _first, _size * sizeof( T * ) );
+
+	    freeStorage();
+	    _storage  = storage;
+	    _capacity = capacity;
+	}
+
+	_first = 0;
+    }
+
+    void assign( const YChildrenList & other )
+    {
+	for ( const_iterator it = other.begin(); it != other.end(); ++it )
+	    push_back( *it );
+    }
+
+    void freeStorage()
+    {
+	if ( _storage != _inline )
+	    YArena::deallocate( _storage, _capacity * sizeof( T * ) );
+    }
+
+
+    T **	_storage;
+    unsigned	_first;		// index of the first child in _storage
+    unsigned	_size;
+    unsigned	_capacity;
+    T *		_inline[ InlineCapacity ];
+};
+
+
+#endif // YChildrenList_h
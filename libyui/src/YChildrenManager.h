@@ -25,9 +25,10 @@
 #ifndef YChildrenManager_h
 #define YChildrenManager_h
 
-#include <list>
 #include <algorithm>
 #include "YUIException.h"
+#include "YArena.h"
+#include "YChildrenList.h"
 
 
 /**
@@ -52,8 +53,17 @@ public:
      **/
     virtual ~YChildrenManager() {}
 
+    /**
+     * Allocate children managers from the current arena (see YArena).
+     **/
+    static void * operator new( size_t size )
+	{ return YArena::allocate( size ); }
+
+    static void operator delete( void * ptr, size_t size )
+	{ YArena::deallocate( ptr, size ); }
+
 
-    typedef std::list<T *> ChildrenList;
+    typedef YChildrenList<T> ChildrenList;
 
     /**
      * Check if there are any children.
@@ -149,7 +159,7 @@ public:
      **/
     bool contains( T * child ) const
     {
-	return ( find( _children.begin(), _children.end(), child )
+	return ( std::find( _children.begin(), _children.end(), child )
 		 != _children.end() );
     }
 
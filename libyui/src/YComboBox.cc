@@ -199,19 +199,18 @@ YComboBox::propertySet()
 
 
 bool
-YComboBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YComboBox::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Need special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_ValidChars	)	setValidChars( val.stringVal() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	setInputMaxLength( val.integerVal() );
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:		return false; // Need special handling
+	case YUIPropertyId_Items:		return false; // Needs special handling
+	case YUIPropertyId_Label:		setLabel( val.stringVal() );	break;
+	case YUIPropertyId_ValidChars:		setValidChars( val.stringVal() );	break;
+	case YUIPropertyId_InputMaxLength:	setInputMaxLength( val.integerVal() );	break;
+	case YUIPropertyId_IconPath:		setIconBasePath( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -219,18 +218,17 @@ YComboBox::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YComboBox::getProperty( const string & propertyName )
+YComboBox::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_ValidChars	)	return YPropertyValue( validChars() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	return YPropertyValue( inputMaxLength() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Items:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Label:		return YPropertyValue( label() );
+	case YUIPropertyId_ValidChars:		return YPropertyValue( validChars() );
+	case YUIPropertyId_InputMaxLength:	return YPropertyValue( inputMaxLength() );
+	case YUIPropertyId_IconPath:		return YPropertyValue( iconBasePath() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
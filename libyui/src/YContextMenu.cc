@@ -174,16 +174,15 @@ YContextMenu::propertySet()
 
 
 bool
-YContextMenu::setProperty( const string & propertyName, const YPropertyValue & val )
+YContextMenu::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	case YUIPropertyId_Items:	return false; // Needs special handling
+	case YUIPropertyId_IconPath:	setIconBasePath( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -191,15 +190,14 @@ YContextMenu::setProperty( const string & propertyName, const YPropertyValue & v
 
 
 YPropertyValue
-YContextMenu::getProperty( const string & propertyName )
+YContextMenu::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	case YUIPropertyId_Items:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_IconPath:	return YPropertyValue( iconBasePath() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
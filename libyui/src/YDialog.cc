@@ -32,15 +32,30 @@
 #include "YPushButton.h"
 #include "YUI.h"
 #include "YEventFilter.h"
+#include "YDialogObserver.h"
+#include "YWidgetID.h"
+#include "YArena.h"
+
+#include <unordered_map>
 
 #define VERBOSE_DIALOGS			0
 #define VERBOSE_DISCARDED_EVENTS	0
 #define VERBOSE_EVENTS			0
 
 typedef std::list<YEventFilter *> YEventFilterList;
+typedef std::list<YDialogObserver *> YDialogObserverList;
 
 using std::string;
 
+/**
+ * Index of all widgets with an ID in a dialog, keyed by the ID's string
+ * representation. IDs that are equal (YWidgetID::isEqual()) always have the
+ * same string representation, but not necessarily vice versa, so every
+ * candidate still needs to be checked with isEqual().
+ **/
+typedef std::unordered_multimap<string, YWidget *> YWidgetIdIndex;
+
+
 
 struct YDialogPrivate
 {
@@ -53,6 +68,9 @@ struct YDialogPrivate
         , multiPassLayout( false )
         , layoutPass( 0 )
 	, lastEvent( 0 )
+	, widgetsRevision( 0 )
+	, revision( 0 )
+	, arena( 0 )
 	{}
 
     YDialogType		dialogType;
@@ -64,9 +82,27 @@ struct YDialogPrivate
     int                 layoutPass;
     YEvent *		lastEvent;
     YEventFilterList	eventFilterList;
+    YWidgetIdIndex	widgetIdIndex;
+    unsigned long	widgetsRevision;
+    unsigned long	revision;
+    YArena *		arena;
 };
 
 
+static unsigned long lastRevision = 0;
+static bool	     useArenas	  = false;
+
+
+/**
+ * All registered dialog observers.
+ **/
+static YDialogObserverList & dialogObservers()
+{
+    static YDialogObserverList observers;
+    return observers;
+}
+
+
 
 /**
  * Helper class: Event filter that handles "Help" buttons.
@@ -139,8 +175,17 @@ YDialog::YDialog( YDialogType dialogType, YDialogColorMode colorMode )
 {
     YUI_CHECK_NEW( priv );
 
+    priv->widgetsRevision = ++lastRevision;
+    priv->revision	  = priv->widgetsRevision;
     _dialogStack.push( this );
 
+    // Widgets are usually created for the topmost dialog
+
+    if ( useArenas )
+	priv->arena = new YArena();
+
+    YArena::setCurrent( priv->arena );
+
 #if VERBOSE_DIALOGS
     yuiDebug() << "New " << this << endl;
 #endif
@@ -176,12 +221,21 @@ YDialog::~YDialog()
     if ( ! _dialogStack.empty() && _dialogStack.top() == this )
     {
 	_dialogStack.pop();
+	YArena::setCurrent( _dialogStack.empty() ? 0 : _dialogStack.top()->priv->arena );
 
 	if ( ! _dialogStack.empty() )
 	    _dialogStack.top()->activate();
     }
     else
 	yuiError() << "Not top of dialog stack: " << this << endl;
+
+    // The arena is deleted as soon as nothing allocated from it is left
+
+    if ( priv->arena )
+	priv->arena->release();
+
+    for ( YDialogObserver * observer : dialogObservers() )
+	observer->dialogClosed( this );
 }
 
 
@@ -196,6 +250,9 @@ YDialog::open()
     openInternal();	// Make sure this is only called once!
 
     priv->isOpen = true;
+
+    for ( YDialogObserver * observer : dialogObservers() )
+	observer->dialogOpened( this );
 }
 
 
@@ -234,6 +291,144 @@ YDialog::deleteEventFilters()
 }
 
 
+void
+YDialog::addToWidgetIdIndex( YWidget * widget )
+{
+    if ( widget->id() )
+	priv->widgetIdIndex.insert( std::make_pair( widget->id()->toString(), widget ) );
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	addToWidgetIdIndex( *it );
+    }
+}
+
+
+void
+YDialog::removeFromWidgetIdIndex( YWidget * widget, bool recursive )
+{
+    if ( widget->id() )
+    {
+	auto range = priv->widgetIdIndex.equal_range( widget->id()->toString() );
+
+	for ( auto it = range.first; it != range.second; ++it )
+	{
+	    if ( it->second == widget )
+	    {
+		priv->widgetIdIndex.erase( it );
+		break;
+	    }
+	}
+    }
+
+    if ( ! recursive )
+	return;
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	removeFromWidgetIdIndex( *it );
+    }
+}
+
+
+unsigned long
+YDialog::widgetsRevision() const
+{
+    return priv->widgetsRevision;
+}
+
+
+void
+YDialog::widgetsChanged( YWidget * widget )
+{
+    priv->widgetsRevision = ++lastRevision;
+    priv->revision	  = priv->widgetsRevision;
+
+    for ( YDialogObserver * observer : dialogObservers() )
+	observer->dialogChanged( this, widget );
+}
+
+
+unsigned long
+YDialog::revision() const
+{
+    return priv->revision;
+}
+
+
+void
+YDialog::contentChanged()
+{
+    priv->revision = ++lastRevision;
+}
+
+
+void
+YDialog::propertyChanged( YWidget * widget )
+{
+    priv->revision = ++lastRevision;
+
+    for ( YDialogObserver * observer : dialogObservers() )
+	observer->dialogChanged( this, widget );
+}
+
+
+void
+YDialog::addObserver( YDialogObserver * observer )
+{
+    dialogObservers().push_back( observer );
+}
+
+
+void
+YDialog::removeObserver( YDialogObserver * observer )
+{
+    dialogObservers().remove( observer );
+}
+
+
+YWidget *
+YDialog::lookupWidgetId( YWidgetID * id, const YWidget * ancestor, bool & ambiguous ) const
+{
+    YWidget * found = 0;
+    ambiguous	    = false;
+
+    auto range = priv->widgetIdIndex.equal_range( id->toString() );
+
+    for ( auto it = range.first; it != range.second; ++it )
+    {
+	YWidget * widget = it->second;
+
+	if ( ! widget->id()->isEqual( id ) )
+	    continue;
+
+	// Only widgets below 'ancestor' count
+
+	const YWidget * parent = widget->parent();
+
+	while ( parent && parent != ancestor )
+	    parent = parent->parent();
+
+	if ( ! parent )
+	    continue;
+
+	if ( found )
+	{
+	    ambiguous = true;
+	    return 0;
+	}
+
+	found = widget;
+    }
+
+    return found;
+}
+
+
 bool
 YDialog::destroy( bool doThrow )
 {
@@ -364,18 +559,41 @@ void
 YDialog::doLayout()
 {
     priv->layoutPass = 1;
-    setSize( preferredWidth(), preferredHeight() );
+    doLayoutPass();
 
     if ( priv->multiPassLayout )
     {
         priv->layoutPass = 2;
-        setSize( preferredWidth(), preferredHeight() );
+        doLayoutPass();
     }
 
     priv->layoutPass = 0;
 }
 
 
+void
+YDialog::doLayoutPass()
+{
+    // Preferred sizes are memoized during this pass (see
+    // YWidget::cachedPreferredSize()) so each widget computes them only once
+    // even in deeply nested layouts.
+
+    startLayoutPass();
+
+    try
+    {
+        setSize( cachedPreferredSize( YD_HORIZ ), cachedPreferredSize( YD_VERT ) );
+    }
+    catch ( ... )
+    {
+        endLayoutPass();
+        throw;
+    }
+
+    endLayoutPass();
+}
+
+
 int
 YDialog::layoutPass() const
 {
@@ -419,6 +637,9 @@ YDialog::waitForEvent( int timeout_millisec )
 
     priv->lastEvent = event;
 
+    for ( YDialogObserver * observer : dialogObservers() )
+	observer->eventReturned( this, event );
+
     return event;
 }
 
@@ -439,6 +660,12 @@ YDialog::pollEvent()
 
     priv->lastEvent = event;
 
+    if ( event )
+    {
+	for ( YDialogObserver * observer : dialogObservers() )
+	    observer->eventReturned( this, event );
+    }
+
     // Nevermind if filterInvalidEvents() discarded an invalid event.
     // pollInput() is normally called very often (in a loop), and most of the
     // times it returns 0 anyway, so there is no need to care for just another
@@ -597,6 +824,20 @@ YDialog::deleteTo( YDialog * targetDialog )
 }
 
 
+void
+YDialog::setUseArena( bool useArena )
+{
+    useArenas = useArena;
+}
+
+
+bool
+YDialog::useArena()
+{
+    return useArenas;
+}
+
+
 int
 YDialog::openDialogsCount()
 {
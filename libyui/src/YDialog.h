@@ -35,6 +35,7 @@ class YPushButton;
 class YDialogPrivate;
 class YEvent;
 class YEventFilter;
+class YDialogObserver;
 
 // See YTypes.h for enum YDialogType and enum YDialogColorMode
 
@@ -164,6 +165,43 @@ public:
      **/
     int layoutPass() const;
 
+    /**
+     * Return a number that changes whenever widgets are added to or removed
+     * from this dialog or get a new ID or label, i.e. whenever searching this
+     * dialog for widgets might give a different result than before.
+     *
+     * The number is unique among all dialogs, so it also tells dialogs apart
+     * that happen to be created at the same address.
+     **/
+    unsigned long widgetsRevision() const;
+
+    /**
+     * Return a number that changes whenever the content of this dialog
+     * changed: Whenever the widgets revision changes (see
+     * widgetsRevision()), whenever a property of a widget is set via
+     * YWidget::setProperty(), and whenever contentChanged() is called.
+     *
+     * Waiting for events and UI calls do not change it by themselves. Other
+     * changes of the widgets, e.g. by user input or by calling widget
+     * methods directly, are reported by the UI via contentChanged().
+     *
+     * This is intended for caching snapshots of the dialog, e.g. in the
+     * REST API. Like widgets revisions, revisions are unique among all
+     * dialogs.
+     **/
+    unsigned long revision() const;
+
+    /**
+     * Notify this dialog that its content changed without
+     * YWidget::setProperty(), e.g. when a widget of the UI is redrawn after
+     * user input or after a direct call of a widget method.
+     *
+     * This only changes the revision, e.g. to invalidate a cached snapshot.
+     * The dialog observers are not notified: They only hear about actual
+     * changes of the widgets (see YDialogObserver::dialogChanged()).
+     **/
+    void contentChanged();
+
     /**
      * Close and delete this dialog (and all its children) if it is the topmost
      * dialog. If this is not the topmost dialog, this will throw an exception
@@ -222,6 +260,23 @@ public:
     static YDialog * topmostDialog( bool doThrow = true )
 	{ return currentDialog( doThrow ); }
 
+    /**
+     * Set whether dialogs that are created from now on get an arena of their
+     * own (see YArena): Their widgets, items and widget IDs are then
+     * allocated from a pool that is reused while the dialog exists and that
+     * is returned to the heap in bulk when the dialog is destroyed. This
+     * helps with large dialogs that are opened and closed often.
+     *
+     * The default is 'false'.
+     **/
+    static void setUseArena( bool useArena );
+
+    /**
+     * Return whether dialogs that are created from now on get an arena of
+     * their own.
+     **/
+    static bool useArena();
+
     /**
      * Set the initial dialog size, depending on dialogType:
      * YMainDialog dialogs get the UI's "default main window" size,
@@ -405,6 +460,12 @@ protected:
      **/
     void doLayout();
 
+    /**
+     * One pass of doLayout(): Query the preferred size of the dialog and set
+     * it for the dialog and all widgets.
+     **/
+    void doLayoutPass();
+
     /**
      * Wait for a user event.
      *
@@ -443,6 +504,58 @@ protected:
 
 private:
 
+    friend class YWidget;
+    friend class YDialogObserver;
+
+    /**
+     * Add 'widget' and all its descendants that have an ID to the widget ID
+     * index of this dialog. This is called by YWidget whenever a widget is
+     * added to this dialog or gets an ID.
+     **/
+    void addToWidgetIdIndex( YWidget * widget );
+
+    /**
+     * Remove 'widget' and all its descendants from the widget ID index of
+     * this dialog. This is called by YWidget whenever a widget is removed
+     * from this dialog, destroyed or gets a new ID.
+     *
+     * If 'recursive' is false, only 'widget' itself is removed and its
+     * children are not touched. The YWidget destructor needs that: Its
+     * children are already gone then.
+     **/
+    void removeFromWidgetIdIndex( YWidget * widget, bool recursive = true );
+
+    /**
+     * Look up 'id' in the widget ID index and return the matching widget
+     * below 'ancestor' (not 'ancestor' itself) or 0 if there is none.
+     *
+     * If there is more than one matching widget below 'ancestor',
+     * 'ambiguous' is set to 'true' and 0 is returned: The caller will then
+     * have to search the widget tree to find the first one.
+     **/
+    YWidget * lookupWidgetId( YWidgetID *	id,
+			      const YWidget *	ancestor,
+			      bool &		ambiguous ) const;
+
+    /**
+     * Change the widgets revision. This is called by YWidget with the
+     * widget that changed (see YDialogObserver::dialogChanged()).
+     **/
+    void widgetsChanged( YWidget * widget );
+
+    /**
+     * Change the revision and notify the observers that a property of
+     * 'widget' changes. This is called by YWidget::setProperty().
+     **/
+    void propertyChanged( YWidget * widget );
+
+    /**
+     * Register or unregister a dialog observer. This is called by
+     * YDialogObserver.
+     **/
+    static void addObserver( YDialogObserver * observer );
+    static void removeObserver( YDialogObserver * observer );
+
     ImplPtr<YDialogPrivate> priv;
 };
 
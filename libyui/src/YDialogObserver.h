@@ -0,0 +1,92 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YDialogObserver.h
+
+/-*/
+
+#ifndef YDialogObserver_h
+#define YDialogObserver_h
+
+
+class YDialog;
+class YEvent;
+class YWidget;
+
+
+/**
+ * Abstract base class to watch all dialogs, e.g. to notify remote clients
+ * about changes.
+ *
+ * Unlike a YEventFilter, an observer is not related to a specific dialog and
+ * it cannot change anything: It is only informed when a dialog is opened or
+ * closed, when it returns an event to the application and when its content
+ * might have changed.
+ *
+ * An observer registers itself in its constructor and unregisters itself in
+ * its destructor. It is not owned by any dialog. All methods are called in
+ * the UI thread.
+ **/
+class YDialogObserver
+{
+protected:
+    /**
+     * Constructor. This registers the observer.
+     **/
+    YDialogObserver();
+
+public:
+    /**
+     * Destructor. This unregisters the observer.
+     **/
+    virtual ~YDialogObserver();
+
+    /**
+     * A dialog has been opened (see YDialog::open()).
+     **/
+    virtual void dialogOpened( YDialog * dialog ) {}
+
+    /**
+     * A dialog has been deleted. 'dialog' must only be used to identify
+     * the dialog, it is already destroyed.
+     **/
+    virtual void dialogClosed( YDialog * dialog ) {}
+
+    /**
+     * YDialog::waitForEvent() or YDialog::pollEvent() returns 'event' to the
+     * application.
+     **/
+    virtual void eventReturned( YDialog * dialog, const YEvent * event ) {}
+
+    /**
+     * A widget of a dialog has changed, so the revision of the dialog has
+     * changed, too (see YDialog::revision()).
+     *
+     * 'widget' is the widget whose label or ID has changed, whose children
+     * have been added or removed, or one of whose properties is changed via
+     * YWidget::setProperty(). It is 0 if it is already being destroyed.
+     *
+     * This is not called for the changes that only might have happened,
+     * e.g. whenever the UI handles user input (see
+     * YDialog::contentChanged()).
+     **/
+    virtual void dialogChanged( YDialog * dialog, YWidget * widget ) {}
+};
+
+
+#endif // YDialogObserver_h
@@ -676,7 +676,7 @@ void YDialogSpyPrivate::moveSelected(Direction direction)
 	// the first child cannot be moved further
 	if (target_widget == parent->firstChild()) return;
 
-	auto i = find( parent->childrenBegin(), parent->childrenEnd(), target_widget );
+	auto i = std::find( parent->childrenBegin(), parent->childrenEnd(), target_widget );
 	if (i != parent->childrenEnd())
 	{
 	    // swap with the preceeding widget
@@ -691,7 +691,7 @@ void YDialogSpyPrivate::moveSelected(Direction direction)
 	// the last child cannot be moved further to the end
 	if (target_widget == parent->lastChild()) return;
 
-	auto i = find( parent->childrenBegin(), parent->childrenEnd(), target_widget );
+	auto i = std::find( parent->childrenBegin(), parent->childrenEnd(), target_widget );
 	if (i != parent->childrenEnd())
 	{
 	    // swap with the succeeding widget
@@ -81,6 +81,7 @@ void
 YDownloadProgress::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -166,16 +167,15 @@ YDownloadProgress::propertySet()
 
 
 bool
-YDownloadProgress::setProperty( const string & propertyName, const YPropertyValue & val )
+YDownloadProgress::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if ( propertyName == YUIProperty_Label 		)	setLabel       ( val.stringVal()  );
-    if ( propertyName == YUIProperty_Filename		)	setFilename    ( val.stringVal()  );
-    if ( propertyName == YUIProperty_ExpectedSize	)	setExpectedSize( val.integerVal() );
-    else
+    switch ( propertyId )
     {
-	YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Label:		setLabel       ( val.stringVal()  );	break;
+	case YUIPropertyId_Filename:		setFilename    ( val.stringVal()  );	break;
+	case YUIPropertyId_ExpectedSize:	setExpectedSize( val.integerVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -183,17 +183,16 @@ YDownloadProgress::setProperty( const string & propertyName, const YPropertyValu
 
 
 YPropertyValue
-YDownloadProgress::getProperty( const string & propertyName )
+YDownloadProgress::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if ( propertyName == YUIProperty_Label 		)	return YPropertyValue( label() 		);
-    if ( propertyName == YUIProperty_Filename		)	return YPropertyValue( filename() 	);
-    if ( propertyName == YUIProperty_ExpectedSize	)	return YPropertyValue( expectedSize() 	);
-    if ( propertyName == YUIProperty_CurrentSize	)	return YPropertyValue( currentFileSize());
-    if ( propertyName == YUIProperty_Value		)	return YPropertyValue( currentPercent() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Label:		return YPropertyValue( label() 		);
+	case YUIPropertyId_Filename:		return YPropertyValue( filename() 	);
+	case YUIPropertyId_ExpectedSize:	return YPropertyValue( expectedSize() 	);
+	case YUIPropertyId_CurrentSize:		return YPropertyValue( currentFileSize());
+	case YUIPropertyId_Value:		return YPropertyValue( currentPercent() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
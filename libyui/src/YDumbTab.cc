@@ -121,16 +121,15 @@ YDumbTab::propertySet()
 
 
 bool
-YDumbTab::setProperty( const string & propertyName, const YPropertyValue & val )
+YDumbTab::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	return false; // Needs special handling
+	case YUIPropertyId_CurrentItem:	return false; // Needs special handling
+	case YUIPropertyId_Items:	return false; // Needs special handling
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -138,15 +137,14 @@ YDumbTab::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YDumbTab::getProperty( const string & propertyName )
+YDumbTab::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_CurrentItem:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Items:	return YPropertyValue( YOtherProperty );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -23,7 +23,6 @@
 /-*/
 
 
-
 #define YUILogComponent "ui-events"
 #include "YUILog.h"
 
@@ -37,6 +36,123 @@ using std::string;
 unsigned long YEvent::_nextSerial = 0;
 
 
+/**
+ * Pool of recycled event memory: One free list for each size class of
+ * EventPoolGranularity bytes. Larger events are not pooled.
+ *
+ * Each thread has its own pool, so no locking is needed. An event that is
+ * deleted in another thread than the one that created it simply goes to
+ * the pool of the deleting thread.
+ *
+ * This is a plain struct without a destructor, so it can still be used
+ * while the thread exits; YEventPoolCleanup returns the memory to the heap
+ * then and closes the pool.
+ **/
+#define EventPoolGranularity	16
+#define EventPoolSizeClasses	8
+#define EventPoolMaxFree	64	// per size class and thread
+
+struct YEventPool
+{
+    struct FreeBlock
+    {
+	FreeBlock * next;
+    };
+
+    FreeBlock *	freeList [ EventPoolSizeClasses ];
+    int		freeCount[ EventPoolSizeClasses ];
+    bool	cleanupRegistered;
+    bool	closed;
+};
+
+
+static thread_local YEventPool eventPool;	// zero-initialized
+
+
+struct YEventPoolCleanup
+{
+    ~YEventPoolCleanup()
+    {
+	for ( int i=0; i < EventPoolSizeClasses; i++ )
+	{
+	    while ( YEventPool::FreeBlock * block = eventPool.freeList[i] )
+	    {
+		eventPool.freeList[i] = block->next;
+		::operator delete( block );
+	    }
+
+	    eventPool.freeCount[i] = 0;
+	}
+
+	eventPool.closed = true;
+    }
+};
+
+
+static inline size_t
+eventPoolSizeClass( size_t size )
+{
+    return ( size + EventPoolGranularity - 1 ) / EventPoolGranularity - 1;
+}
+
+
+void *
+YEvent::operator new( size_t size )
+{
+    size_t sizeClass = eventPoolSizeClass( size );
+
+    if ( sizeClass < EventPoolSizeClasses )
+    {
+	YEventPool::FreeBlock * block = eventPool.freeList[ sizeClass ];
+
+	if ( block )
+	{
+	    eventPool.freeList [ sizeClass ] = block->next;
+	    eventPool.freeCount[ sizeClass ]--;
+
+	    return block;
+	}
+
+	size = ( sizeClass + 1 ) * EventPoolGranularity;
+    }
+
+    return ::operator new( size );
+}
+
+
+void
+YEvent::operator delete( void * ptr, size_t size )
+{
+    if ( ! ptr )
+	return;
+
+    size_t sizeClass = eventPoolSizeClass( size );
+
+    if ( sizeClass < EventPoolSizeClasses
+	 && ! eventPool.closed
+	 && eventPool.freeCount[ sizeClass ] < EventPoolMaxFree )
+    {
+	if ( ! eventPool.cleanupRegistered )
+	{
+	    // Constructed on first use in this thread, destroyed when it exits
+	    static thread_local YEventPoolCleanup cleanup;
+	    (void) cleanup;
+
+	    eventPool.cleanupRegistered = true;
+	}
+
+	YEventPool::FreeBlock * block = (YEventPool::FreeBlock *) ptr;
+	block->next = eventPool.freeList[ sizeClass ];
+	eventPool.freeList [ sizeClass ] = block;
+	eventPool.freeCount[ sizeClass ]++;
+
+	return;
+    }
+
+    ::operator delete( ptr );
+}
+
+
 YEvent::YEvent( EventType eventType )
     : _eventType( eventType )
 {
@@ -30,6 +30,7 @@
 #include <iosfwd>
 #include "YDialog.h"
 #include "YSimpleEventHandler.h"
+#include "YEventQueue.h"
 
 class YWidget;
 class YItem;
@@ -121,6 +122,19 @@ public:
      **/
     static const char * toString( EventReason reason );
 
+    /**
+     * Allocate memory for an event. Events are sent and deleted in large
+     * numbers, so the memory of deleted events is recycled for new ones of
+     * the same size class rather than returned to the heap. Each thread
+     * recycles the events it deletes, so this needs no locking.
+     **/
+    static void * operator new( size_t size );
+
+    /**
+     * Free the memory of an event (see operator new() ).
+     **/
+    static void operator delete( void * ptr, size_t size );
+
 
 protected:
 
@@ -148,6 +162,7 @@ private:
 
     friend void YDialog::deleteEvent( YEvent * event );
     friend void YSimpleEventHandler::deleteEvent( YEvent * event );
+    friend void YEventQueue::deleteEvent( YEvent * event );
 
 
     //
@@ -0,0 +1,314 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YEventQueue.cc
+
+/-*/
+
+
+#define YUILogComponent "ui-events"
+#include "YUILog.h"
+
+#include "YEvent.h"
+#include "YEventQueue.h"
+
+
+#define VERBOSE_EVENTS	0
+#define VERBOSE_BLOCK	0
+
+
+YEventQueue::YEventQueue( int capacity )
+    : _ring( capacity > 0 ? capacity : 1, (YEvent *) 0 )
+    , _first( 0 )
+    , _count( 0 )
+    , _eventsBlocked( false )
+    , _pendingTimeout( 0 )
+    , _mergedEvents( 0 )
+    , _discardedEvents( 0 )
+{
+    _pendingValueChanged.reserve( _ring.size() );
+}
+
+
+YEventQueue::~YEventQueue()
+{
+    clear();
+}
+
+
+void YEventQueue::clear()
+{
+#if VERBOSE_EVENTS
+    if ( _count > 0 )
+	yuiDebug() << "Clearing " << _count << " pending events" << endl;
+#endif
+
+    while ( _count > 0 )
+	deleteEvent( takeFirst() );
+}
+
+
+YEvent * YEventQueue::pendingEvent() const
+{
+    return _count > 0 ? at( 0 ) : 0;
+}
+
+
+YEvent * YEventQueue::consumePendingEvent()
+{
+    if ( _count == 0 )
+	return 0;
+
+    YEvent * event = takeFirst();
+
+#if VERBOSE_EVENTS
+    yuiDebug() << "Consuming " << event << endl;
+#endif
+
+    return event;
+}
+
+
+int YEventQueue::consumePendingEvents( std::vector<YEvent *> & events, int maxEvents )
+{
+    int count = _count;
+
+    if ( maxEvents > 0 && maxEvents < count )
+	count = maxEvents;
+
+    events.reserve( events.size() + count );
+
+    for ( int i=0; i < count; i++ )
+	events.push_back( takeFirst() );
+
+    return count;
+}
+
+
+YEvent * YEventQueue::takeFirst()
+{
+    YEvent * event = at( 0 );
+    at( 0 ) = 0;
+
+    _first = ( _first + 1 ) % _ring.size();
+    _count--;
+
+    forget( event );
+
+    return event;
+}
+
+
+void YEventQueue::forget( YEvent * event )
+{
+    if ( event == _pendingTimeout )
+	_pendingTimeout = 0;
+
+    YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *> (event);
+
+    if ( widgetEvent && widgetEvent->reason() == YEvent::ValueChanged )
+    {
+	int index = findValueChanged( widgetEvent->widget() );
+
+	if ( index >= 0 && _pendingValueChanged[ index ].second == event )
+	{
+	    _pendingValueChanged[ index ] = _pendingValueChanged.back();
+	    _pendingValueChanged.pop_back();
+	}
+    }
+}
+
+
+int YEventQueue::findValueChanged( YWidget * widget ) const
+{
+    for ( size_t i=0; i < _pendingValueChanged.size(); i++ )
+    {
+	if ( _pendingValueChanged[i].first == widget )
+	    return i;
+    }
+
+    return -1;
+}
+
+
+YEvent * YEventQueue::mergeCandidate( YEvent * event ) const
+{
+    if ( event->eventType() == YEvent::TimeoutEvent )
+	return _pendingTimeout;
+
+    YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *> (event);
+
+    if ( widgetEvent && widgetEvent->reason() == YEvent::ValueChanged )
+    {
+	int index = findValueChanged( widgetEvent->widget() );
+
+	if ( index >= 0 )
+	    return _pendingValueChanged[ index ].second;
+    }
+
+    return 0;
+}
+
+
+void YEventQueue::sendEvent( YEvent * event )
+{
+    if ( ! event )
+    {
+	yuiError() << "Ignoring NULL event" << endl;
+	return;
+    }
+
+    if ( eventsBlocked() )
+    {
+#if VERBOSE_BLOCK
+	yuiDebug() << "Blocking " << event << endl;
+#endif
+	// Avoid memory leak: The event handler assumes ownership of the newly
+	// created event, so we have to clean it up here.
+	deleteEvent( event );
+
+	return;
+    }
+
+    if ( mergeCandidate( event ) )
+    {
+#if VERBOSE_EVENTS
+	yuiDebug() << "Merging " << event << " with " << mergeCandidate( event ) << endl;
+#endif
+	_mergedEvents++;
+	deleteEvent( event );
+
+	return;
+    }
+
+    if ( _count == (int) _ring.size() )
+    {
+	YEvent * oldest = takeFirst();
+	yuiWarning() << "Event queue full - discarding " << oldest << endl;
+
+	_discardedEvents++;
+	deleteEvent( oldest );
+    }
+
+#if VERBOSE_EVENTS
+    yuiDebug() << "New pending event: " << event << endl;
+#endif
+
+    at( _count++ ) = event;
+
+    if ( event->eventType() == YEvent::TimeoutEvent )
+	_pendingTimeout = event;
+    else
+    {
+	YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *> (event);
+
+	if ( widgetEvent && widgetEvent->reason() == YEvent::ValueChanged )
+	    _pendingValueChanged.push_back( std::make_pair( widgetEvent->widget(), event ) );
+    }
+}
+
+
+bool
+YEventQueue::eventPendingFor( YWidget * widget ) const
+{
+    return pendingEventFor( widget ) != 0;
+}
+
+
+YWidgetEvent *
+YEventQueue::pendingEventFor( YWidget * widget ) const
+{
+    for ( int i = _count - 1; i >= 0; i-- )
+    {
+	YWidgetEvent * event = dynamic_cast<YWidgetEvent *> ( at( i ) );
+
+	if ( event && event->widget() == widget )
+	    return event;
+    }
+
+    return 0;
+}
+
+
+template<typename Predicate>
+void YEventQueue::deleteEvents( Predicate pred )
+{
+    int kept = 0;
+
+    for ( int i=0; i < _count; i++ )
+    {
+	YEvent * event = at( i );
+
+	if ( pred( event ) )
+	{
+	    forget( event );
+	    at( i ) = 0;
+
+	    yuiDebug() << "Deleting " << event << endl;
+	    deleteEvent( event );
+	}
+	else
+	{
+	    at( i )    = 0;
+	    at( kept++ ) = event;
+	}
+    }
+
+    _count = kept;
+}
+
+
+void YEventQueue::deletePendingEventsFor( YWidget * widget )
+{
+    deleteEvents( [widget]( YEvent * event )
+		  {
+		      YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *> (event);
+
+		      return widgetEvent && widgetEvent->widget() == widget && widgetEvent->isValid();
+		  } );
+}
+
+
+void YEventQueue::blockEvents( bool block )
+{
+#if VERBOSE_BLOCK
+    if ( block )	yuiDebug() << "Blocking events"   << endl;
+    else		yuiDebug() << "Unblocking events" << endl;
+#endif
+
+    _eventsBlocked = block;
+}
+
+
+void YEventQueue::deleteEvent( YEvent * event )
+{
+    if ( event )
+    {
+	if ( event->isValid() )
+	{
+#if VERBOSE_EVENTS
+	    yuiDebug() << "Deleting " << event << endl;
+#endif
+	    delete event;
+	}
+	else
+	{
+	    yuiError() << "Attempt to delete invalid event " << event << endl;
+	}
+    }
+}
@@ -0,0 +1,227 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YEventQueue.h
+
+/-*/
+
+#ifndef YEventQueue_h
+#define YEventQueue_h
+
+#include <utility>
+#include <vector>
+
+
+class YEvent;
+class YWidget;
+class YWidgetEvent;
+
+
+/**
+ * Event handler that queues events in a bounded FIFO instead of keeping only
+ * the last one like YSimpleEventHandler. It has the same interface, so a UI
+ * can use either one.
+ *
+ * Redundant events are merged when they are sent:
+ *
+ * - A ValueChanged YWidgetEvent for a widget that already has a pending
+ *   ValueChanged event is dropped: The application will query the current
+ *   value anyway.
+ *
+ * - A YTimeoutEvent is dropped if there already is a pending one.
+ *
+ * If the queue is full, the oldest event is discarded.
+ **/
+class YEventQueue
+{
+public:
+
+    /**
+     * Constructor. 'capacity' is the maximum number of pending events.
+     **/
+    YEventQueue( int capacity = 256 );
+
+    /**
+     * Destructor.
+     *
+     * Any pending events are deleted here.
+     **/
+    virtual ~YEventQueue();
+
+    /**
+     * Widget event handlers call this when an event occured that
+     * should be the answer to a UserInput() / PollInput() (etc.) call.
+     *
+     * The UI assumes ownership of the event object that 'event' points to, so
+     * the event MUST be created with new(). The UI is to take care to delete
+     * the event after it has been processed.
+     *
+     * If events are blocked (see blockEvents() ) or if the event is merged
+     * with a pending one, the event sent with this function is deleted.
+     *
+     * It is an error to pass 0 for 'event'.
+     **/
+    void sendEvent( YEvent * event_disown );
+
+    /**
+     * Returns 'true' if there is any event pending for the specified widget.
+     **/
+    bool eventPendingFor( YWidget * widget ) const;
+
+    /**
+     * Returns the newest event that is pending for the specified widget or 0
+     * if there is none. Unlike pendingEvent(), this never returns an event
+     * of another widget.
+     **/
+    YWidgetEvent * pendingEventFor( YWidget * widget ) const;
+
+    /**
+     * Returns the oldest event that isn't processed yet, i.e. the one that
+     * consumePendingEvent() would return, or 0 if there is none.
+     **/
+    YEvent * pendingEvent() const;
+
+    /**
+     * Returns the number of pending events.
+     **/
+    int pendingEventsCount() const { return _count; }
+
+    /**
+     * Consumes the oldest pending event and removes it from the queue.
+     * Does NOT delete the event.
+     *
+     * The caller assumes ownership of the object this pending event points
+     * to. In particular, he has to take care to delete that object when he is
+     * done processing it.
+     *
+     * Returns the pending event or 0 if there is none.
+     **/
+    YEvent * consumePendingEvent();
+
+    /**
+     * Consumes all pending events (at most 'maxEvents' if that is > 0) in
+     * the order they were sent and appends them to 'events'. The caller
+     * assumes ownership of those events just like with consumePendingEvent().
+     *
+     * Returns the number of events consumed.
+     **/
+    int consumePendingEvents( std::vector<YEvent *> & events, int maxEvents = 0 );
+
+    /**
+     * Delete any pending events for the specified widget. This is useful
+     * mostly if the widget is about to be destroyed.
+     **/
+    void deletePendingEventsFor( YWidget * widget );
+
+    /**
+     * Clears all pending events (deletes the corresponding objects).
+     **/
+    void clear();
+
+    /**
+     * Block (or unblock) events. If events are blocked, any event sent with
+     * sendEvent() from now on is ignored (and will get lost) until events are
+     * unblocked again.
+     **/
+    void blockEvents( bool block = true );
+
+    /**
+     * Unblock events previously blocked. This is just an alias for
+     * blockEvents( false) for better readability.
+     **/
+    void unblockEvents() { blockEvents( false ); }
+
+    /**
+     * Returns 'true' if events are currently blocked.
+     **/
+    bool eventsBlocked() const { return _eventsBlocked; }
+
+    /**
+     * Returns the number of events that were merged with pending ones.
+     **/
+    unsigned long mergedEventsCount() const { return _mergedEvents; }
+
+    /**
+     * Returns the number of events that were discarded because the queue
+     * was full.
+     **/
+    unsigned long discardedEventsCount() const { return _discardedEvents; }
+
+    /**
+     * Delete an event that is not (or no longer) pending. Don't call this
+     * from the outside; this is public only because of limitations of C++ .
+     **/
+    void deleteEvent( YEvent * event );
+
+
+protected:
+
+    /**
+     * Return the pending event no. 'index' (0 is the oldest one).
+     **/
+    YEvent * & at( int index ) { return _ring[ ( _first + index ) % _ring.size() ]; }
+    YEvent * at( int index ) const { return _ring[ ( _first + index ) % _ring.size() ]; }
+
+    /**
+     * Return the event 'event' would be merged with or 0 if there is none.
+     **/
+    YEvent * mergeCandidate( YEvent * event ) const;
+
+    /**
+     * Remove the oldest event from the queue (without deleting it).
+     **/
+    YEvent * takeFirst();
+
+    /**
+     * Update the merge bookkeeping for an event that is no longer pending.
+     **/
+    void forget( YEvent * event );
+
+    /**
+     * Return the index of the pending ValueChanged event of 'widget' in
+     * _pendingValueChanged or -1 if there is none.
+     **/
+    int findValueChanged( YWidget * widget ) const;
+
+    /**
+     * Remove all events for which 'pred' returns 'true' from the queue and
+     * delete them.
+     **/
+    template<typename Predicate> void deleteEvents( Predicate pred );
+
+
+    // Data members
+
+    std::vector<YEvent *>	_ring;
+    int				_first;
+    int				_count;
+    bool			_eventsBlocked;
+    YEvent *			_pendingTimeout;
+
+    // The pending ValueChanged events and their widgets, in no particular
+    // order. Only a few widgets have one at the same time, so this is
+    // searched linearly; its capacity is reserved for a full queue, so it
+    // never allocates memory while sending events.
+    std::vector<std::pair<YWidget *, YEvent *> > _pendingValueChanged;
+
+    unsigned long		_mergedEvents;
+    unsigned long		_discardedEvents;
+};
+
+
+#endif // YEventQueue_h
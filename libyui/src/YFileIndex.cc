@@ -0,0 +1,217 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <mutex>
+#include <unordered_map>
+
+#include "YFileIndex.h"
+#include "YSettings.h"
+
+using std::string;
+using std::vector;
+
+
+namespace
+{
+    /**
+     * Whether an entry of a directory exists for YFileIndex::exists().
+     * Symbolic links (and entries of an unknown type) only exist if their
+     * target does, like with stat(); that is checked when first needed.
+     **/
+    enum EntryState
+    {
+	Exists,
+	Unchecked,
+	Missing
+    };
+
+
+    /**
+     * The cached contents of one directory.
+     **/
+    struct Directory
+    {
+	Directory() : indexed( false ) {}
+
+	vector<string>				entries;
+	vector<bool>				maybeDir;	// per entry
+	std::unordered_map<string, EntryState>	names;
+
+	/**
+	 * Full path of the first match for each name anywhere below this
+	 * directory, built with the first findRecursive().
+	 **/
+	std::unordered_map<string, string> index;
+	bool				   indexed;
+    };
+
+
+    std::mutex					mutex;
+    std::unordered_map<string, Directory>	directories;
+    unsigned					indexGeneration		= 0;
+    unsigned					settingsGeneration	= 0;
+
+
+    void clearLocked()
+    {
+	directories.clear();
+	indexGeneration++;
+    }
+
+
+    void checkSettings()
+    {
+	if ( settingsGeneration != YSettings::generation() )
+	{
+	    settingsGeneration = YSettings::generation();
+	    clearLocked();
+	}
+    }
+
+
+    Directory & directory( const string & path )
+    {
+	std::pair<std::unordered_map<string, Directory>::iterator, bool> result =
+	    directories.emplace( path, Directory() );
+
+	Directory & dir = result.first->second;
+
+	if ( result.second )	// newly inserted: read the directory
+	{
+	    DIR * dirp = opendir( path.c_str() );
+
+	    if ( dirp )
+	    {
+		struct dirent * ent;
+
+		while ( ( ent = readdir( dirp ) ) != NULL )
+		{
+		    string name( ent->d_name );
+
+		    if ( name == "." || name == ".." )
+			continue;
+
+		    dir.entries.push_back( name );
+		    dir.maybeDir.push_back( ent->d_type != DT_REG );
+		    dir.names.emplace( name, ent->d_type == DT_LNK || ent->d_type == DT_UNKNOWN ?
+				       Unchecked : Exists );
+		}
+
+		closedir( dirp );
+	    }
+	}
+
+	return dir;
+    }
+
+
+    /**
+     * Add everything below 'path' to 'index' in the same order a recursive
+     * search would find it. Entries that are already in the index win.
+     **/
+    void addToIndex( const string & path, std::unordered_map<string, string> & index )
+    {
+	Directory & dir = directory( path );
+
+	for ( size_t i = 0; i < dir.entries.size(); i++ )
+	{
+	    string fullname = path + "/" + dir.entries[i];
+	    index.emplace( dir.entries[i], fullname );
+
+	    if ( dir.maybeDir[i] )
+		addToIndex( fullname, index );
+	}
+    }
+}
+
+
+vector<string>
+YFileIndex::entries( const string & path )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    checkSettings();
+
+    return directory( path ).entries;
+}
+
+
+bool
+YFileIndex::exists( const string & path )
+{
+    string::size_type pos = path.rfind( '/' );
+
+    if ( pos == string::npos )
+	return false;
+
+    std::lock_guard<std::mutex> lock( mutex );
+    checkSettings();
+
+    Directory & dir = directory( pos == 0 ? "/" : path.substr( 0, pos ) );
+    std::unordered_map<string, EntryState>::iterator it = dir.names.find( path.substr( pos + 1 ) );
+
+    if ( it == dir.names.end() )
+	return false;
+
+    if ( it->second == Unchecked )
+    {
+	struct stat fileInfo;
+	it->second = stat( path.c_str(), &fileInfo ) == 0 ? Exists : Missing;
+    }
+
+    return it->second == Exists;
+}
+
+
+string
+YFileIndex::findRecursive( const string & path, const string & filename )
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    checkSettings();
+
+    Directory & dir = directory( path );
+
+    if ( ! dir.indexed )
+    {
+	addToIndex( path, dir.index );
+	dir.indexed = true;
+    }
+
+    std::unordered_map<string, string>::const_iterator it = dir.index.find( filename );
+
+    return it == dir.index.end() ? string() : it->second;
+}
+
+
+unsigned
+YFileIndex::generation()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    checkSettings();
+
+    return indexGeneration;
+}
+
+
+void
+YFileIndex::clear()
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    clearLocked();
+}
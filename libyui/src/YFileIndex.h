@@ -0,0 +1,71 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YFileIndex_h
+#define YFileIndex_h
+
+#include <string>
+#include <vector>
+
+
+/**
+ * Internal helper class for YPath and YIconLoader: A process-wide cache of
+ * directory contents so theme and icon lookups don't have to read the same
+ * directories over and over again.
+ *
+ * Each directory is read only once when it is first needed. The cache is
+ * cleared when one of the directories in YSettings changes or with clear().
+ **/
+class YFileIndex
+{
+public:
+
+    /**
+     * Return the entries of a directory (without "." and "..") in the order
+     * readdir() returns them. Return an empty list if the directory cannot
+     * be read.
+     **/
+    static std::vector<std::string> entries( const std::string & directory );
+
+    /**
+     * Return 'true' if 'path' exists, i.e. if its parent directory
+     * contains an entry with its name. Like with stat(), a symbolic link
+     * only exists if its target does.
+     **/
+    static bool exists( const std::string & path );
+
+    /**
+     * Return the full path of the first file or directory named 'filename'
+     * anywhere below 'directory' (depth first, in readdir() order) or an
+     * empty string if there is none.
+     **/
+    static std::string findRecursive( const std::string & directory,
+				      const std::string & filename );
+
+    /**
+     * Return a counter that changes whenever the cache is cleared. Caches
+     * built on top of this one can use it to detect that they are outdated.
+     **/
+    static unsigned generation();
+
+    /**
+     * Clear the cache, e.g. after files were installed.
+     **/
+    static void clear();
+};
+
+
+#endif // YFileIndex_h
@@ -62,6 +62,7 @@ YFrame::~YFrame()
 void YFrame::setLabel( const string & newLabel )
 {
     priv->label = YShortcut::cleanShortcutString( newLabel );
+    labelChanged();
 }
 
 
@@ -91,14 +92,13 @@ YFrame::propertySet()
 
 
 bool
-YFrame::setProperty( const string & propertyName, const YPropertyValue & val )
+YFrame::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -106,13 +106,12 @@ YFrame::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YFrame::getProperty( const string & propertyName )
+YFrame::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -134,15 +134,14 @@ YGraph::propertySet()
 
 
 bool
-YGraph::setProperty( const string & propertyName, const YPropertyValue & val )
+YGraph::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Filename	)	setFilename( val.stringVal() );
-    else if ( propertyName == YUIProperty_Layout	)	setLayoutAlgorithm( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Filename:	setFilename( val.stringVal() );	break;
+	case YUIPropertyId_Layout:	setLayoutAlgorithm( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -150,15 +149,14 @@ YGraph::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YGraph::getProperty( const string & propertyName )
+YGraph::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Filename	)	return YPropertyValue( filename() );
-    else if ( propertyName == YUIProperty_Layout	)	return YPropertyValue( layoutAlgorithm() );
-    else if ( propertyName == YUIProperty_Item		)	return YPropertyValue( activatedNode() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Filename:	return YPropertyValue( filename() );
+	case YUIPropertyId_Layout:	return YPropertyValue( layoutAlgorithm() );
+	case YUIPropertyId_Item:	return YPropertyValue( activatedNode() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
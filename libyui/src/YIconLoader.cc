@@ -23,13 +23,13 @@
 /-*/
 
 
-#include <sys/stat.h>
 #include <sstream>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
 
 #include "YIconLoader.h"
+#include "YFileIndex.h"
 
 #define FALLBACK_ICON_PATH "/usr/share/icons/hicolor/"
 
@@ -38,6 +38,7 @@ using std::string;
 
 
 YIconLoader::YIconLoader()
+    : _foundIconsGeneration( 0 )
 {
     addIconSearchPath( FALLBACK_ICON_PATH );
 }
@@ -51,6 +52,7 @@ YIconLoader::~YIconLoader()
 void YIconLoader::setIconBasePath( string path )
 {
     _iconBasePath = path;
+    _foundIcons.clear();
 }
 
 
@@ -63,10 +65,33 @@ string YIconLoader::iconBasePath() const
 void YIconLoader::addIconSearchPath( string path )
 {
     _iconDirs.push_front( path );
+    _foundIcons.clear();
 }
 
 
 string YIconLoader::findIcon( string name )
+{
+    unsigned generation = YFileIndex::generation();
+
+    if ( _foundIconsGeneration != generation )
+    {
+	_foundIcons.clear();
+	_foundIconsGeneration = generation;
+    }
+
+    std::unordered_map<string, string>::const_iterator it = _foundIcons.find( name );
+
+    if ( it != _foundIcons.end() )
+	return it->second;
+
+    string fullPath = lookupIcon( name );
+    _foundIcons[ name ] = fullPath;
+
+    return fullPath;
+}
+
+
+string YIconLoader::lookupIcon( string name )
 {
     // No extension -> add some
     string::size_type loc = name.find( ".png" );
@@ -118,8 +143,5 @@ string YIconLoader::findIcon( string name )
 
 bool YIconLoader::fileExists( string fname )
 {
-    struct stat fileInfo;
-    int ret = stat( fname.c_str(), &fileInfo );
-
-    return ret == 0;
+    return YFileIndex::exists( fname );
 }
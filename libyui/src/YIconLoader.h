@@ -28,6 +28,7 @@
 
 #include <string>
 #include <list>
+#include <unordered_map>
 
 class YIconLoader
 {
@@ -51,6 +52,11 @@ private:
     std::string                 _iconBasePath;
     std::list <std::string>	_iconDirs;
 
+    // findIcon() results by icon name
+    std::unordered_map<std::string, std::string> _foundIcons;
+    unsigned			_foundIconsGeneration;
+
+    std::string lookupIcon( std::string name );
     bool fileExists( std::string fname );
 };
 
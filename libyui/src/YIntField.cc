@@ -133,6 +133,7 @@ void
 YIntField::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -162,17 +163,16 @@ YIntField::propertySet()
 
 
 bool
-YIntField::setProperty( const string & propertyName, const YPropertyValue & val )
+YIntField::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	setValue   ( val.integerVal() );
-    else if ( propertyName == YUIProperty_MinValue	)	setMinValue( val.integerVal() );
-    else if ( propertyName == YUIProperty_MaxValue	)	setMaxValue( val.integerVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	setValue   ( val.integerVal() );	break;
+	case YUIPropertyId_MinValue:	setMinValue( val.integerVal() );	break;
+	case YUIPropertyId_MaxValue:	setMaxValue( val.integerVal() );	break;
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -180,16 +180,15 @@ YIntField::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YIntField::getProperty( const string & propertyName )
+YIntField::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    if	    ( propertyName == YUIProperty_MinValue	)	return YPropertyValue( minValue() );
-    if	    ( propertyName == YUIProperty_MaxValue	)	return YPropertyValue( maxValue() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( value() );
+	case YUIPropertyId_MinValue:	return YPropertyValue( minValue() );
+	case YUIPropertyId_MaxValue:	return YPropertyValue( maxValue() );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -27,6 +27,8 @@
 
 #include <iostream>
 #include "YItem.h"
+#include "YArena.h"
+#include "YSelectionWidget.h"
 
 using std::string;
 
@@ -40,6 +42,61 @@ using std::string;
 YItemCollection YItem::_noChildren;
 
 
+YItem::~YItem()
+{
+    if ( _owner )
+	_owner->itemRemoved( this );
+}
+
+
+void *
+YItem::operator new( size_t size )
+{
+    return YArena::allocate( size );
+}
+
+
+void
+YItem::operator delete( void * ptr, size_t size )
+{
+    YArena::deallocate( ptr, size );
+}
+
+
+void
+YItem::setLabel( const string & newLabel )
+{
+    _label = newLabel;
+
+    if ( _owner )
+	_owner->itemLabelChanged( this );
+}
+
+
+void
+YItem::setStatus( int newStatus )
+{
+    bool wasSelected = selected();
+    _status = newStatus;
+
+    if ( _owner && selected() != wasSelected )
+	_owner->itemSelectionChanged( this );
+}
+
+
+void
+YItem::setOwner( YSelectionWidget * owner )
+{
+    _owner = owner;
+
+    if ( owner )
+	owner->itemAdded( this );
+
+    for ( YItemIterator it = childrenBegin(); it != childrenEnd(); ++it )
+	(*it)->setOwner( owner );
+}
+
+
 string
 YItem::debugLabel() const
 {
@@ -31,6 +31,7 @@
 
 
 class YItem;
+class YSelectionWidget;
 
 // without "documenting" the file, typedefs will be dropped
 //! @file
@@ -64,6 +65,7 @@ public:
 	, _status( selected ? 1 : 0 )
 	, _index( -1 )
 	, _data( 0 )
+	, _owner( 0 )
 	{}
 
     /**
@@ -77,12 +79,24 @@ public:
 	, _status( selected ? 1 : 0 )
 	, _index( -1 )
 	, _data( 0 )
+	, _owner( 0 )
 	{}
 
     /**
-     * Destructor.
+     * Destructor. This unregisters the item from its owner widget.
      **/
-    virtual ~YItem() {}
+    virtual ~YItem();
+
+    /**
+     * Allocate items from the current arena, i.e. usually from the arena of
+     * the dialog they are created for (see YArena).
+     **/
+    static void * operator new( size_t size );
+
+    /**
+     * Free the memory of an item (see operator new() ).
+     **/
+    static void operator delete( void * ptr, size_t size );
 
     /**
      * Returns a descriptive name of this widget class for logging,
@@ -99,7 +113,7 @@ public:
     /**
      * Set this item's label.
      **/
-    void setLabel( const std::string & newLabel ) { _label = newLabel; }
+    void setLabel( const std::string & newLabel );
 
     /**
      * Return this item's icon name.
@@ -126,7 +140,7 @@ public:
      * item; if it is desired that only one item is selected at any time, the
      * caller has to take care of that.
      **/
-    void setSelected( bool sel = true ) { _status = sel ? 1 : 0; }
+    void setSelected( bool sel = true ) { setStatus( sel ? 1 : 0 ); }
 
     /**
      * Return the status of this item. This is a bit more generalized than
@@ -139,8 +153,11 @@ public:
      * Set the status of this item. Most widgets only use 0 for "not selected"
      * or nonzero for "selected". Some widgets may make use of other values as
      * well.
+     *
+     * The owner widget is notified if the item is selected or deselected by
+     * this, so it can keep track of its selected items.
      **/
-    void setStatus( int newStatus ) { _status = newStatus; }
+    void setStatus( int newStatus );
 
     /**
      * Set this item's index.
@@ -167,6 +184,22 @@ public:
      **/
     void * data() const { return _data; }
 
+    /**
+     * Return the selection widget this item belongs to (directly or as a
+     * descendant of a toplevel item) or 0 if it was not added to one yet.
+     **/
+    YSelectionWidget * owner() const { return _owner; }
+
+    /**
+     * Set the selection widget this item and all its descendants belong to
+     * and register them with it.
+     *
+     * This is called by YSelectionWidget::addItem() and by YTreeItem when a
+     * child is added to an item that already belongs to a widget.
+     * Applications should never call this.
+     **/
+    void setOwner( YSelectionWidget * owner );
+
     //
     // Children management stubs.
     //
@@ -238,6 +271,8 @@ private:
     int		_index;
     void *	_data;
 
+    YSelectionWidget * _owner;
+
     /**
      * Static children collection that is always empty so the children
      * iterators of this base class have something valid to return.
@@ -236,20 +236,19 @@ YItemSelector::propertySet()
 
 
 bool
-YItemSelector::setProperty( const string & propertyName, const YPropertyValue & val )
+YItemSelector::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_SelectedItems	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_ItemStatus    )	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_VisibleItems	)	setVisibleItems( val.integerVal() );
-    else if ( propertyName == YUIProperty_IconPath	)	setIconBasePath( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:		return false; // Needs special handling
+	case YUIPropertyId_CurrentItem:		return false; // Needs special handling
+	case YUIPropertyId_SelectedItems:	return false; // Needs special handling
+	case YUIPropertyId_Items:		return false; // Needs special handling
+	case YUIPropertyId_ItemStatus:		return false; // Needs special handling
+	case YUIPropertyId_VisibleItems:	setVisibleItems( val.integerVal() );	break;
+	case YUIPropertyId_IconPath:		setIconBasePath( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -257,19 +256,18 @@ YItemSelector::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YItemSelector::getProperty( const string & propertyName )
+YItemSelector::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_SelectedItems	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_ItemStatus    )	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_VisibleItems	)	return YPropertyValue( visibleItems() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_CurrentItem:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_SelectedItems:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Items:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_ItemStatus:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_VisibleItems:	return YPropertyValue( visibleItems() );
+	case YUIPropertyId_IconPath:		return YPropertyValue( iconBasePath() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -84,6 +84,7 @@ string YLabel::text() const
 void YLabel::setText( const string & newText )
 {
     priv->text = newText;
+    labelChanged();
 }
 
 
@@ -166,16 +167,15 @@ YLabel::propertySet()
 
 
 bool
-YLabel::setProperty( const string & propertyName, const YPropertyValue & val )
+YLabel::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Label )	setText( val.stringVal() );
-    else if ( propertyName == YUIProperty_Value )	setText( val.stringVal() );
-    else if ( propertyName == YUIProperty_Text )	setText( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Label:	setText( val.stringVal() );	break;
+	case YUIPropertyId_Value:	setText( val.stringVal() );	break;
+	case YUIPropertyId_Text:	setText( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -183,16 +183,15 @@ YLabel::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YLabel::getProperty( const string & propertyName )
+YLabel::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Label )	return YPropertyValue( text() );
-    else if ( propertyName == YUIProperty_Value )	return YPropertyValue( text() );
-    else if ( propertyName == YUIProperty_Text )	return YPropertyValue( text() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Label:	return YPropertyValue( text() );
+	case YUIPropertyId_Value:	return YPropertyValue( text() );
+	case YUIPropertyId_Text:	return YPropertyValue( text() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
 
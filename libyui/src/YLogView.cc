@@ -22,7 +22,7 @@
 
 /-*/
 
-#include <deque>
+#include <vector>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
@@ -32,9 +32,7 @@
 
 using std::string;
 
-typedef std::deque<string>                      StringDeque;
-typedef std::deque<string>::iterator            StringDequeIterator;
-typedef std::deque<string>::const_iterator      StringDequeConstIterator;
+typedef std::vector<string> StringVector;
 
 
 
@@ -44,16 +42,184 @@ struct YLogViewPrivate
         : label( label )
         , visibleLines( visibleLines )
         , maxLines( maxLines )
+        , first( 0 )
+        , count( 0 )
         {}
 
     string	label;
     int		visibleLines;
     int		maxLines;
 
-    StringDeque logText;
+    /**
+     * The log lines as a ring buffer: 'count' lines starting at index
+     * 'first'. Each line includes its trailing newline unless it is the last
+     * one and still incomplete. The ring only grows up to maxLines lines;
+     * after that, appending a line overwrites the oldest one.
+     **/
+    StringVector	ring;
+    size_t		first;
+    size_t		count;
+
+    /**
+     * Return line no. 'index' (0 is the oldest one).
+     **/
+    string & line( size_t index )
+	{ return ring[ ( first + index ) % ring.size() ]; }
+
+    const string & line( size_t index ) const
+	{ return ring[ ( first + index ) % ring.size() ]; }
+
+    /**
+     * Add one line at the end, dropping the oldest one if there would be more
+     * than maxLines lines.
+     **/
+    void push( const string & newLine );
+
+    /**
+     * Remove the oldest line.
+     **/
+    void popFront();
+
+    /**
+     * Remove all lines.
+     **/
+    void clear();
+
+    /**
+     * Append 'text' which may contain any number of lines. If the last line
+     * was incomplete, the first line of 'text' continues it.
+     *
+     * If 'newLines' is non-null, the complete lines that were appended (or
+     * replaced) are added to it. Return 'true' if the last line was replaced.
+     **/
+    bool append( const string & text, StringVector * newLines = 0 );
+
+    /**
+     * Return the number of characters at the start of 'text' that are
+     * identical to the stored lines, i.e. text.size() if 'text' is the same
+     * as YLogView::logText(), or string::npos if the stored lines are not a
+     * prefix of 'text'. This does not concatenate the lines.
+     **/
+    string::size_type matchingPrefix( const string & text ) const;
 };
 
 
+void YLogViewPrivate::push( const string & newLine )
+{
+    if ( maxLines > 0 && count >= (size_t) maxLines )
+	popFront();
+
+    if ( count == ring.size() )
+    {
+	// Grow (and linearize) the ring
+
+	size_t newSize = std::max( (size_t) 16, 2 * ring.size() );
+
+	if ( maxLines > 0 )
+	    newSize = std::min( newSize, (size_t) maxLines );
+
+	StringVector newRing( newSize );
+
+	for ( size_t i=0; i < count; i++ )
+	    newRing[i].swap( line( i ) );
+
+	ring.swap( newRing );
+	first = 0;
+    }
+
+    line( count++ ) = newLine;	// reuses the capacity of overwritten lines
+}
+
+
+void YLogViewPrivate::popFront()
+{
+    if ( count == 0 )
+	return;
+
+    first = ( first + 1 ) % ring.size();
+    count--;
+}
+
+
+void YLogViewPrivate::clear()
+{
+    StringVector().swap( ring );
+    first = 0;
+    count = 0;
+}
+
+
+bool YLogViewPrivate::append( const string & text, StringVector * newLines )
+{
+    bool		replaced = false;
+    string::size_type	from	 = 0;
+
+    while ( from < text.size() )
+    {
+        string::size_type to = text.find( '\n', from );
+
+        if ( to == string::npos )               // no more newline
+            to = text.size();
+        else
+            to++;                               // include the newline
+
+	if ( from == 0 && count > 0 && *line( count - 1 ).rbegin() != '\n' )
+	{
+	    // Continue the incomplete last line
+
+	    string & lastLine = line( count - 1 );
+	    lastLine.append( text, from, to - from );
+	    replaced = true;
+
+	    if ( newLines )
+		newLines->push_back( lastLine );
+	}
+	else
+	{
+	    push( text.substr( from, to - from ) );
+
+	    if ( newLines )
+		newLines->push_back( line( count - 1 ) );
+	}
+
+	from = to;
+    }
+
+    return replaced;
+}
+
+
+string::size_type
+YLogViewPrivate::matchingPrefix( const string & text ) const
+{
+    string::size_type pos = 0;
+
+    for ( size_t i=0; i < count; i++ )
+    {
+	const string & currentLine = line( i );
+
+	if ( text.compare( pos, currentLine.size(), currentLine ) != 0 )
+	{
+	    // logText() cuts off the newline of the last line
+
+	    bool last = ( i == count - 1 );
+
+	    if ( last && pos + currentLine.size() == text.size() + 1 &&
+		 text.compare( pos, string::npos, currentLine, 0, currentLine.size() - 1 ) == 0 )
+	    {
+		return text.size();
+	    }
+
+	    return string::npos;
+	}
+
+	pos += currentLine.size();
+    }
+
+    return pos;
+}
+
+
 
 
 YLogView::YLogView( YWidget * parent, const string & label, int visibleLines, int maxLines )
@@ -84,6 +250,7 @@ void
 YLogView::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -111,14 +278,15 @@ YLogView::maxLines() const
 void
 YLogView::setMaxLines( int newMaxLines )
 {
-    int linesToDelete = priv->maxLines - newMaxLines;
     priv->maxLines = newMaxLines;
 
-    for ( int i=0; i < linesToDelete; i++ )
-        priv->logText.pop_front();
+    if ( newMaxLines <= 0 || priv->count <= (size_t) newMaxLines )
+	return;
+
+    while ( priv->count > (size_t) newMaxLines )
+	priv->popFront();
 
-    if ( linesToDelete > 0 )
-	updateDisplay();
+    updateDisplay();
 }
 
 
@@ -126,13 +294,15 @@ string
 YLogView::logText() const
 {
     string text;
+    size_t size = 0;
 
-    for ( StringDequeConstIterator it = priv->logText.begin();
-          it != priv->logText.end();
-          ++it )
-    {
-        text += *it;
-    }
+    for ( size_t i=0; i < priv->count; i++ )
+	size += priv->line( i ).size();
+
+    text.reserve( size );
+
+    for ( size_t i=0; i < priv->count; i++ )
+	text += priv->line( i );
 
     if ( ! text.empty() )
     {
@@ -151,81 +321,70 @@ YLogView::logText() const
 string
 YLogView::lastLine() const
 {
-    if ( priv->logText.empty() )
+    if ( priv->count == 0 )
         return "";
     else
-        return priv->logText.back();
+        return priv->line( priv->count - 1 );
 }
 
 
 void
 YLogView::appendLines( const string & newText )
 {
-    string			text	= newText;
-    string::size_type	from	= 0;
-    string::size_type	to	= 0;
-
+    if ( newText.empty() )
+	return;
 
-    // Split the text into single lines
+    int		 oldLines = lines();
+    StringVector newLines;
+    bool	 replaced = priv->append( newText, &newLines );
 
-    while ( to < text.size() )
-    {
-        from = to;
-        to   = text.find( '\n', from );
-        if ( to == string::npos )               // no more newline
-            to = text.size();
-        else
-            to++;                               // include the newline
+    // Lines that were appended, but already dropped again because of
+    // maxLines() don't need to be displayed
 
-        // Output one single line
-        appendLine( text.substr( from, to - from ) );
-    }
+    if ( newLines.size() > priv->count )
+	newLines.erase( newLines.begin(), newLines.end() - priv->count );
 
-    if ( to < text.size() )             // anything left over?
-    {
-        // Output the rest
-        appendLine( text.substr( to, text.size() - to ) );
-    }
+    int droppedLines = oldLines - ( replaced ? 1 : 0 ) + newLines.size() - lines();
 
-    updateDisplay();
+    displayAppendedLines( newLines, replaced, droppedLines );
 }
 
 
 void
-YLogView::appendLine( const string & line )
+YLogView::setLogText( const string & text )
 {
-    priv->logText.push_back( line );
+    // optimize for regular updating widget when no new content appear
+    // or when the new content only adds some lines at the end
 
-    if ( maxLines() > 0 && priv->logText.size() > (unsigned) maxLines() )
+    string::size_type matching = priv->matchingPrefix( text );
+
+    if ( matching == text.size() )
+	return;
+
+    if ( matching != string::npos )
     {
-        priv->logText.pop_front();
+	appendLines( text.substr( matching ) );
+	return;
     }
-}
-
-void
-YLogView::setLogText(const string & text)
-{
-  // optimize for regular updating widget when no new content appear
-  if (text == logText())
-    return;
 
-  // do not use clearText as it do render and cause segfault in qt (bnc#989155)
-  priv->logText.clear();
-  appendLines(text);
+    // do not use clearText as it do render and cause segfault in qt (bnc#989155)
+    priv->clear();
+    priv->append( text );
+    updateDisplay();
 }
 
 
 void
 YLogView::clearText()
 {
-    priv->logText.clear();
+    priv->clear();
     updateDisplay();
 }
 
 
 int YLogView::lines() const
 {
-    return priv->logText.size();
+    return priv->count;
 }
 
 
@@ -236,6 +395,15 @@ YLogView::updateDisplay()
 }
 
 
+void
+YLogView::displayAppendedLines( const StringVector & newLines,
+				bool		     lastLineReplaced,
+				int		     droppedLines )
+{
+    updateDisplay();
+}
+
+
 
 const YPropertySet &
 YLogView::propertySet()
@@ -264,18 +432,17 @@ YLogView::propertySet()
 
 
 bool
-YLogView::setProperty( const string & propertyName, const YPropertyValue & val )
+YLogView::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Value         )       setLogText	( val.stringVal()  );
-    else if ( propertyName == YUIProperty_LastLine      )       appendLines     ( val.stringVal()  );
-    else if ( propertyName == YUIProperty_VisibleLines  )       setVisibleLines ( val.integerVal() );
-    else if ( propertyName == YUIProperty_MaxLines      )       setMaxLines     ( val.integerVal() );
-    else if ( propertyName == YUIProperty_Label         )       setLabel        ( val.stringVal()  );
-    else
+    switch ( propertyId )
     {
-        return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:		setLogText	( val.stringVal()  );	break;
+	case YUIPropertyId_LastLine:		appendLines     ( val.stringVal()  );	break;
+	case YUIPropertyId_VisibleLines:	setVisibleLines ( val.integerVal() );	break;
+	case YUIPropertyId_MaxLines:		setMaxLines     ( val.integerVal() );	break;
+	case YUIPropertyId_Label:		setLabel        ( val.stringVal()  );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -283,17 +450,16 @@ YLogView::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YLogView::getProperty( const string & propertyName )
+YLogView::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Value         )       return YPropertyValue( logText()      );
-    if      ( propertyName == YUIProperty_LastLine      )       return YPropertyValue( lastLine()     );
-    if      ( propertyName == YUIProperty_VisibleLines  )       return YPropertyValue( visibleLines() );
-    if      ( propertyName == YUIProperty_MaxLines      )       return YPropertyValue( maxLines()     );
-    else if ( propertyName == YUIProperty_Label         )       return YPropertyValue( label()        );
-    else
+    switch ( propertyId )
     {
-        return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:		return YPropertyValue( logText()      );
+	case YUIPropertyId_LastLine:		return YPropertyValue( lastLine()     );
+	case YUIPropertyId_VisibleLines:	return YPropertyValue( visibleLines() );
+	case YUIPropertyId_MaxLines:		return YPropertyValue( maxLines()     );
+	case YUIPropertyId_Label:		return YPropertyValue( label()        );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
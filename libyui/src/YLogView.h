@@ -25,6 +25,9 @@
 #ifndef YLogView_h
 #define YLogView_h
 
+#include <string>
+#include <vector>
+
 #include "YWidget.h"
 
 class YLogViewPrivate;
@@ -128,6 +131,8 @@ public:
 
     /**
      * Append one or more lines to the log text and trigger a display update.
+     * If the last line was incomplete (i.e. it had no trailing newline), the
+     * first line of 'text' continues it.
      **/
     void appendLines( const std::string & text );
 
@@ -145,22 +150,25 @@ public:
      * Set a property.
      * Reimplemented from YWidget.
      *
-     * This function may throw YUIPropertyExceptions.
+     * The property and the type of 'val' were already checked against
+     * propertySet().
      *
      * This function returns 'true' if the value was successfully set and
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setProperty( YPropertyId propertyId, const YPropertyValue & val );
 
     /**
      * Get a property.
      * Reimplemented from YWidget.
      *
-     * This method may throw YUIPropertyExceptions.
+     * The property was already checked against propertySet().
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getProperty( YPropertyId propertyId );
+
+    using YWidget::setProperty;
+    using YWidget::getProperty;
 
     /**
      * Return this class's property set.
@@ -198,13 +206,28 @@ protected:
      **/
     virtual void displayLogText( const std::string & text ) = 0;
 
-
-private:
-
     /**
-     * Append one single line to the log text.
+     * Display lines that were just appended to the log text. This is called
+     * from appendLines() instead of displayLogText() so derived classes can
+     * update the display incrementally:
+     *
+     * First, if 'lastLineReplaced' is 'true', remove the last displayed line:
+     * It was incomplete (it had no trailing newline), and the first of
+     * 'newLines' is its continued version. Then append 'newLines'. Finally,
+     * remove 'droppedLines' lines at the start to honor maxLines().
+     *
+     * Each line in 'newLines' includes its trailing newline unless it is the
+     * last line and still incomplete.
+     *
+     * This default implementation simply displays the complete log text with
+     * displayLogText().
      **/
-    void appendLine( const std::string & line );
+    virtual void displayAppendedLines( const std::vector<std::string> & newLines,
+				       bool lastLineReplaced,
+				       int  droppedLines );
+
+
+private:
 
     /**
      * Trigger a re-display of the log text.
@@ -97,16 +97,15 @@ YMenuBar::propertySet()
 
 
 bool
-YMenuBar::setProperty( const string & propertyName, const YPropertyValue & val )
+YMenuBar::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_EnabledItems 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Items:		return false; // Needs special handling
+	case YUIPropertyId_EnabledItems:	return false; // Needs special handling
+	case YUIPropertyId_IconPath:		setIconBasePath( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -114,16 +113,15 @@ YMenuBar::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YMenuBar::getProperty( const string & propertyName )
+YMenuBar::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_EnabledItems 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Items:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_EnabledItems:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_IconPath:		return YPropertyValue( iconBasePath() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
 
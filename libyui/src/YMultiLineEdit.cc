@@ -77,6 +77,7 @@ string YMultiLineEdit::label() const
 void YMultiLineEdit::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -127,16 +128,15 @@ YMultiLineEdit::propertySet()
 
 
 bool
-YMultiLineEdit::setProperty( const string & propertyName, const YPropertyValue & val )
+YMultiLineEdit::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	setInputMaxLength( val.integerVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:		setValue( val.stringVal() );	break;
+	case YUIPropertyId_Label:		setLabel( val.stringVal() );	break;
+	case YUIPropertyId_InputMaxLength:	setInputMaxLength( val.integerVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -144,15 +144,14 @@ YMultiLineEdit::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YMultiLineEdit::getProperty( const string & propertyName )
+YMultiLineEdit::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_InputMaxLength )	return YPropertyValue( inputMaxLength() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:		return YPropertyValue( value() );
+	case YUIPropertyId_Label:		return YPropertyValue( label() );
+	case YUIPropertyId_InputMaxLength:	return YPropertyValue( inputMaxLength() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
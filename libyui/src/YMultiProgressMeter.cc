@@ -158,14 +158,13 @@ YMultiProgressMeter::propertySet()
 
 
 bool
-YMultiProgressMeter::setProperty( const string & propertyName, const YPropertyValue & val )
+YMultiProgressMeter::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if ( propertyName == YUIProperty_Values )	return false; // need special processing
-    else
+    switch ( propertyId )
     {
-	YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Values:	return false; // need special processing
+	default:
+	    YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -173,13 +172,12 @@ YMultiProgressMeter::setProperty( const string & propertyName, const YPropertyVa
 
 
 YPropertyValue
-YMultiProgressMeter::getProperty( const string & propertyName )
+YMultiProgressMeter::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if ( propertyName == YUIProperty_Values ) 	return YPropertyValue( YOtherProperty );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Values:	return YPropertyValue( YOtherProperty );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
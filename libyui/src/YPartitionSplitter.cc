@@ -177,14 +177,13 @@ YPartitionSplitter::propertySet()
 
 
 bool
-YPartitionSplitter::setProperty( const string & propertyName, const YPropertyValue & val )
+YPartitionSplitter::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.integerVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	setValue( val.integerVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -192,13 +191,12 @@ YPartitionSplitter::setProperty( const string & propertyName, const YPropertyVal
 
 
 YPropertyValue
-YPartitionSplitter::getProperty( const string & propertyName )
+YPartitionSplitter::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( value() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
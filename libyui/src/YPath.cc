@@ -33,12 +33,13 @@
 #include <stdio.h>
 #include <string.h>
 #include <sstream>
-#include <sys/types.h>
-#include <dirent.h>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "YPath.h"
 #include "YSettings.h"
+#include "YFileIndex.h"
 #include "Libyui_config.h"
 
 #define YUILogComponent "ui"
@@ -48,10 +49,70 @@ using std::string;
 using std::vector;
 
 
+namespace
+{
+    /**
+     * Resolved paths by directory, progDir and filename
+     **/
+    std::mutex				  cacheMutex;
+    std::unordered_map<string, string>	  cache;
+    unsigned				  cacheGeneration = 0;
+
+
+    string cacheKey( const string & directory, const string & filename )
+    {
+	string key( directory );
+	key += '\0';
+	key += YSettings::progDir();
+	key += '\0';
+	key += filename;
+
+	return key;
+    }
+
+
+    bool lookupCache( const string & key, string & fullPath )
+    {
+	unsigned generation = YFileIndex::generation();
+	std::lock_guard<std::mutex> lock( cacheMutex );
+
+	if ( cacheGeneration != generation )
+	{
+	    cache.clear();
+	    cacheGeneration = generation;
+	}
+
+	std::unordered_map<string, string>::const_iterator it = cache.find( key );
+
+	if ( it == cache.end() )
+	    return false;
+
+	fullPath = it->second;
+
+	return true;
+    }
+
+
+    void storeCache( const string & key, const string & fullPath )
+    {
+	unsigned generation = YFileIndex::generation();
+	std::lock_guard<std::mutex> lock( cacheMutex );
+
+	if ( cacheGeneration == generation )	// not cleared in the meantime
+	    cache[ key ] = fullPath;
+    }
+}
+
+
 YPath::YPath ( const string & directory, const string & filename )
 {
     // yuiDebug() << "Given filename: " << filename << endl;
 
+    string key = cacheKey( directory, filename );
+
+    if ( lookupCache( key, fullPath ) )
+	return;
+
     bool	   isThemeDir	     = ! directory.compare ( THEMEDIR );
     string	   progSubDir	     = YSettings::progDir ();
     string	   fullname	     = "";
@@ -131,6 +192,8 @@ YPath::YPath ( const string & directory, const string & filename )
 	// yuiDebug() << "Could NOT find " << filename << " by looking recursive inside " << directory << endl;
 	fullPath = filename;
     }
+
+    storeCache( key, fullPath );
 }
 
 
@@ -141,48 +204,13 @@ YPath::~YPath()
 
 vector<string> YPath::lsDir( const string & directory )
 {
-    vector<string>  fileList;
-    DIR *	    dir;
-    struct dirent * ent;
-
-    if ( ( dir = opendir( directory.c_str () ) ) != NULL )
-    {
-	// yuiDebug() << "Looking in " << directory << endl;
-
-	while ( ( ent = readdir( dir ) ) != NULL )
-	    fileList.push_back( ent -> d_name );
-
-	closedir ( dir );
-    }
-
-    return fileList;
+    return YFileIndex::entries( directory );
 }
 
 
 string YPath::lookRecursive( const string & directory, const string & filename )
 {
-    vector<string> fileList = lsDir( directory );
-    string	   file = "";
-    string	   fullname;
-
-    for ( vector<string>::const_iterator i = fileList.begin();
-	  i != fileList.end() && file.compare ( "" ) == 0;
-	  ++i )
-    {
-	if ( *i != "." && *i != ".." )		  // filter out parent and curdir
-	{
-	    fullname =	directory + "/" + ( *i );
-
-	    if ( *i == filename )
-		file = fullname;
-	    else
-	    {
-		file = lookRecursive ( fullname, filename );
-	    }
-	}
-    }
-
-    return file;
+    return YFileIndex::findRecursive( directory, filename );
 }
 
 
@@ -196,3 +224,9 @@ string YPath::dir()
 {
     return fullPath.substr ( 0, fullPath.rfind( "/" ) );
 }
+
+
+void YPath::clearCache()
+{
+    YFileIndex::clear();
+}
@@ -73,6 +73,15 @@ public:
      **/
     std::string dir();
 
+    /**
+     * Clears the cache of resolved paths and directory contents, e.g. after
+     * new files were installed.
+     *
+     * All lookups are cached for the lifetime of the process; the cache is
+     * cleared automatically when a directory in YSettings changes.
+     **/
+    static void clearCache();
+
 private:
 
     std::vector<std::string> lsDir( const std::string & directory );
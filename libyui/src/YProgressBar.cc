@@ -80,6 +80,7 @@ string YProgressBar::label()
 void YProgressBar::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -128,15 +129,14 @@ YProgressBar::propertySet()
 
 
 bool
-YProgressBar::setProperty( const string & propertyName, const YPropertyValue & val )
+YProgressBar::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.integerVal() );
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	setValue( val.integerVal() );	break;
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -144,14 +144,13 @@ YProgressBar::setProperty( const string & propertyName, const YPropertyValue & v
 
 
 YPropertyValue
-YProgressBar::getProperty( const string & propertyName )
+YProgressBar::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( value() );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -22,12 +22,106 @@
 
 /-*/
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "YProperty.h"
 #include "YUIException.h"
+#include "YUISymbols.h"
 
 using std::string;
 
 
+/**
+ * The interned property names, indexed by YPropertyId.
+ * This needs to be kept in sync with enum YPropertyId.
+ **/
+static const char * const propertyNameTable[] =
+{
+    "",		// YUIPropertyId_Unknown
+    YUIProperty_Alive,
+    YUIProperty_Cell,
+    YUIProperty_ContextMenu,
+    YUIProperty_CurrentBranch,
+    YUIProperty_CurrentButton,
+    YUIProperty_CurrentItem,
+    YUIProperty_CurrentSize,
+    YUIProperty_DebugLabel,
+    YUIProperty_EasterEgg,
+    YUIProperty_Enabled,
+    YUIProperty_EnabledItems,
+    YUIProperty_ExpectedSize,
+    YUIProperty_Filename,
+    YUIProperty_Layout,
+    YUIProperty_HelpText,
+    YUIProperty_IconPath,
+    YUIProperty_InputMaxLength,
+    YUIProperty_HWeight,
+    YUIProperty_HStretch,
+    YUIProperty_ID,
+    YUIProperty_Item,
+    YUIProperty_Items,
+    YUIProperty_ItemStatus,
+    YUIProperty_Label,
+    YUIProperty_Labels,
+    YUIProperty_LastLine,
+    YUIProperty_MaxLines,
+    YUIProperty_MaxValue,
+    YUIProperty_MinValue,
+    YUIProperty_MultiSelection,
+    YUIProperty_Notify,
+    YUIProperty_OpenItems,
+    YUIProperty_SelectedItems,
+    YUIProperty_Text,
+    YUIProperty_Timeout,
+    YUIProperty_ValidChars,
+    YUIProperty_Value,
+    YUIProperty_Values,
+    YUIProperty_VisibleLines,
+    YUIProperty_VisibleItems,
+    YUIProperty_VWeight,
+    YUIProperty_VStretch,
+    YUIProperty_WidgetClass,
+    YUIProperty_VScrollValue,
+    YUIProperty_HScrollValue,
+};
+
+static_assert( sizeof( propertyNameTable ) / sizeof( propertyNameTable[0] ) == YUIPropertyId_Count,
+	       "propertyNameTable is out of sync with enum YPropertyId" );
+
+
+YPropertyId
+YProperty::propertyId( const string & propertyName )
+{
+    static const std::unordered_map<string, YPropertyId> idMap = []()
+    {
+	std::unordered_map<string, YPropertyId> map;
+
+	for ( int id = YUIPropertyId_Unknown + 1; id < YUIPropertyId_Count; id++ )
+	    map[ propertyNameTable[ id ] ] = (YPropertyId) id;
+
+	return map;
+    }();
+
+    auto it = idMap.find( propertyName );
+
+    return it == idMap.end() ? YUIPropertyId_Unknown : it->second;
+}
+
+
+const string &
+YProperty::propertyName( YPropertyId propertyId )
+{
+    static const std::vector<string> names( propertyNameTable,
+					    propertyNameTable + YUIPropertyId_Count );
+
+    if ( propertyId < YUIPropertyId_Unknown || propertyId >= YUIPropertyId_Count )
+	propertyId = YUIPropertyId_Unknown;
+
+    return names[ propertyId ];
+}
+
+
 string
 YProperty::typeAsStr( YPropertyType type )
 {
@@ -79,8 +173,9 @@ bool YPropertyValue::operator!=( const YPropertyValue &other ) const
 }
 
 YPropertySet::YPropertySet()
+    : _unknownCount( 0 )
 {
-    // NOP
+    std::fill_n( _index, (int) YUIPropertyId_Count, -1 );
 }
 
 
@@ -103,48 +198,61 @@ YPropertySet::check( const string & propertyName, YPropertyType type ) const
 }
 
 
-bool
-YPropertySet::contains( const string & propertyName ) const throw()
+const YProperty *
+YPropertySet::find( const string & propertyName ) const
 {
+    YPropertyId id = YProperty::propertyId( propertyName );
+
+    if ( id != YUIPropertyId_Unknown || _unknownCount == 0 )
+	return find( id );
+
     for ( YPropertySet::const_iterator it = _properties.begin();
 	  it != _properties.end();
 	  ++it )
     {
-	if ( it->name() == propertyName )
-	    return true;
+	if ( it->id() == YUIPropertyId_Unknown && it->name() == propertyName )
+	    return &( *it );
     }
 
-    return false;
+    return 0;
+}
+
+
+bool
+YPropertySet::contains( const string & propertyName ) const throw()
+{
+    return find( propertyName ) != 0;
 }
 
 
 bool
 YPropertySet::contains( const string & propertyName, YPropertyType type ) const
 {
-    for ( YPropertySet::const_iterator it = _properties.begin();
-	  it != _properties.end();
-	  ++it )
-    {
-	if ( it->name() == propertyName )
-	{
-	    if ( it->isReadOnly() )
-		YUI_THROW( YUISetReadOnlyPropertyException( *it ) );
+    const YProperty * prop = find( propertyName );
 
-	    if ( it->type() == type ||
-		 it->type() == YOtherProperty )	// "Other" could be anything
-		return true;
+    if ( ! prop )
+	return false;
 
-	    YUI_THROW( YUIPropertyTypeMismatchException( *it, type ) );
-	}
-    }
+    if ( prop->isReadOnly() )
+	YUI_THROW( YUISetReadOnlyPropertyException( *prop ) );
 
-    return false;
+    if ( prop->type() == type ||
+	 prop->type() == YOtherProperty )	// "Other" could be anything
+	return true;
+
+    YUI_THROW( YUIPropertyTypeMismatchException( *prop, type ) );
+    __builtin_unreachable(); // see YPropertyValue::operator==()
 }
 
 
 void
 YPropertySet::add( const YProperty & prop )
 {
+    if ( prop.id() == YUIPropertyId_Unknown )
+	++_unknownCount;
+    else if ( _index[ prop.id() ] < 0 )	// The first one wins, just like with a linear search
+	_index[ prop.id() ] = (short) _properties.size();
+
     _properties.push_back( prop );
 }
 
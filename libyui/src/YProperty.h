@@ -39,6 +39,66 @@ enum YPropertyType
     YIntegerProperty		// YCP Integer == C++ long long
 };
 
+/**
+ * Interned property names: One ID for each of the YUIProperty_* symbols
+ * from YUISymbols.h, so property names can be compared as integers and
+ * used in a switch statement. See YProperty::propertyId().
+ *
+ * Properties with names that are not in this list (e.g. from external
+ * widgets) simply get YUIPropertyId_Unknown.
+ **/
+enum YPropertyId
+{
+    YUIPropertyId_Unknown = 0,
+    YUIPropertyId_Alive,
+    YUIPropertyId_Cell,
+    YUIPropertyId_ContextMenu,
+    YUIPropertyId_CurrentBranch,
+    YUIPropertyId_CurrentButton,
+    YUIPropertyId_CurrentItem,
+    YUIPropertyId_CurrentSize,
+    YUIPropertyId_DebugLabel,
+    YUIPropertyId_EasterEgg,
+    YUIPropertyId_Enabled,
+    YUIPropertyId_EnabledItems,
+    YUIPropertyId_ExpectedSize,
+    YUIPropertyId_Filename,
+    YUIPropertyId_Layout,
+    YUIPropertyId_HelpText,
+    YUIPropertyId_IconPath,
+    YUIPropertyId_InputMaxLength,
+    YUIPropertyId_HWeight,
+    YUIPropertyId_HStretch,
+    YUIPropertyId_ID,
+    YUIPropertyId_Item,
+    YUIPropertyId_Items,
+    YUIPropertyId_ItemStatus,
+    YUIPropertyId_Label,
+    YUIPropertyId_Labels,
+    YUIPropertyId_LastLine,
+    YUIPropertyId_MaxLines,
+    YUIPropertyId_MaxValue,
+    YUIPropertyId_MinValue,
+    YUIPropertyId_MultiSelection,
+    YUIPropertyId_Notify,
+    YUIPropertyId_OpenItems,
+    YUIPropertyId_SelectedItems,
+    YUIPropertyId_Text,
+    YUIPropertyId_Timeout,
+    YUIPropertyId_ValidChars,
+    YUIPropertyId_Value,
+    YUIPropertyId_Values,
+    YUIPropertyId_VisibleLines,
+    YUIPropertyId_VisibleItems,
+    YUIPropertyId_VWeight,
+    YUIPropertyId_VStretch,
+    YUIPropertyId_WidgetClass,
+    YUIPropertyId_VScrollValue,
+    YUIPropertyId_HScrollValue,
+
+    YUIPropertyId_Count	// Not a property; only the number of IDs
+};
+
 class YWidget;
 class YProperty;
 
@@ -57,6 +117,7 @@ public:
      **/
     YProperty( const std::string & name, YPropertyType type, bool isReadOnly = false )
 	: _name( name )
+	, _id( propertyId( name ) )
 	, _type( type )
 	, _isReadOnly( isReadOnly )
 	{}
@@ -66,6 +127,12 @@ public:
      **/
     std::string name() const { return _name; }
 
+    /**
+     * Returns the interned ID of this property's name or
+     * YUIPropertyId_Unknown if it is not one of the YUIProperty_* names.
+     **/
+    YPropertyId id() const { return _id; }
+
     /**
      * Returns the type of this property.
      **/
@@ -86,9 +153,22 @@ public:
      **/
     static std::string typeAsStr( YPropertyType type );
 
+    /**
+     * Returns the interned ID for a property name or YUIPropertyId_Unknown
+     * if it is not one of the YUIProperty_* names. This is a hash lookup.
+     **/
+    static YPropertyId propertyId( const std::string & propertyName );
+
+    /**
+     * Returns the property name for an interned ID or an empty string for
+     * YUIPropertyId_Unknown.
+     **/
+    static const std::string & propertyName( YPropertyId propertyId );
+
 private:
 
     std::string		_name;
+    YPropertyId		_id;
     YPropertyType	_type;
     bool		_isReadOnly;
 };
@@ -236,6 +316,13 @@ public:
      **/
     bool contains( const std::string & propertyName ) const throw();
 
+    /**
+     * Check if a property with the interned ID 'propertyId' exists in this
+     * property set. This is an array lookup only.
+     **/
+    bool contains( YPropertyId propertyId ) const throw()
+	{ return find( propertyId ) != 0; }
+
     /**
      * Check if a property 'propertyName' exists in this property set.
      * Returns 'true' if it exists, 'false' if not.
@@ -257,6 +344,23 @@ public:
     bool contains( const YProperty & prop ) const
 	{ return contains( prop.name(), prop.type() ); }
 
+    /**
+     * Returns the property with name 'propertyName' or 0 if there is none.
+     **/
+    const YProperty * find( const std::string & propertyName ) const;
+
+    /**
+     * Returns the property with the interned ID 'propertyId' or 0 if there
+     * is none.
+     **/
+    const YProperty * find( YPropertyId propertyId ) const
+    {
+	int index = ( propertyId > YUIPropertyId_Unknown && propertyId < YUIPropertyId_Count ) ?
+	    _index[ propertyId ] : -1;
+
+	return index >= 0 ? &_properties[ index ] : 0;
+    }
+
     /**
      * Returns 'true' if this property set does not contain anything.
      **/
@@ -296,11 +400,16 @@ private:
 
     /**
      * This class uses a simple std::vector as a container to hold the
-     * properties: Normally, the number of properties for each widget is so
-     * small (2..5) that using any more sophisticated container like
-     * std::set etc. would not pay off. More likely, it would add overhead.
+     * properties in the order they were added.
+     *
+     * For the properties with interned names, '_index' maps the property
+     * ID to the index in that vector (-1 if not contained), so lookups are
+     * O(1). Only properties with other names are searched linearly; there
+     * are normally none of those.
      **/
     std::vector<YProperty> _properties;
+    short		   _index[ YUIPropertyId_Count ];
+    int			   _unknownCount;
 };
 
 
@@ -80,6 +80,7 @@ YPushButton::~YPushButton()
 void YPushButton::setLabel( const string & label )
 {
     priv->label = label;
+    labelChanged();
 }
 
 
@@ -227,14 +228,13 @@ YPushButton::propertySet()
 
 
 bool
-YPushButton::setProperty( const string & propertyName, const YPropertyValue & val )
+YPushButton::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special handling necessary
@@ -242,14 +242,13 @@ YPushButton::setProperty( const string & propertyName, const YPropertyValue & va
 
 
 YPropertyValue
-YPushButton::getProperty( const string & propertyName )
+YPushButton::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
 
@@ -88,6 +88,7 @@ YRadioButton::~YRadioButton()
 void YRadioButton::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    labelChanged();
 }
 
 
@@ -131,15 +132,14 @@ YRadioButton::propertySet()
 
 
 bool
-YRadioButton::setProperty( const string & propertyName, const YPropertyValue & val )
+YRadioButton::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if      ( propertyName == YUIProperty_Value )	setValue( val.boolVal() );
-    else if ( propertyName == YUIProperty_Label )	setLabel( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	setValue( val.boolVal() );	break;
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -147,15 +147,14 @@ YRadioButton::setProperty( const string & propertyName, const YPropertyValue & v
 
 
 YPropertyValue
-YRadioButton::getProperty( const string & propertyName )
+YRadioButton::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if      ( propertyName == YUIProperty_Value )	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Label )	return YPropertyValue( label() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( value() );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
 
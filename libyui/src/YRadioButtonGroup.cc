@@ -142,15 +142,14 @@ YRadioButtonGroup::propertySet()
 
 
 bool
-YRadioButtonGroup::setProperty( const string & propertyName, const YPropertyValue & val )
+YRadioButtonGroup::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if ( propertyName == YUIProperty_CurrentButton ||
-	 propertyName == YUIProperty_Value )		return false; // Needs special handling
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_CurrentButton:
+	case YUIPropertyId_Value:		return false; // Needs special handling
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -158,14 +157,13 @@ YRadioButtonGroup::setProperty( const string & propertyName, const YPropertyValu
 
 
 YPropertyValue
-YRadioButtonGroup::getProperty( const string & propertyName )
+YRadioButtonGroup::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if ( propertyName == YUIProperty_CurrentButton ||
-	 propertyName == YUIProperty_Value )		return YPropertyValue( YOtherProperty );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_CurrentButton:
+	case YUIPropertyId_Value:		return YPropertyValue( YOtherProperty );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -83,6 +83,12 @@ string YRichText::value() const
 }
 
 
+void YRichText::appendText( const string & text )
+{
+    setValue( priv->text + text );
+}
+
+
 bool YRichText::plainTextMode() const
 {
     return priv->plainTextMode;
@@ -144,17 +150,16 @@ YRichText::propertySet()
 
 
 bool
-YRichText::setProperty( const string & propertyName, const YPropertyValue & val )
+YRichText::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_Text		)	setValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_VScrollValue	)	setVScrollValue( val.stringVal() );
-    else if ( propertyName == YUIProperty_HScrollValue	)	setHScrollValue( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:		setValue( val.stringVal() );	break;
+	case YUIPropertyId_Text:		setValue( val.stringVal() );	break;
+	case YUIPropertyId_VScrollValue:	setVScrollValue( val.stringVal() );	break;
+	case YUIPropertyId_HScrollValue:	setHScrollValue( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -162,17 +167,16 @@ YRichText::setProperty( const string & propertyName, const YPropertyValue & val
 
 
 YPropertyValue
-YRichText::getProperty( const string & propertyName )
+YRichText::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_Text		)	return YPropertyValue( value() );
-    else if ( propertyName == YUIProperty_VScrollValue	)	return YPropertyValue( vScrollValue() );
-    else if ( propertyName == YUIProperty_HScrollValue	)	return YPropertyValue( hScrollValue() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:		return YPropertyValue( value() );
+	case YUIPropertyId_Text:		return YPropertyValue( value() );
+	case YUIPropertyId_VScrollValue:	return YPropertyValue( vScrollValue() );
+	case YUIPropertyId_HScrollValue:	return YPropertyValue( hScrollValue() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
 
@@ -86,6 +86,17 @@ public:
      **/
     std::string text() const { return value(); }
 
+    /**
+     * Append 'text' to the text content, e.g. for progress displays that
+     * grow over time.
+     *
+     * This default implementation sets the complete new text content with
+     * setValue(). Derived classes may reimplement this to process only the
+     * new text; the new function should store the complete text content
+     * with YRichText::setValue().
+     **/
+    virtual void appendText( const std::string & text );
+
     /**
      * Return 'true' if this RichText widget is in "plain text" mode, i.e. does
      * not try to interpret RichText/HTML tags.
@@ -134,22 +145,25 @@ public:
      * Set a property.
      * Reimplemented from YWidget.
      *
-     * This function may throw YUIPropertyExceptions.
+     * The property and the type of 'val' were already checked against
+     * propertySet().
      *
      * This function returns 'true' if the value was successfully set and
      * 'false' if that value requires special handling (not in error cases:
      * those are covered by exceptions).
      **/
-    virtual bool setProperty( const std::string    & propertyName,
-			      const YPropertyValue & val );
+    virtual bool setProperty( YPropertyId propertyId, const YPropertyValue & val );
 
     /**
      * Get a property.
      * Reimplemented from YWidget.
      *
-     * This method may throw YUIPropertyExceptions.
+     * The property was already checked against propertySet().
      **/
-    virtual YPropertyValue getProperty( const std::string & propertyName );
+    virtual YPropertyValue getProperty( YPropertyId propertyId );
+
+    using YWidget::setProperty;
+    using YWidget::getProperty;
 
     /**
      * Return this class's property set.
@@ -119,18 +119,17 @@ YSelectionBox::propertySet()
 
 
 bool
-YSelectionBox::setProperty( const string & propertyName, const YPropertyValue & val )
+YSelectionBox::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Label		)	setLabel( val.stringVal() );
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:	return false; // Needs special handling
+	case YUIPropertyId_CurrentItem:	return false; // Needs special handling
+	case YUIPropertyId_Items:	return false; // Needs special handling
+	case YUIPropertyId_Label:	setLabel( val.stringVal() );	break;
+	case YUIPropertyId_IconPath:	setIconBasePath( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -138,17 +137,16 @@ YSelectionBox::setProperty( const string & propertyName, const YPropertyValue &
 
 
 YPropertyValue
-YSelectionBox::getProperty( const string & propertyName )
+YSelectionBox::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Label		)	return YPropertyValue( label() );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_CurrentItem:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Items:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Label:	return YPropertyValue( label() );
+	case YUIPropertyId_IconPath:	return YPropertyValue( iconBasePath() );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -27,12 +27,20 @@
 #include "YUILog.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include "YSelectionWidget.h"
 #include "YUIException.h"
 #include "YApplication.h"
 
 using std::string;
 
+/**
+ * Index from item label to item. Items whose label is shared by other items
+ * have a null pointer: the first one in tree order has to be searched then.
+ **/
+typedef std::unordered_map<string, YItem *> YItemLabelIndex;
+
 
 struct YSelectionWidgetPrivate
 {
@@ -43,6 +51,7 @@ struct YSelectionWidgetPrivate
 	, enforceSingleSelection( enforceSingleSelection )
         , enforceInitialSelection( true )
 	, recursiveSelection ( recursiveSelection )
+	, labelIndexValid( false )
 	{}
 
     string		label;
@@ -51,9 +60,44 @@ struct YSelectionWidgetPrivate
     bool		recursiveSelection;
     string		iconBasePath;
     YItemCollection	itemCollection;
+
+    // All selected items, including child items. In single selection mode
+    // there is usually only one.
+    std::unordered_set<YItem *> selectedItems;
+
+    // Built on demand by findItem()
+    mutable YItemLabelIndex labelIndex;
+    mutable bool	    labelIndexValid;
+
+    void dropLabelIndex()
+    {
+	labelIndex.clear();
+	labelIndexValid = false;
+    }
 };
 
 
+/**
+ * Add the items between 'begin' and 'end' and their descendants to 'index'.
+ **/
+static void addToLabelIndex( YItemLabelIndex &	index,
+			     YItemConstIterator	begin,
+			     YItemConstIterator	end )
+{
+    for ( YItemConstIterator it = begin; it != end; ++it )
+    {
+	YItem * item = *it;
+	std::pair<YItemLabelIndex::iterator, bool> result = index.emplace( item->label(), item );
+
+	if ( ! result.second )
+	    result.first->second = 0;
+
+	if ( item->hasChildren() )
+	    addToLabelIndex( index, item->childrenBegin(), item->childrenEnd() );
+    }
+}
+
+
 
 
 YSelectionWidget::YSelectionWidget( YWidget *		parent,
@@ -79,6 +123,12 @@ YSelectionWidget::~YSelectionWidget()
 
 void YSelectionWidget::deleteAllItems()
 {
+    // The items unregister themselves when they are deleted; that's cheap
+    // with the selected items and the label index already cleared.
+
+    priv->selectedItems.clear();
+    priv->dropLabelIndex();
+
     YItemIterator it = itemsBegin();
 
     while ( it != itemsEnd() )
@@ -105,6 +155,7 @@ string YSelectionWidget::label() const
 void YSelectionWidget::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    labelChanged();
 }
 
 
@@ -204,6 +255,7 @@ void YSelectionWidget::addItem( YItem * item )
 
     priv->itemCollection.push_back( item );
     item->setIndex( priv->itemCollection.size() - 1 );
+    item->setOwner( this );
 
     // yuiDebug() << "Adding item \"" << item->label() << "\"" << endl;
 
@@ -227,8 +279,8 @@ void YSelectionWidget::addItem( YItem * item )
 
 	if ( newItemSelected )
 	{
-	    // This looks expensive, but it is not: Even though deselectAllItems()
-	    // searches the complete item list and deselects them all.
+	    // deselectAllItems() only has to visit the items that are
+	    // actually selected, so this is cheap.
 	    //
 	    // This prevents that the calling application does this systematically wrong
 	    // and sets the "selected" flag for more items or children.
@@ -348,6 +400,13 @@ YSelectionWidget::itemAt( int index ) const
 YItem *
 YSelectionWidget::selectedItem()
 {
+    if ( priv->selectedItems.empty() )
+	return 0;
+
+    if ( priv->selectedItems.size() == 1 )
+	return *priv->selectedItems.begin();
+
+    // Several items are selected: return the first one in tree order
     return findSelectedItem( itemsBegin(), itemsEnd() );
 }
 
@@ -384,7 +443,11 @@ YItemCollection
 YSelectionWidget::selectedItems()
 {
     YItemCollection selectedItems;
-    findSelectedItems( selectedItems, itemsBegin(), itemsEnd() );
+
+    if ( priv->selectedItems.size() == 1 )
+	selectedItems.push_back( *priv->selectedItems.begin() );
+    else if ( ! priv->selectedItems.empty() )
+	findSelectedItems( selectedItems, itemsBegin(), itemsEnd() ); // in tree order
 
     return selectedItems;
 }
@@ -456,7 +519,7 @@ void YSelectionWidget::setItemStatus( YItem * item, int status )
 
 bool YSelectionWidget::itemsContain( YItem * wantedItem ) const
 {
-    return itemsContain( wantedItem, itemsBegin(), itemsEnd() );
+    return wantedItem && wantedItem->owner() == this;
 }
 
 
@@ -490,7 +553,14 @@ YSelectionWidget::itemsContain( YItem *			wantedItem,
 
 void YSelectionWidget::deselectAllItems()
 {
-    deselectAllItems( itemsBegin(), itemsEnd() );
+    // Deselecting an item removes it from priv->selectedItems, so iterate
+    // over a copy
+
+    YItemCollection selectedItems( priv->selectedItems.begin(),
+				   priv->selectedItems.end() );
+
+    for ( YItem * item : selectedItems )
+	item->setSelected( false );
 }
 
 
@@ -512,6 +582,21 @@ void YSelectionWidget::deselectAllItems( YItemIterator	begin,
 YItem *
 YSelectionWidget::findItem( const string & wantedItemLabel ) const
 {
+    if ( ! priv->labelIndexValid )
+    {
+	addToLabelIndex( priv->labelIndex, itemsBegin(), itemsEnd() );
+	priv->labelIndexValid = true;
+    }
+
+    YItemLabelIndex::const_iterator it = priv->labelIndex.find( wantedItemLabel );
+
+    if ( it == priv->labelIndex.end() )
+	return 0;
+
+    if ( it->second )
+	return it->second;
+
+    // Several items have that label: return the first one in tree order
     return findItem( wantedItemLabel, itemsBegin(), itemsEnd() );
 }
 
@@ -542,6 +627,47 @@ YSelectionWidget::findItem( const string &	wantedItemLabel,
 }
 
 
+void YSelectionWidget::itemAdded( YItem * item )
+{
+    if ( item->selected() )
+	priv->selectedItems.insert( item );
+
+    if ( priv->labelIndexValid )
+    {
+	std::pair<YItemLabelIndex::iterator, bool> result =
+	    priv->labelIndex.emplace( item->label(), item );
+
+	if ( ! result.second )
+	    result.first->second = 0;
+    }
+}
+
+
+void YSelectionWidget::itemRemoved( YItem * item )
+{
+    priv->selectedItems.erase( item );
+
+    if ( priv->labelIndexValid )
+	priv->dropLabelIndex();
+}
+
+
+void YSelectionWidget::itemSelectionChanged( YItem * item )
+{
+    if ( item->selected() )
+	priv->selectedItems.insert( item );
+    else
+	priv->selectedItems.erase( item );
+}
+
+
+void YSelectionWidget::itemLabelChanged( YItem * )
+{
+    if ( priv->labelIndexValid )
+	priv->dropLabelIndex();
+}
+
+
 void YSelectionWidget::dumpItems() const
 {
     yuiMilestone() << "Items:" << endl;
@@ -264,12 +264,17 @@ public:
 
     /**
      * Return 'true' if this widget's items contain the specified item.
+     *
+     * This does not search the items, it only checks the owner of the item.
      **/
     bool itemsContain( YItem * item ) const;
 
     /**
      * Find the (first) item with the specified label.
      * Return 0 if there is no item with that label.
+     *
+     * This uses an index of the item labels that is built with the first
+     * call and dropped when an item is removed or changes its label.
      **/
     YItem * findItem( const std::string & itemLabel ) const;
 
@@ -385,6 +390,30 @@ protected:
 
 private:
 
+    friend class YItem;
+
+    /**
+     * Notification that 'item' was added to this widget, either as a
+     * toplevel item or as a descendant of one. This is called by
+     * YItem::setOwner().
+     **/
+    void itemAdded( YItem * item );
+
+    /**
+     * Notification that 'item' is being destroyed.
+     **/
+    void itemRemoved( YItem * item );
+
+    /**
+     * Notification that 'item' was selected or deselected.
+     **/
+    void itemSelectionChanged( YItem * item );
+
+    /**
+     * Notification that the label of 'item' changed.
+     **/
+    void itemLabelChanged( YItem * item );
+
     ImplPtr<YSelectionWidgetPrivate> priv;
 };
 
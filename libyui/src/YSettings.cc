@@ -44,6 +44,7 @@ string  YSettings::_iconDir = "";
 string  YSettings::_themeDir = "";
 string  YSettings::_localeDir = "";
 string  YSettings::_loadedUI = "";
+std::atomic<unsigned> YSettings::_generation( 0 );
 
 
 YSettings::YSettings()
@@ -60,6 +61,7 @@ void YSettings::setProgDir( string directory )
     if ( _progDir.empty() )
     {
         _progDir = directory;
+        _generation++;
         yuiDebug () << "Set progDir to \"" << directory << "\"" << endl;
         yuiDebug () << "progDir is now locked." << endl;
     }
@@ -84,6 +86,7 @@ void YSettings::setIconDir( string directory )
     if ( _iconDir.empty() )
     {
         _iconDir = directory;
+        _generation++;
         yuiDebug () << "Set iconDir to \"" << directory << "\"" << endl;
         yuiDebug () << "iconDir is now locked." << endl;
     }
@@ -115,6 +118,7 @@ void YSettings::setThemeDir( string directory )
     if ( _themeDir.empty() )
     {
         _themeDir = directory;
+        _generation++;
         yuiDebug () << "Set themeDir to \"" << directory << "\"" << endl;
         yuiDebug () << "themeDir is now locked." << endl;
     }
@@ -176,6 +180,11 @@ string YSettings::localeDir ()
     return "/usr/share/locale/";
 }
 
+unsigned YSettings::generation()
+{
+    return _generation;
+}
+
 void YSettings::loadedUI( string ui, bool force )
 {
     if ( _loadedUI.empty() || force )
@@ -34,6 +34,7 @@
 #define YSettings_h
 
 #include <string>
+#include <atomic>
 
 
 /**
@@ -120,6 +121,13 @@ public:
      **/
     static std::string loadedUI();
 
+    /**
+     * Returns a counter that is incremented whenever the program, theme or
+     * icon directory is set. Caches of resolved file paths use it to detect
+     * that they are outdated.
+     **/
+    static unsigned generation();
+
 
 protected:
 
@@ -138,6 +146,7 @@ private:
     static std::string _themeDir;
     static std::string _localeDir;
     static std::string _loadedUI;
+    static std::atomic<unsigned> _generation;
 
     YSettings();
     YSettings( const YSettings & );
@@ -217,20 +217,19 @@ YTable::propertySet()
 
 
 bool
-YTable::setProperty( const string & propertyName, const YPropertyValue & val )
+YTable::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if	    ( propertyName == YUIProperty_Value		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_SelectedItems	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Items 	)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Cell		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_Item 		)	return false; // Needs special handling
-    else if ( propertyName == YUIProperty_IconPath 	)	setIconBasePath( val.stringVal() );
-    else
+    switch ( propertyId )
     {
-	return YWidget::setProperty( propertyName, val );
+	case YUIPropertyId_Value:		return false; // Needs special handling
+	case YUIPropertyId_CurrentItem:		return false; // Needs special handling
+	case YUIPropertyId_SelectedItems:	return false; // Needs special handling
+	case YUIPropertyId_Items:		return false; // Needs special handling
+	case YUIPropertyId_Cell:		return false; // Needs special handling
+	case YUIPropertyId_Item:		return false; // Needs special handling
+	case YUIPropertyId_IconPath:		setIconBasePath( val.stringVal() );	break;
+	default:
+	    return YWidget::setProperty( propertyId, val );
     }
 
     return true; // success -- no special processing necessary
@@ -238,21 +237,20 @@ YTable::setProperty( const string & propertyName, const YPropertyValue & val )
 
 
 YPropertyValue
-YTable::getProperty( const string & propertyName )
+YTable::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if	    ( propertyName == YUIProperty_Value		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_CurrentItem 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_SelectedItems	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Items 	)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Cell		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_Item 		)	return YPropertyValue( YOtherProperty );
-    else if ( propertyName == YUIProperty_IconPath	)	return YPropertyValue( iconBasePath() );
-    else if ( propertyName == YUIProperty_MultiSelection )      return YPropertyValue( hasMultiSelection() );
-    else if ( propertyName == YUIProperty_OpenItems 	)	return YPropertyValue( YOtherProperty );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_Value:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_CurrentItem:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_SelectedItems:	return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Items:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Cell:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_Item:		return YPropertyValue( YOtherProperty );
+	case YUIPropertyId_IconPath:		return YPropertyValue( iconBasePath() );
+	case YUIPropertyId_MultiSelection:	return YPropertyValue( hasMultiSelection() );
+	case YUIPropertyId_OpenItems:		return YPropertyValue( YOtherProperty );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
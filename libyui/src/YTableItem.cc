@@ -26,9 +26,14 @@
 #define MAX_DEBUG_LABEL_LEN	40
 
 
+#include <mutex>
+#include <new>
+#include <unordered_set>
+
 #define YUILogComponent "ui"
 #include "YUILog.h"
 
+#include "YArena.h"
 #include "YTableItem.h"
 #include "YUIException.h"
 
@@ -37,6 +42,8 @@ using std::string;
 
 YTableItem::YTableItem()
     : YTreeItem( "" )
+    , _cellBlock( 0 )
+    , _cellBlockSize( 0 )
 {
     // NOP
 }
@@ -45,6 +52,8 @@ YTableItem::YTableItem()
 YTableItem::YTableItem( YTableItem * parent,
                         bool         isOpen )
     : YTreeItem( parent, "", isOpen )
+    , _cellBlock( 0 )
+    , _cellBlockSize( 0 )
 {
     // NOP
 }
@@ -61,6 +70,8 @@ YTableItem::YTableItem( const string & label_0,
 			const string & label_8,
 			const string & label_9 )
     : YTreeItem( "" )
+    , _cellBlock( 0 )
+    , _cellBlockSize( 0 )
 {
     addCells( label_0,
               label_1,
@@ -87,6 +98,8 @@ YTableItem::YTableItem( YTableItem *   parent,
 			const string & label_8,
 			const string & label_9 )
     : YTreeItem( parent, "" )
+    , _cellBlock( 0 )
+    , _cellBlockSize( 0 )
 {
     addCells( label_0,
               label_1,
@@ -101,6 +114,25 @@ YTableItem::YTableItem( YTableItem *   parent,
 }
 
 
+YTableItem::YTableItem( std::vector<string> && labels )
+    : YTreeItem( "" )
+    , _cellBlock( 0 )
+    , _cellBlockSize( 0 )
+{
+    createCells( labels.data(), labels.size() );
+}
+
+
+YTableItem::YTableItem( YTableItem *          parent,
+                        std::vector<string> && labels )
+    : YTreeItem( parent, "" )
+    , _cellBlock( 0 )
+    , _cellBlockSize( 0 )
+{
+    createCells( labels.data(), labels.size() );
+}
+
+
 YTableItem::~YTableItem()
 {
     deleteCells();
@@ -116,10 +148,20 @@ YTableItem::deleteCells()
     {
 	YTableCell * cell = *it;
 	++it;
-	delete cell;
+
+	if ( ! isBlockCell( cell ) )
+	    delete cell;
     }
 
     _cells.clear();
+
+    for ( int i = 0; i < _cellBlockSize; ++i )
+	_cellBlock[ i ].~YTableCell();
+
+    YArena::deallocate( _cellBlock, _cellBlockSize * sizeof( YTableCell ) );
+
+    _cellBlock	   = 0;
+    _cellBlockSize = 0;
 }
 
 
@@ -157,35 +199,64 @@ YTableItem::addCells( const std::string & label_0,
                       const std::string & label_8,
                       const std::string & label_9 )
 {
-    std::vector<string> labels;
-    labels.reserve(10); // slight optimization
-    labels.push_back( label_0 );
-    labels.push_back( label_1 );
-    labels.push_back( label_2 );
-    labels.push_back( label_3 );
-    labels.push_back( label_4 );
-    labels.push_back( label_5 );
-    labels.push_back( label_6 );
-    labels.push_back( label_7 );
-    labels.push_back( label_8 );
-    labels.push_back( label_9 );
+    const string * labels[] =
+    {
+        &label_0, &label_1, &label_2, &label_3, &label_4,
+        &label_5, &label_6, &label_7, &label_8, &label_9
+    };
 
     //
     // Find the last non-empty label
     //
 
-    unsigned lastLabel = labels.size() - 1;
+    int lastLabel = 9;
 
-    while ( labels[ lastLabel ].empty() && --lastLabel > 0 )
+    while ( labels[ lastLabel ]->empty() && --lastLabel > 0 )
     {}
 
     //
     // Create cells
     //
 
-    for ( unsigned i = 0; i <= lastLabel; ++i )
+    string copies[ 10 ];
+
+    for ( int i = 0; i <= lastLabel; ++i )
+	copies[ i ] = *labels[ i ];
+
+    createCells( copies, lastLabel + 1 );
+}
+
+
+bool
+YTableItem::isBlockCell( const YTableCell * cell ) const
+{
+    return cell >= _cellBlock && cell < _cellBlock + _cellBlockSize;
+}
+
+
+void
+YTableItem::createCells( string * labels, int count )
+{
+    if ( count <= 0 )
+	return;
+
+    int column = _cells.size();
+    _cells.reserve( column + count );
+
+    if ( ! _cellBlock )
     {
-	addCell( labels[i] );
+	_cellBlock = static_cast<YTableCell *>( YArena::allocate( count * sizeof( YTableCell ) ) );
+
+	for ( int i = 0; i < count; ++i )
+	{
+	    _cells.push_back( ::new ( _cellBlock + i ) YTableCell( this, column + i, std::move( labels[ i ] ) ) );
+	    _cellBlockSize++;
+	}
+    }
+    else
+    {
+	for ( int i = 0; i < count; ++i )
+	    addCell( new YTableCell( this, column + i, std::move( labels[ i ] ) ) );
     }
 }
 
@@ -260,6 +331,38 @@ YTableItem::debugLabel() const
 //----------------------------------------------------------------------
 
 
+void *
+YTableCell::operator new( size_t size )
+{
+    return YArena::allocate( size );
+}
+
+
+void
+YTableCell::operator delete( void * ptr, size_t size )
+{
+    YArena::deallocate( ptr, size );
+}
+
+
+const string *
+YTableCell::internIconName( const string & iconName )
+{
+    if ( iconName.empty() )
+	return 0;
+
+    // Never cleared: The pointers are kept in the cells. There are only few
+    // different icon names anyway.
+
+    static std::mutex			  mutex;
+    static std::unordered_set<string> iconNames;
+
+    std::lock_guard<std::mutex> lock( mutex );
+
+    return &*iconNames.insert( iconName ).first;
+}
+
+
 void YTableCell::reparent( YTableItem * parent, int column )
 {
     YUI_CHECK_PTR( parent );
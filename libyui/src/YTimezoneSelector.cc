@@ -71,31 +71,35 @@ YTimezoneSelector::propertySet()
 
 
 bool
-YTimezoneSelector::setProperty( const string & propertyName, const YPropertyValue & val )
+YTimezoneSelector::setProperty( YPropertyId propertyId, const YPropertyValue & val )
 {
-    propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-
-    if ( propertyName == YUIProperty_Value )
-    {
-        setCurrentZone( val.stringVal(), true );
-        return true; // success -- no special handling necessary
-    }
-    if ( propertyName == YUIProperty_CurrentItem )
+    switch ( propertyId )
     {
-        setCurrentZone( val.stringVal(), false );
-        return true; // success -- no special handling necessary
+	case YUIPropertyId_Value:
+	    setCurrentZone( val.stringVal(), true );
+	    return true; // success -- no special handling necessary
+
+	case YUIPropertyId_CurrentItem:
+	    setCurrentZone( val.stringVal(), false );
+	    return true; // success -- no special handling necessary
+
+	default:
+	    break;
     }
-    return YWidget::setProperty( propertyName, val );
+
+    return YWidget::setProperty( propertyId, val );
 }
 
 
 YPropertyValue
-YTimezoneSelector::getProperty( const string & propertyName )
+YTimezoneSelector::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if ( propertyName == YUIProperty_Value ) 	        return YPropertyValue( currentZone() );
-    if ( propertyName == YUIProperty_CurrentItem )      return YPropertyValue( currentZone() );
+    switch ( propertyId )
+    {
+	case YUIPropertyId_Value:	return YPropertyValue( currentZone() );
+	case YUIPropertyId_CurrentItem:	return YPropertyValue( currentZone() );
+	default:			break;
+    }
     
-    return YWidget::getProperty( propertyName );
+    return YWidget::getProperty( propertyId );
 }
@@ -80,6 +80,9 @@ YTreeItem::~YTreeItem()
 void YTreeItem::addChild( YItem * child )
 {
     _children.push_back( child );
+
+    if ( owner() )
+	child->setOwner( owner() );
 }
 
 
@@ -29,17 +29,31 @@
 #define YTypes_h
 
 #include <list>
+#include "YChildrenList.h"
 
 typedef double		YLayoutSize_t;
 typedef long long	YFileSize_t;
 
 class YWidget;
 
-typedef std::list<YWidget *>				YWidgetList;
-typedef std::list<YWidget *>::iterator			YWidgetListIterator;
-typedef std::list<YWidget *>::const_iterator		YWidgetListConstIterator;
-typedef std::list<YWidget *>::reverse_iterator		YWidgetListReverseIterator;
-typedef std::list<YWidget *>::const_reverse_iterator	YWidgetListConstReverseIterator;
+/**
+ * The children of a widget. This used to be a std::list, but it is a
+ * contiguous YChildrenList now, with different rules for the validity of
+ * iterators:
+ *
+ * - Adding a child might invalidate all iterators.
+ * - Removing a child invalidates the iterators to it and to all children
+ *   before it; the iterators to the children after it stay valid.
+ *
+ * So a loop may remove the current child after advancing its iterator
+ * (like YWidget::deleteChildren()), but it must not keep an iterator to
+ * an earlier child while removing a later one.
+ **/
+typedef YChildrenList<YWidget>				YWidgetList;
+typedef YWidgetList::iterator				YWidgetListIterator;
+typedef YWidgetList::const_iterator			YWidgetListConstIterator;
+typedef YWidgetList::reverse_iterator			YWidgetListReverseIterator;
+typedef YWidgetList::const_reverse_iterator		YWidgetListConstReverseIterator;
 
 
 #define YUIAllDimensions	2
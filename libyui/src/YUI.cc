@@ -27,8 +27,6 @@
 
 #include <stdio.h>
 #include <string.h>	// strerror()
-#include <unistd.h>	// pipe()
-#include <fcntl.h>  	// fcntl()
 #include <errno.h>
 #include <pthread.h>
 #include <stdlib.h>	// getenv()
@@ -51,6 +49,7 @@
 #include "YBuiltinCaller.h"
 #include "YWidgetID.h"
 #include "YUIPlugin.h"
+#include "YUIThreadHandoff.h"
 
 
 using std::string;
@@ -77,6 +76,7 @@ YUI::YUI( bool withThreads )
     : _withThreads( withThreads )
     , _uiThread( 0 )
     , _builtinCaller( 0 )
+    , _handoff( 0 )
     , _terminate_ui_thread( false )
     , _eventsBlocked( false )
 {
@@ -104,6 +104,8 @@ YUI::~YUI()
 	if ( _builtinCaller )
 	    delete _builtinCaller;
 
+	delete _handoff;
+
 	YDialog::deleteAllDialogs();
 
 	YMacro::deleteRecorder();
@@ -202,34 +204,18 @@ void YUI::topmostConstructorHasFinished()
 
     if ( _withThreads )
     {
-	if ( pipe( pipe_from_ui ) == 0 &&
-	     pipe( pipe_to_ui   ) == 0   )
-	{
+	_handoff = new YUIThreadHandoff();
 
-	    // Make fd non blockable the ui thread reads from
-	    long arg;
-	    arg = fcntl( pipe_to_ui[0], F_GETFL );
-	    if ( fcntl( pipe_to_ui[0], F_SETFL, arg | O_NONBLOCK ) < 0 )
-	    {
-		yuiError() << "Couldn't set O_NONBLOCK: errno: " << errno << " " << strerror( errno ) << endl;
-		_withThreads = false;
-		close( pipe_to_ui[0] );
-		close( pipe_to_ui[1] );
-		close( pipe_from_ui[0] );
-		close( pipe_from_ui[1] );
-	    }
-	    else
-	    {
+	if ( _handoff->init() )
+	{
 #if VERBOSE_COMM
-		yuiDebug() << "Inter-thread communication pipes set up" << endl;
+	    yuiDebug() << "Inter-thread communication set up" << endl;
 #endif
-		_terminate_ui_thread = false;
-		createUIThread();
-	    }
+	    _terminate_ui_thread = false;
+	    createUIThread();
 	}
 	else
 	{
-	    yuiError() << "pipe() failed: errno: " << errno << " " << strerror( errno ) << endl;
 	    exit(2);
 	}
     }
@@ -270,91 +256,46 @@ void YUI::shutdownThreads()
     {
 	terminateUIThread();
 	_uiThread = 0;
-	close( pipe_to_ui[0] );
-	close( pipe_to_ui[1] );
-	close( pipe_from_ui[0] );
-	close( pipe_from_ui[1] );
+	_handoff->close();
     }
 }
 
 
 void YUI::signalUIThread()
 {
-    static char arbitrary = 42;
-    if ( write ( pipe_to_ui[1], & arbitrary, 1 ) == -1 )
-	yuiError() <<  "Writing byte to UI thread failed" << endl;
+    _handoff->postCommand();
 
 #if VERBOSE_COMM
-    yuiDebug() << "Wrote byte to UI thread" << endl;
+    yuiDebug() << "Signalled UI thread" << endl;
 #endif
 }
 
 
 bool YUI::waitForUIThread()
 {
-    char arbitrary;
-    int result;
-
-    do {
 #if VERBOSE_COMM
-	yuiDebug() << "Waiting for ui thread..." << endl;
+    yuiDebug() << "Waiting for ui thread..." << endl;
 #endif
-	result = read( pipe_from_ui[0], & arbitrary, 1 );
-	if ( result == -1 )
-	{
-	    if ( errno == EINTR || errno == EAGAIN )
-		continue;
-	    else
-		yuiError() <<  "waitForUIThread: errno: " << errno << " " << strerror( errno ) << endl;
-	}
-    } while ( result == 0 );
 
-#if VERBOSE_COMM
-    yuiDebug() << "Read byte from ui thread" << endl;
-#endif
+    _handoff->waitForDone();
 
-    // return true if we really did get a signal byte
-    return result != -1;
+    return true;
 }
 
 
 void YUI::signalYCPThread()
 {
-    static char arbitrary;
-    if ( write( pipe_from_ui[1], & arbitrary, 1 ) == -1 )
-	yuiError() <<  "Writing byte to YCP thread failed" << endl;
+    _handoff->signalDone();
 
 #if VERBOSE_COMM
-    yuiDebug() << "Wrote byte to YCP thread" << endl;
+    yuiDebug() << "Signalled YCP thread" << endl;
 #endif
 }
 
 
 bool YUI::waitForYCPThread()
 {
-    char arbitrary;
-
-    int result;
-    do {
-#if VERBOSE_COMM
-	yuiDebug() << "Waiting for YCP thread..." << endl;
-#endif
-	result = read( pipe_to_ui[0], & arbitrary, 1 );
-	if ( result == -1 )
-	{
-	    if ( errno == EINTR || errno == EAGAIN )
-		continue;
-	    else
-		yuiError() << "waitForYCPThread: errno: " << errno << " " << strerror( errno ) << endl;
-	}
-    } while ( result == 0 );
-
-#if VERBOSE_COMM
-    yuiDebug() << "Read byte from YCP thread" << endl;
-#endif
-
-    // return true if we really did get a signal byte
-    return result != -1;
+    return _handoff->takeCommand();
 }
 
 
@@ -362,15 +303,22 @@ void YUI::uiThreadMainLoop()
 {
     while ( true )
     {
-	idleLoop( pipe_to_ui[0] );
+	// The YCP thread usually sends the next command right away, so wait a
+	// moment for it before entering the idle loop. The idle loop needs a
+	// file descriptor to wait for; it only becomes readable if the YCP
+	// thread knows that the UI thread is waiting for it.
 
-	// The pipe is non-blocking, so we have to check if we really read a
-	// signal byte. Although idleLoop already does a select(), this seems to
-	// be necessary.  Anyway: Why do we set the pipe to non-blocking if we
-	// wait in idleLoop for it to become readable? It is needed in
-	// YUIQt::idleLoop for QSocketNotifier.
+	if ( ! _handoff->spinForCommand() )
+	{
+	    if ( _handoff->waitingForCommand( true ) )
+		idleLoop( _handoff->fd() );
 
-	if ( ! waitForYCPThread () )
+	    _handoff->waitingForCommand( false );
+	}
+
+	// idleLoop() might also return for other reasons
+
+	if ( ! waitForYCPThread() )
 	    continue;
 
 	if ( _terminate_ui_thread )
@@ -381,16 +329,62 @@ void YUI::uiThreadMainLoop()
 	    return;
 	}
 
-	if ( _builtinCaller )
+	startBuiltinCalls();
+
+	YBuiltinCaller * caller = _handoff->popCaller();
+
+	if ( caller )
+	{
+	    do {
+		caller->call();
+	    } while ( ( caller = _handoff->popCaller() ) );
+	}
+	else if ( _builtinCaller )
 	    _builtinCaller->call();
 	else
 	    yuiError() << "No builtinCaller set" << endl;
 
+	endBuiltinCalls();
+
 	signalYCPThread();
     }
 }
 
 
+void YUI::callBuiltins( const std::vector<YBuiltinCaller *> & callers )
+{
+    if ( ! _withThreads || ! _uiThread )
+    {
+	startBuiltinCalls();
+
+	try
+	{
+	    for ( YBuiltinCaller * caller : callers )
+		caller->call();
+	}
+	catch ( ... )
+	{
+	    endBuiltinCalls();
+	    throw;
+	}
+
+	endBuiltinCalls();
+	return;
+    }
+
+    size_t i = 0;
+
+    while ( i < callers.size() )
+    {
+	while ( i < callers.size() && _handoff->pushCaller( callers[i] ) )
+	    i++;
+
+	signalUIThread();
+	waitForUIThread();
+    }
+}
+
+
 void YUI::setButtonOrderFromEnvironment()
 {
     YButtonOrder buttonOrder    = YButtonBox::layoutPolicy().buttonOrder;
@@ -27,6 +27,7 @@
 
 #include <pthread.h>
 #include <string>
+#include <vector>
 
 #include "YTypes.h"
 #include "YSettings.h"
@@ -38,6 +39,7 @@ class YWidgetFactory;
 class YOptionalWidgetFactory;
 class YEvent;
 class YBuiltinCaller;
+class YUIThreadHandoff;
 class YDialog;
 class YMacroPlayer;
 class YMacroRecorder;
@@ -219,6 +221,18 @@ public:
     void setBuiltinCaller( YBuiltinCaller * caller )
 	{ _builtinCaller = caller; }
 
+    /**
+     * Call a number of built-ins in the UI thread with as few round trips
+     * between the YCP thread and the UI thread as possible: Up to 64 callers
+     * are handed over at once. This is intended for sequences of UI calls
+     * that don't need any result before the next one, e.g. setting a number
+     * of widget properties.
+     *
+     * Without threads, the callers are simply called one after another.
+     * The callers remain owned by the caller of this method.
+     **/
+    void callBuiltins( const std::vector<YBuiltinCaller *> & callers );
+
     /**
      * UI-specific runPkgSelection method.
      *
@@ -259,6 +273,16 @@ protected:
      **/
     virtual void idleLoop( int fd_ycp ) = 0;
 
+    /**
+     * Called before and after the built-ins of one command from the YCP
+     * thread are called, i.e. one builtinCaller() call or all callers of one
+     * callBuiltins() round trip, and around callBuiltins() without threads.
+     * A UI can override this to write all screen changes of these calls at
+     * once. This default implementation does nothing.
+     **/
+    virtual void startBuiltinCalls() {}
+    virtual void endBuiltinCalls() {}
+
     /**
      * Tells the ui thread that it should terminate and waits
      * until it does so.
@@ -281,26 +305,23 @@ protected:
     virtual void uiThreadDestructor();
 
     /**
-     * Signals the ui thread by sending one byte through the pipe
-     * to it.
+     * Signals the ui thread that a command is waiting for it.
      **/
     void signalUIThread();
 
     /**
-     * Waits for the ui thread to send one byte through the pipe
-     * to the ycp thread and reads this byte from the pipe.
+     * Waits for the ui thread to signal that it is done with the command.
      **/
     bool waitForUIThread();
 
     /**
-     * Signals the ycp thread by sending one byte through the pipe
-     * to it.
+     * Signals the ycp thread that the ui thread is done with a command.
      **/
     void signalYCPThread();
 
     /**
-     * Waits for the ycp thread to send one byte through the pipe
-     * to the ycp thread and reads this byte from the pipe.
+     * Takes the next command signalled by the ycp thread. Returns 'false'
+     * if there is none.
      **/
     bool waitForYCPThread();
 
@@ -340,18 +361,11 @@ protected:
     YBuiltinCaller * _builtinCaller;
 
     /**
-     * Used to synchronize data transfer with the ui thread.
-     * It stores a pair of file descriptors of a pipe. For each YCP value
-     * we send to the ui thread, we write one aribrary byte here.
-     **/
-    int pipe_to_ui[2];
-
-    /**
-     * Used to synchronize data transfer with the ui thread.
-     * It stores a pair of file descriptors of a pipe. For each YCP value
-     * we get from the ui thread, we read one aribrary byte from here.
+     * Used to synchronize data transfer with the ui thread: Signals commands
+     * to the ui thread through an eventfd that idleLoop() waits for and the
+     * answers back to the ycp thread through a futex.
      **/
-    int pipe_from_ui[2];
+    YUIThreadHandoff * _handoff;
 
     /**
      * This is a flag that signals the ui thread that it should
@@ -25,9 +25,15 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <ostream>
 #include <fstream>
-#include <vector>
+#include <new>
+#include <sstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 #include <pthread.h>
 
 #define YUILogComponent "ui"
@@ -50,6 +56,31 @@ static void stdLogger( YUILogLevel_t	logLevel,
 static ostream * stdLogStream = &cerr;
 
 
+#define YUI_MAX_LOG_COMPONENTS	32
+
+/**
+ * Per-component minimum log level as set with
+ * YUILog::setComponentLogLevel().
+ *
+ * This is read without locking from every thread that logs, so entries are
+ * only ever appended, never removed: Resetting an entry only sets its
+ * minLogLevel to -1 ("use the default").
+ **/
+struct YComponentLogLevel
+{
+    string		logComponent;
+    std::atomic<int>	minLogLevel { -1 };
+};
+
+static YComponentLogLevel componentLogLevels[ YUI_MAX_LOG_COMPONENTS ];
+static std::atomic<int>   componentLogLevelCount( 0 );
+static std::mutex         componentLogLevelMutex; // for writers only
+
+
+std::atomic<int>  YUILog::_minLogLevel( YUI_LOG_MILESTONE );
+std::atomic<bool> YUILog::_fullLogLevelCheck( false );
+
+
 /**
  * Stream buffer class that will use the YUILog's logger function.
  *
@@ -107,6 +138,12 @@ public:
      **/
     void flush();
 
+    /**
+     * Return the part of 'fileNameWithPath' after the last slash.
+     * Unlike YUILog::basename(), this does not allocate anything.
+     **/
+    static const char * baseName( const char * fileNameWithPath );
+
 
 private:
 
@@ -124,37 +161,38 @@ private:
 std::streamsize
 YUILogBuffer::writeBuffer( const char * sequence, std::streamsize seqLen )
 {
-    // Add new character sequence
-
-    if ( seqLen > 0 )
-	buffer += string( sequence, seqLen );
-
     //
-    // Output buffer contents line by line
+    // Output the new character sequence line by line.
+    //
+    // The line buffer is reused for all lines of this thread, so after the
+    // first few lines this does not allocate anything anymore.
     //
 
-    size_t start       = 0;
-    size_t newline_pos = 0;
+    const char * start = sequence;
+    const char * end   = sequence + std::max( seqLen, (std::streamsize) 0 );
 
-    while ( start < buffer.length() &&
-	    ( newline_pos = buffer.find_first_of( '\n', start ) ) != string::npos )
+    while ( start < end )
     {
-	YUILoggerFunction loggerFunction = YUILog::loggerFunction( true ); // never return 0
+	const char * newline = (const char *) memchr( start, '\n', end - start );
+
+	if ( ! newline )
+	{
+	    buffer.append( start, end - start );
+	    break;
+	}
 
-	string line = buffer.substr( start, newline_pos - start );
+	buffer.append( start, newline - start );
+
+	YUILoggerFunction loggerFunction = YUILog::loggerFunction( true ); // never return 0
 
 	loggerFunction( logLevel, logComponent,
-			YUILog::basename( sourceFileName ).c_str(), lineNo, functionName,
-			line.c_str() );
+			baseName( sourceFileName ), lineNo, functionName,
+			buffer.c_str() );
 
-	start = newline_pos + 1;
+	buffer.clear(); // This keeps the capacity
+	start = newline + 1;
     }
 
-    if ( start < buffer.length() )
-	buffer = buffer.substr( start, string::npos );
-    else
-	buffer.clear();
-
     return seqLen;
 }
 
@@ -181,10 +219,385 @@ YUILogBuffer::overflow( int ch )
 
 void YUILogBuffer::flush()
 {
-    writeBuffer( "\n", 1 );
+    if ( ! buffer.empty() )
+	writeBuffer( "\n", 1 );
+}
+
+
+const char *
+YUILogBuffer::baseName( const char * fileNameWithPath )
+{
+    if ( ! fileNameWithPath )
+	return 0;
+
+    const char * lastSlash = strrchr( fileNameWithPath, '/' );
+
+    return lastSlash ? lastSlash + 1 : fileNameWithPath;
+}
+
+
+
+
+
+/**
+ * Asynchronous writer for the standard logger function.
+ *
+ * Any thread that logs only formats its log line and pushes it into a
+ * bounded lock-free ring buffer; a background thread takes all lines that
+ * have accumulated there and writes them to the log stream in one batch.
+ * This keeps the write() system calls (and slow log file storage) away from
+ * the UI thread.
+ *
+ * Log lines with a log level of at least 'flushLevel' are written
+ * synchronously in the sense that the logging thread waits until the writer
+ * thread has written that line (and everything before it), so error
+ * messages right before a crash don't get lost.
+ *
+ * The ring buffer is a multi-producer / single-consumer variant of Dmitry
+ * Vyukov's bounded queue: Each slot has a sequence number that tells
+ * producers and the consumer whose turn it is.
+ **/
+class YUIAsyncLogWriter
+{
+public:
+
+    /**
+     * Constructor. This does not start the writer thread yet.
+     **/
+    YUIAsyncLogWriter();
+
+    /**
+     * Destructor. This drains the queue and stops the writer thread.
+     **/
+    ~YUIAsyncLogWriter()
+	{ stop(); }
+
+    /**
+     * Start the writer thread if it is not running yet.
+     **/
+    void start( YUILogLevel_t flushLevel );
+
+    /**
+     * Write everything that is still queued and stop the writer thread.
+     **/
+    void stop();
+
+    /**
+     * Return 'true' if the writer thread is running.
+     **/
+    bool isRunning() const { return _running.load( std::memory_order_acquire ); }
+
+    /**
+     * Queue one log line (including the trailing newline) for writing.
+     * If the queue is full, this waits until there is free space again.
+     **/
+    void write( YUILogLevel_t logLevel, string && line );
+
+    /**
+     * Wait until everything that was queued before this call is written.
+     **/
+    void drain();
+
+    /**
+     * Lock this while using or changing stdLogStream while the writer
+     * thread might be running.
+     **/
+    std::mutex & streamMutex() { return _streamMutex; }
+
+    /**
+     * Forget about the writer thread in a child process after fork():
+     * The thread does not exist there, and the parent writes whatever
+     * is still queued.
+     **/
+    void forgetAfterFork();
+
+
+private:
+
+    // Without a log line at the flush level, the writer thread is only
+    // woken up when WakeUpFill lines are queued; otherwise it writes what
+    // has been queued every FlushInterval milliseconds.
+
+    enum { Capacity = 4096, MaxBatchSize = 512, WakeUpFill = 512, FlushInterval = 100 };
+
+    struct Slot
+    {
+	std::atomic<size_t>	seq;
+	string			line;
+    };
+
+    void clear();
+    bool tryPush( string & line, size_t & ticket );
+    bool tryPop ( string & line );
+    void wakeUp();
+    void waitUntilWritten( size_t ticket );
+    void run();
+
+    Slot			_slots[ Capacity ];
+    std::atomic<size_t>		_enqueuePos;
+    size_t			_dequeuePos;	// only used by the writer thread
+    std::atomic<size_t>		_writtenCount;
+
+    std::atomic<bool>		_running;
+    std::atomic<bool>		_stopRequested;
+    std::atomic<bool>		_sleeping;
+    std::atomic<int>		_flushLevel;
+
+    std::thread			_thread;
+    std::mutex			_mutex;		// for the condition variables
+    std::condition_variable	_wakeUpCond;
+    std::condition_variable	_writtenCond;
+    std::mutex			_streamMutex;
+};
+
+
+static YUIAsyncLogWriter asyncLogWriter;
+
+
+YUIAsyncLogWriter::YUIAsyncLogWriter()
+    : _enqueuePos( 0 )
+    , _dequeuePos( 0 )
+    , _writtenCount( 0 )
+    , _running( false )
+    , _stopRequested( false )
+    , _sleeping( false )
+    , _flushLevel( YUI_LOG_ERROR )
+{
+    clear();
+}
+
+
+void
+YUIAsyncLogWriter::clear()
+{
+    for ( size_t i=0; i < Capacity; i++ )
+    {
+	_slots[i].seq.store( i, std::memory_order_relaxed );
+	_slots[i].line.clear();
+    }
+
+    _enqueuePos.store( 0 );
+    _dequeuePos = 0;
+    _writtenCount.store( 0 );
+}
+
+
+void
+YUIAsyncLogWriter::start( YUILogLevel_t flushLevel )
+{
+    static std::once_flag atForkOnce;
+
+    std::call_once( atForkOnce, []()
+	{ pthread_atfork( 0, 0, []() { asyncLogWriter.forgetAfterFork(); } ); } );
+
+    _flushLevel = flushLevel;
+
+    if ( isRunning() )
+	return;
+
+    _stopRequested.store( false );
+    _thread = std::thread( &YUIAsyncLogWriter::run, this );
+    _running.store( true, std::memory_order_release );
+}
+
+
+void
+YUIAsyncLogWriter::stop()
+{
+    if ( ! isRunning() )
+	return;
+
+    drain();
+
+    _stopRequested.store( true );
+    wakeUp();
+    _thread.join();
+    _running.store( false, std::memory_order_release );
+}
+
+
+void
+YUIAsyncLogWriter::forgetAfterFork()
+{
+    if ( ! isRunning() )
+	return;
+
+    // The writer thread does not exist in the child, so it can't be joined
+    // or detached, and it might have held any of the mutexes during fork().
+    // Simply start over with fresh objects.
+
+    new ( &_thread )	  std::thread();
+    new ( &_mutex )	  std::mutex();
+    new ( &_wakeUpCond )  std::condition_variable();
+    new ( &_writtenCond ) std::condition_variable();
+    new ( &_streamMutex ) std::mutex();
+
+    clear();
+    _stopRequested.store( false );
+    _sleeping.store( false );
+    _running.store( false );
+}
+
+
+void
+YUIAsyncLogWriter::write( YUILogLevel_t logLevel, string && line )
+{
+    size_t ticket = 0;
+
+    while ( ! tryPush( line, ticket ) )
+    {
+	// Queue full: Make sure the writer is busy and give it some time
+
+	wakeUp();
+	std::this_thread::yield();
+    }
+
+    if ( logLevel >= _flushLevel.load( std::memory_order_relaxed ) )
+    {
+	wakeUp();
+	waitUntilWritten( ticket );
+    }
+    else if ( ticket - _writtenCount.load( std::memory_order_relaxed ) >= WakeUpFill )
+    {
+	// Pairs with the writer thread setting _sleeping and then checking
+	// the fill level once more: One of the two is bound to notice.
+	// Only the first line above the watermark wakes it up.
+
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+
+	if ( _sleeping.exchange( false ) )
+	    wakeUp();
+    }
+}
+
+
+void
+YUIAsyncLogWriter::drain()
+{
+    wakeUp();
+    waitUntilWritten( _enqueuePos.load() );
+}
+
+
+bool
+YUIAsyncLogWriter::tryPush( string & line, size_t & ticket )
+{
+    size_t pos = _enqueuePos.load( std::memory_order_relaxed );
+    Slot * slot;
+
+    while ( true )
+    {
+	slot = &_slots[ pos % Capacity ];
+	size_t   seq  = slot->seq.load( std::memory_order_acquire );
+	intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+	if ( diff == 0 )
+	{
+	    if ( _enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+		break;
+	}
+	else if ( diff < 0 )	// The writer has not yet taken the line from a full round ago
+	{
+	    return false;
+	}
+	else
+	{
+	    pos = _enqueuePos.load( std::memory_order_relaxed );
+	}
+    }
+
+    slot->line.swap( line );
+    slot->seq.store( pos + 1, std::memory_order_release );
+    ticket = pos + 1;
+
+    return true;
+}
+
+
+bool
+YUIAsyncLogWriter::tryPop( string & line )
+{
+    Slot * slot = &_slots[ _dequeuePos % Capacity ];
+
+    if ( slot->seq.load( std::memory_order_acquire ) != _dequeuePos + 1 )
+	return false;
+
+    line.swap( slot->line );
+    slot->line.clear();
+    slot->seq.store( _dequeuePos + Capacity, std::memory_order_release );
+    ++_dequeuePos;
+
+    return true;
+}
+
+
+void
+YUIAsyncLogWriter::wakeUp()
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    _wakeUpCond.notify_one();
+}
+
+
+void
+YUIAsyncLogWriter::waitUntilWritten( size_t ticket )
+{
+    std::unique_lock<std::mutex> lock( _mutex );
+
+    _writtenCond.wait( lock, [this, ticket]()
+	{ return _writtenCount.load() >= ticket || ! isRunning(); } );
 }
 
 
+void
+YUIAsyncLogWriter::run()
+{
+    string batch;
+    string line;
+
+    while ( true )
+    {
+	batch.clear();
+	int count = 0;
+
+	while ( count < MaxBatchSize && tryPop( line ) )
+	{
+	    batch += line;
+	    ++count;
+	}
+
+	if ( count > 0 )
+	{
+	    {
+		std::lock_guard<std::mutex> lock( _streamMutex );
+		stdLogStream->write( batch.data(), batch.size() );
+		stdLogStream->flush();
+	    }
+
+	    std::lock_guard<std::mutex> lock( _mutex );
+	    _writtenCount.store( _dequeuePos );
+	    _writtenCond.notify_all();
+
+	    continue;
+	}
+
+	std::unique_lock<std::mutex> lock( _mutex );
+
+	if ( _stopRequested.load() )
+	    break;
+
+	_sleeping.store( true );
+
+	// Check again now that the producers know they need to wake us up.
+	// Lines below the watermark are written after the timeout.
+
+	if ( _enqueuePos.load() - _dequeuePos < WakeUpFill )
+	    _wakeUpCond.wait_for( lock, std::chrono::milliseconds( FlushInterval ) );
+
+	_sleeping.store( false );
+    }
+}
+
 
 
 
@@ -208,6 +621,10 @@ void YUILogBuffer::flush()
  * formatting, not writing another thread's data structures without control -
  * which can easily happen if multiple threads are working on the same output
  * buffer, i.e. manipulate the same string.
+ *
+ * There is one instance of this as a thread_local variable in each thread
+ * that logs anything; it is created upon the first log call of that thread
+ * and destroyed (flushing any incomplete line) when the thread exits.
  **/
 struct YPerThreadLogInfo
 {
@@ -215,12 +632,9 @@ struct YPerThreadLogInfo
      * Constructor
      **/
     YPerThreadLogInfo()
-	: threadHandle( pthread_self() )
-	, logBuffer()
+	: logBuffer()
 	, logStream( &logBuffer )
-        {
-            // cerr << "New thread with ID " << hex << threadHandle << dec << endl;
-        }
+        {}
 
     /**
      * Destructor
@@ -231,11 +645,14 @@ struct YPerThreadLogInfo
         }
 
     /**
-     * Check if this per-thread logging information belongs to the specified thread.
+     * Return the per-thread logging information for the current thread.
+     * Create a new one if it doesn't exist yet.
      **/
-    bool isThread( pthread_t otherThreadHandle )
+    static YPerThreadLogInfo & currentThread()
         {
-            return pthread_equal( otherThreadHandle, this->threadHandle );
+            static thread_local YPerThreadLogInfo threadLogInfo;
+
+            return threadLogInfo;
         }
 
 
@@ -243,7 +660,6 @@ struct YPerThreadLogInfo
     // Data members
     //
 
-    pthread_t		threadHandle;
     YUILogBuffer	logBuffer;
     ostream             logStream;
 };
@@ -263,41 +679,6 @@ struct YUILogPrivate
 	, enableDebugLogging( false )
 	{}
 
-    /**
-     * Destructor
-     **/
-    ~YUILogPrivate()
-        {
-            for ( unsigned i=0; i < threadLogInfo.size(); i++ )
-                delete threadLogInfo[i];
-        }
-
-    /**
-     * Find the per-thread logging information for the current thread.
-     * Create a new one if it doesn't exist yet.
-     **/
-    YPerThreadLogInfo * findCurrentThread()
-        {
-            pthread_t thisThread = pthread_self();
-
-            // Search backwards: Slight optimization for the UI.
-            // The UI thread does the most logging, but it is created after the
-            // main thread.
-
-            for ( std::vector<YPerThreadLogInfo *>::reverse_iterator it = threadLogInfo.rbegin();
-                  it != threadLogInfo.rend();
-                  ++it )
-            {
-                if ( (*it)->isThread( thisThread ) )
-                    return (*it);
-            }
-
-            YPerThreadLogInfo * newThreadLogInfo = new YPerThreadLogInfo();
-            threadLogInfo.push_back( newThreadLogInfo );
-
-            return newThreadLogInfo;
-        }
-
     //
     // Data members
     //
@@ -308,8 +689,6 @@ struct YUILogPrivate
     YUIEnableDebugLoggingFunction	enableDebugLoggingHook;
     YUIDebugLoggingEnabledFunction	debugLoggingEnabledHook;
     bool				enableDebugLogging;
-
-    std::vector<YPerThreadLogInfo *>    threadLogInfo;
 };
 
 
@@ -324,6 +703,8 @@ YUILog::YUILog()
 
 YUILog::~YUILog()
 {
+    asyncLogWriter.stop();
+
     if ( priv->stdLogStream.is_open() )
 	priv->stdLogStream.close();
 }
@@ -349,6 +730,12 @@ YUILog::setLogFileName( const string & logFileName )
 {
     instance()->priv->logFileName = logFileName;
 
+    // Write anything still queued for the old log file to that file
+
+    if ( asyncLogWriter.isRunning() )
+	asyncLogWriter.drain();
+
+    std::lock_guard<std::mutex> lock( asyncLogWriter.streamMutex() );
     std::ofstream & logStream = instance()->priv->stdLogStream;
 
     if ( logStream.is_open() )
@@ -380,6 +767,33 @@ YUILog::setLogFileName( const string & logFileName )
 }
 
 
+void
+YUILog::setAsyncLogging( bool async, YUILogLevel_t flushLevel )
+{
+    if ( async )
+	asyncLogWriter.start( flushLevel );
+    else
+	asyncLogWriter.stop();
+}
+
+
+bool
+YUILog::asyncLogging()
+{
+    return asyncLogWriter.isRunning();
+}
+
+
+void
+YUILog::flushLog()
+{
+    if ( asyncLogWriter.isRunning() )
+	asyncLogWriter.drain();
+    else
+	stdLogStream->flush();
+}
+
+
 string
 YUILog::logFileName()
 {
@@ -394,6 +808,8 @@ YUILog::enableDebugLogging( bool debugLogging )
 
     if ( instance()->priv->enableDebugLoggingHook )
 	instance()->priv->enableDebugLoggingHook( debugLogging );
+
+    updateLogLevelCheck();
 }
 
 
@@ -435,6 +851,8 @@ YUILog::setEnableDebugLoggingHooks( YUIEnableDebugLoggingFunction  enableFunctio
 {
     instance()->priv->enableDebugLoggingHook  = enableFunction;
     instance()->priv->debugLoggingEnabledHook = isEnabledFunction;
+
+    updateLogLevelCheck();
 }
 
 
@@ -452,6 +870,120 @@ YUILog::debugLoggingEnabledHook()
 }
 
 
+void
+YUILog::setComponentLogLevel( const string & logComponent, YUILogLevel_t minLogLevel )
+{
+    {
+	std::lock_guard<std::mutex> lock( componentLogLevelMutex );
+
+	int count = componentLogLevelCount.load();
+	int i     = 0;
+
+	while ( i < count && componentLogLevels[i].logComponent != logComponent )
+	    ++i;
+
+	if ( i == count )
+	{
+	    if ( count >= YUI_MAX_LOG_COMPONENTS )
+		YUI_THROW( YUIException( "Too many log components" ) );
+
+	    componentLogLevels[i].logComponent = logComponent;
+	    componentLogLevels[i].minLogLevel.store( minLogLevel );
+	    componentLogLevelCount.store( count + 1, std::memory_order_release );
+	}
+	else
+	{
+	    componentLogLevels[i].minLogLevel.store( minLogLevel );
+	}
+    }
+
+    updateLogLevelCheck();
+}
+
+
+void
+YUILog::resetComponentLogLevels()
+{
+    {
+	std::lock_guard<std::mutex> lock( componentLogLevelMutex );
+	int count = componentLogLevelCount.load();
+
+	for ( int i=0; i < count; i++ )
+	    componentLogLevels[i].minLogLevel.store( -1 );
+    }
+
+    updateLogLevelCheck();
+}
+
+
+void
+YUILog::updateLogLevelCheck()
+{
+    YUILogPrivate * priv = instance()->priv.get();
+
+    bool fullCheck = priv->debugLoggingEnabledHook != 0;
+    int  minLevel  = ( priv->enableDebugLogging || fullCheck ) ?
+	YUI_LOG_DEBUG : YUI_LOG_MILESTONE;
+
+    {
+	std::lock_guard<std::mutex> lock( componentLogLevelMutex );
+	int count = componentLogLevelCount.load();
+
+	for ( int i=0; i < count; i++ )
+	{
+	    int level = componentLogLevels[i].minLogLevel.load();
+
+	    if ( level >= 0 )
+	    {
+		fullCheck = true;
+		minLevel  = std::min( minLevel, level );
+	    }
+	}
+    }
+
+    _minLogLevel.store( minLevel );
+    _fullLogLevelCheck.store( fullCheck );
+}
+
+
+bool
+YUILog::checkLogLevel( YUILogLevel_t logLevel, const char * logComponent )
+{
+    if ( logComponent )
+    {
+	int count = componentLogLevelCount.load( std::memory_order_acquire );
+
+	for ( int i=0; i < count; i++ )
+	{
+	    if ( componentLogLevels[i].logComponent == logComponent )
+	    {
+		int level = componentLogLevels[i].minLogLevel.load( std::memory_order_relaxed );
+
+		if ( level >= 0 )
+		    return logLevel >= level;
+
+		break;
+	    }
+	}
+    }
+
+    if ( logLevel == YUI_LOG_DEBUG )
+	return debugLoggingEnabled();
+
+    return true;
+}
+
+
+ostream &
+YUILog::nullStream()
+{
+    // One per thread: Failed output operations still set the stream state.
+    static thread_local ostream stream( 0 );
+
+    return stream;
+}
+
+
 ostream &
 YUILog::log( YUILogLevel_t	logLevel,
 	     const char *	logComponent,
@@ -459,7 +991,7 @@ YUILog::log( YUILogLevel_t	logLevel,
 	     int 		lineNo,
 	     const char * 	functionName )
 {
-    YPerThreadLogInfo * threadLogInfo = priv->findCurrentThread();
+    YPerThreadLogInfo * threadLogInfo = &YPerThreadLogInfo::currentThread();
 
     if ( ! threadLogInfo->logBuffer.buffer.empty() )	// Leftovers from previous logging?
     {
@@ -537,14 +1069,12 @@ stdLogger( YUILogLevel_t	logLevel,
 {
     const char * logLevelStr = "";
 
+    if ( ! YUILog::logLevelEnabled( logLevel, logComponent ) )
+	return;
+
     switch ( logLevel )
     {
-	case YUI_LOG_DEBUG:
-	    if ( ! YUILog::debugLoggingEnabled() )
-		return;
-
-	    logLevelStr = "dbg";
-	    break;
+	case YUI_LOG_DEBUG:	logLevelStr = "dbg";	break;
 
 	case YUI_LOG_MILESTONE:	logLevelStr = "_M_";	break;
 	case YUI_LOG_WARNING:	logLevelStr = "WRN";	break;
@@ -563,6 +1093,22 @@ stdLogger( YUILogLevel_t	logLevel,
     if ( ! message )
 	message = "";
 
+    if ( asyncLogWriter.isRunning() )
+    {
+	static thread_local std::ostringstream lineStream;
+
+	lineStream.str( "" );
+	lineStream << "<" << logLevelStr  << "> "
+		   << "[" << logComponent << "] "
+		   << sourceFileName	  << ":" << sourceLineNo << " "
+		   << sourceFunctionName  << "(): "
+		   << message
+		   << '\n';
+
+	asyncLogWriter.write( logLevel, lineStream.str() );
+	return;
+    }
+
     (*stdLogStream) << "<" << logLevelStr  << "> "
 		    << "[" << logComponent << "] "
 		    << sourceFileName	   << ":" << sourceLineNo << " "
@@ -30,6 +30,7 @@
 
 #include <iostream>
 #include <string>
+#include <atomic>
 
 #include "ImplPtr.h"
 
@@ -53,17 +54,26 @@ using std::endl;
 // Unless the underlying logger function handles this differently,
 // Milestone, Warning and Error are always logged, Debug only when enabled.
 //
+// If the log level is disabled for that component, the macros return a
+// stream that is in a failed state, so none of the operator<<() calls
+// will do any formatting. Notice that the arguments are still evaluated.
+//
 
-#define yuiDebug()	YUILog::debug    ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
-#define yuiMilestone()	YUILog::milestone( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
-#define yuiWarning()	YUILog::warning  ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
-#define yuiError()	YUILog::error    ( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ )
+#define yuiDebug()	YUI_LOG_STREAM( YUI_LOG_DEBUG,     debug     )
+#define yuiMilestone()	YUI_LOG_STREAM( YUI_LOG_MILESTONE, milestone )
+#define yuiWarning()	YUI_LOG_STREAM( YUI_LOG_WARNING,   warning   )
+#define yuiError()	YUI_LOG_STREAM( YUI_LOG_ERROR,     error     )
 
 
 //
 // ------ End of user relevant part ------
 //
 
+#define YUI_LOG_STREAM( LEVEL, FUNC )						\
+    ( YUILog::logLevelEnabled( LEVEL, YUILogComponent ) ?			\
+      YUILog::FUNC( YUILogComponent, __FILE__, __LINE__, __FUNCTION__ ) :	\
+      YUILog::nullStream() )
+
 
 
 class YUILogPrivate;
@@ -118,6 +128,53 @@ public:
 			int 		lineNo,
 			const char * 	functionName );
 
+    /**
+     * Return 'true' if a message with log level 'logLevel' from
+     * 'logComponent' would be logged at all.
+     *
+     * This is called for every use of the yuiDebug() etc. macros, so the
+     * common case is just one atomic load and one comparison. Only if
+     * per-component log levels or a debug logging hook are set up, the
+     * (slower) full check is done.
+     **/
+    static bool logLevelEnabled( YUILogLevel_t logLevel, const char * logComponent )
+    {
+	if ( logLevel < _minLogLevel.load( std::memory_order_relaxed ) )
+	    return false;
+
+	if ( ! _fullLogLevelCheck.load( std::memory_order_relaxed ) )
+	    return true;
+
+	return checkLogLevel( logLevel, logComponent );
+    }
+
+    /**
+     * Return a stream that discards everything that is written to it.
+     * This is what the yuiDebug() etc. macros use for disabled log levels.
+     **/
+    static std::ostream & nullStream();
+
+    /**
+     * Set the minimum log level for one log component, overriding the
+     * default (Debug if debug logging is enabled, Milestone otherwise).
+     *
+     * This can be used both to silence a very chatty component and to
+     * enable debug logging for just one component, e.g.
+     *
+     *     YUILog::setComponentLogLevel( "ncurses", YUI_LOG_WARNING );
+     *     YUILog::setComponentLogLevel( "qt-pkg",  YUI_LOG_DEBUG   );
+     *
+     * Only a limited number of components can be set up this way;
+     * this throws an exception if there are too many.
+     **/
+    static void setComponentLogLevel( const std::string & logComponent,
+				      YUILogLevel_t	  minLogLevel );
+
+    /**
+     * Remove all per-component log levels set with setComponentLogLevel().
+     **/
+    static void resetComponentLogLevels();
+
     /**
      * Return the singleton object for this class.
      * This will create the singleton if it doesn't exist yet.
@@ -165,6 +222,36 @@ public:
      **/
     static std::string logFileName();
 
+    /**
+     * Enable or disable asynchronous log writing for the standard logger
+     * function: Log lines are then only queued by the thread that logs, and
+     * a background thread writes them to the log file (or stderr) in
+     * batches. This takes the log file I/O away from the UI event loop.
+     *
+     * Log lines with a log level of 'flushLevel' or higher are still
+     * guaranteed to be written when the log call returns. Other lines are
+     * written in batches at least every 100 milliseconds.
+     *
+     * Disabling asynchronous logging writes everything that is still
+     * queued. This is also done automatically when the program exits.
+     *
+     * Like setLogFileName(), this is not relevant for custom logger
+     * functions.
+     **/
+    static void setAsyncLogging( bool	       async	  = true,
+				 YUILogLevel_t flushLevel = YUI_LOG_ERROR );
+
+    /**
+     * Return 'true' if asynchronous log writing is enabled.
+     **/
+    static bool asyncLogging();
+
+    /**
+     * Make sure everything logged so far with the standard logger function
+     * is written to the log file.
+     **/
+    static void flushLog();
+
     /**
      * Set the UI logger function. This is the function that will ultimately
      * receive all UI log output (except debug logging if debug logging is
@@ -229,11 +316,26 @@ private:
      **/
     ~YUILog();
 
+    /**
+     * The slow part of logLevelEnabled(): Check per-component log levels
+     * and the debug logging hook.
+     **/
+    static bool checkLogLevel( YUILogLevel_t logLevel, const char * logComponent );
+
+    /**
+     * Recalculate _minLogLevel and _fullLogLevelCheck after any change of
+     * the debug logging flag, the hooks or the per-component log levels.
+     **/
+    static void updateLogLevelCheck();
+
     //
     // Data
     //
 
     ImplPtr<YUILogPrivate> priv;
+
+    static std::atomic<int>  _minLogLevel;
+    static std::atomic<bool> _fullLogLevelCheck;
 };
 
 
@@ -163,6 +163,9 @@
 
 
 // Widget properties
+//
+// When adding a property here, also add it to enum YPropertyId in
+// YProperty.h and to the name table in YProperty.cc.
 
 #define YUIProperty_Alive			"Alive"
 #define YUIProperty_Cell			"Cell"
@@ -0,0 +1,216 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+#include <string.h>		// strerror()
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <thread>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YUIThreadHandoff.h"
+
+
+static inline void
+cpuRelax()
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    __builtin_ia32_pause();
+#endif
+}
+
+
+static inline int *
+futexWord( std::atomic<unsigned> & word )
+{
+    return reinterpret_cast<int *>( &word );
+}
+
+
+YUIThreadHandoff::YUIThreadHandoff()
+    : _fd( -1 )
+    , _spinCount( std::thread::hardware_concurrency() > 1 ? SpinCount : 0 )
+    , _commands( 0 )
+    , _takenCommands( 0 )
+    , _uiWaiting( false )
+    , _done( 0 )
+    , _takenDone( 0 )
+    , _ycpWaiting( false )
+    , _batchHead( 0 )
+    , _batchTail( 0 )
+{
+}
+
+
+YUIThreadHandoff::~YUIThreadHandoff()
+{
+    close();
+}
+
+
+bool YUIThreadHandoff::init()
+{
+    _fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+    if ( _fd < 0 )
+    {
+	yuiError() << "eventfd() failed: errno: " << errno << " " << strerror( errno ) << endl;
+	return false;
+    }
+
+    return true;
+}
+
+
+void YUIThreadHandoff::close()
+{
+    if ( _fd >= 0 )
+    {
+	::close( _fd );
+	_fd = -1;
+    }
+}
+
+
+void YUIThreadHandoff::postCommand()
+{
+    _commands.fetch_add( 1 );
+
+    // Only make a syscall if the UI thread really waits for the fd
+
+    if ( _uiWaiting.load() )
+    {
+	uint64_t one = 1;
+
+	if ( write( _fd, &one, sizeof( one ) ) == -1 )
+	    yuiError() << "Signalling the UI thread failed: errno: " << errno << endl;
+    }
+}
+
+
+void YUIThreadHandoff::waitForDone()
+{
+    for ( int i=0; i < _spinCount && _done.load( std::memory_order_acquire ) == _takenDone; i++ )
+	cpuRelax();
+
+    while ( _done.load( std::memory_order_acquire ) == _takenDone )
+    {
+	_ycpWaiting.store( true );
+
+	if ( _done.load() == _takenDone )
+	    syscall( SYS_futex, futexWord( _done ), FUTEX_WAIT_PRIVATE, _takenDone, 0, 0, 0 );
+
+	_ycpWaiting.store( false, std::memory_order_relaxed );
+    }
+
+    _takenDone++;
+}
+
+
+bool YUIThreadHandoff::pushCaller( YBuiltinCaller * caller )
+{
+    unsigned tail = _batchTail.load( std::memory_order_relaxed );
+
+    if ( tail - _batchHead.load( std::memory_order_acquire ) >= BatchSize )
+	return false;
+
+    _batch[ tail % BatchSize ] = caller;
+    _batchTail.store( tail + 1, std::memory_order_release );
+
+    return true;
+}
+
+
+bool YUIThreadHandoff::spinForCommand()
+{
+    for ( int i=0; i < _spinCount; i++ )
+    {
+	if ( _commands.load( std::memory_order_acquire ) != _takenCommands )
+	    return true;
+
+	cpuRelax();
+    }
+
+    return false;
+}
+
+
+bool YUIThreadHandoff::waitingForCommand( bool waiting )
+{
+    if ( waiting )
+    {
+	_uiWaiting.store( true );
+
+	if ( _commands.load() != _takenCommands )
+	{
+	    _uiWaiting.store( false );
+	    return false;
+	}
+    }
+    else
+    {
+	_uiWaiting.store( false );
+
+	// Reset the eventfd so it doesn't stay readable
+
+	uint64_t count;
+
+	if ( read( _fd, &count, sizeof( count ) ) == -1 && errno != EAGAIN )
+	    yuiError() << "Reading from the YCP thread failed: errno: " << errno << endl;
+    }
+
+    return true;
+}
+
+
+bool YUIThreadHandoff::takeCommand()
+{
+    if ( _commands.load( std::memory_order_acquire ) == _takenCommands )
+	return false;
+
+    _takenCommands++;
+
+    return true;
+}
+
+
+YBuiltinCaller * YUIThreadHandoff::popCaller()
+{
+    unsigned head = _batchHead.load( std::memory_order_relaxed );
+
+    if ( head == _batchTail.load( std::memory_order_acquire ) )
+	return 0;
+
+    YBuiltinCaller * caller = _batch[ head % BatchSize ];
+    _batchHead.store( head + 1, std::memory_order_release );
+
+    return caller;
+}
+
+
+void YUIThreadHandoff::signalDone()
+{
+    _done.fetch_add( 1 );
+
+    if ( _ycpWaiting.load() )
+	syscall( SYS_futex, futexWord( _done ), FUTEX_WAKE_PRIVATE, 1, 0, 0, 0 );
+}
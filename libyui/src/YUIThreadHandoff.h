@@ -0,0 +1,141 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YUIThreadHandoff_h
+#define YUIThreadHandoff_h
+
+#include <atomic>
+
+
+class YBuiltinCaller;
+
+
+/**
+ * Internal helper class for YUI: Hand off control between the YCP thread
+ * (the application) and the UI thread.
+ *
+ * The YCP thread posts a command to the UI thread and waits until the UI
+ * thread signals that it is done. The UI thread waits for commands in the
+ * UI's idle loop which needs a file descriptor to wait for, so commands are
+ * signalled with an eventfd - but only if the UI thread is actually about to
+ * wait for it. On multi-CPU machines both sides first spin for a moment
+ * before blocking since the other side usually answers very quickly; the YCP
+ * thread then blocks on a futex.
+ *
+ * In addition to the plain command signal, the YCP thread can queue a batch
+ * of YBuiltinCallers in a lock-free single producer / single consumer ring
+ * to be called by the UI thread in one round trip.
+ **/
+class YUIThreadHandoff
+{
+public:
+
+    YUIThreadHandoff();
+    ~YUIThreadHandoff();
+
+    /**
+     * Create the eventfd. Return 'false' on error.
+     **/
+    bool init();
+
+    /**
+     * Close the eventfd.
+     **/
+    void close();
+
+    /**
+     * The file descriptor that becomes readable when a command is posted
+     * while the UI thread waits (see waitingForCommand()).
+     **/
+    int fd() const { return _fd; }
+
+    //
+    // YCP thread side
+    //
+
+    /**
+     * Post one command to the UI thread.
+     **/
+    void postCommand();
+
+    /**
+     * Wait until the UI thread signals that it is done with a command.
+     **/
+    void waitForDone();
+
+    /**
+     * Add a caller to the batch for the next command. Return 'false' if the
+     * batch is full.
+     **/
+    bool pushCaller( YBuiltinCaller * caller );
+
+    //
+    // UI thread side
+    //
+
+    /**
+     * Spin for a moment until a command is posted. Return 'true' if there
+     * is one.
+     **/
+    bool spinForCommand();
+
+    /**
+     * Notify the YCP thread that the UI thread is about to wait for fd()
+     * ('waiting' = true) or has stopped doing so ('waiting' = false).
+     *
+     * Return 'false' if the UI thread should not wait since a command is
+     * already pending.
+     **/
+    bool waitingForCommand( bool waiting );
+
+    /**
+     * Take one posted command. Return 'false' if there is none.
+     **/
+    bool takeCommand();
+
+    /**
+     * Take the next caller of the batch or return 0 if there is none.
+     **/
+    YBuiltinCaller * popCaller();
+
+    /**
+     * Signal the YCP thread that the UI thread is done with a command.
+     **/
+    void signalDone();
+
+
+private:
+
+    enum { BatchSize = 64, SpinCount = 4000 };
+
+    int				_fd;
+    int				_spinCount;	// no spinning on a single CPU
+
+    std::atomic<unsigned>	_commands;	// posted by the YCP thread
+    unsigned			_takenCommands;	// UI thread only
+    std::atomic<bool>		_uiWaiting;
+
+    std::atomic<unsigned>	_done;		// futex word, signalled by the UI thread
+    unsigned			_takenDone;	// YCP thread only
+    std::atomic<bool>		_ycpWaiting;
+
+    YBuiltinCaller *		_batch[ BatchSize ];
+    std::atomic<unsigned>	_batchHead;	// written by the UI thread
+    std::atomic<unsigned>	_batchTail;	// written by the YCP thread
+};
+
+
+#endif // YUIThreadHandoff_h
@@ -42,6 +42,7 @@
 #include "YMacroRecorder.h"
 
 #include "YChildrenManager.h"
+#include "YArena.h"
 
 #define MAX_DEBUG_LABEL_LEN	50
 #define YWIDGET_MAGIC		42
@@ -75,8 +76,22 @@ struct YWidgetPrivate
 	stretch.vert	= false;
 	weight.hor	= 0;
 	weight.vert	= 0;
+	preferredSize.hor	= 0;
+	preferredSize.vert	= 0;
+	preferredSizePass.hor	= 0;
+	preferredSizePass.vert	= 0;
     }
 
+    /**
+     * Allocate the private data from the current arena, like the widget
+     * itself.
+     **/
+    static void * operator new( size_t size )
+	{ return YArena::allocate( size ); }
+
+    static void operator delete( void * ptr, size_t size )
+	{ YArena::deallocate( ptr, size ); }
+
     //
     // Data members
     //
@@ -93,6 +108,8 @@ struct YWidgetPrivate
     YWidgetID *			id;
     YBothDim<bool>		stretch;
     YBothDim<int>		weight;
+    YBothDim<int>		preferredSize;		// memoized by cachedPreferredSize()
+    YBothDim<unsigned>		preferredSizePass;	// layout pass of preferredSize
     int				functionKey;
     string			helpText;
 };
@@ -102,6 +119,33 @@ struct YWidgetPrivate
 
 bool YWidget::_usedOperatorNew = false;
 
+/**
+ * The current layout pass for cachedPreferredSize(). Memoized preferred sizes
+ * are only valid if they were computed during this pass and while a layout
+ * pass is in progress at all: Toolkit widgets don't report changes of their
+ * content (labels, items) that affect their preferred size, so anything
+ * memoized in a previous layout pass might be stale.
+ **/
+static unsigned	layoutPass	= 1;
+static int	layoutPassDepth	= 0;
+
+
+/**
+ * Return the dialog whose widget ID index 'widget' belongs to or 0 if it
+ * does not belong to any dialog (yet) or if that dialog is being destroyed
+ * anyway.
+ **/
+static YDialog *
+widgetIdIndexDialog( YWidget * widget )
+{
+    while ( widget->parent() )
+	widget = widget->parent();
+
+    YDialog * dialog = dynamic_cast<YDialog *>( widget );
+
+    return ( dialog && ! dialog->beingDestroyed() ) ? dialog : 0;
+}
+
 
 YWidget::YWidget( YWidget * parent )
     : _magic( YWIDGET_MAGIC )
@@ -130,7 +174,13 @@ YWidget::YWidget( YWidget * parent )
 void * YWidget::operator new( size_t size )
 {
     _usedOperatorNew = true;
-    return ::operator new( size );
+    return YArena::allocate( size );
+}
+
+
+void YWidget::operator delete( void * ptr, size_t size )
+{
+    YArena::deallocate( ptr, size );
 }
 
 
@@ -144,7 +194,23 @@ YWidget::~YWidget()
     YUI::ui()->deleteNotify( this );
 
     if ( parent() && ! parent()->beingDestroyed() )
+    {
+	// This also removes this widget from the widget ID index
 	parent()->removeChild( this );
+    }
+    else if ( priv->id )
+    {
+	// The parent is being destroyed, too, so it doesn't do that.
+	// The children are already deleted: Only remove this widget.
+
+	YDialog * dialog = widgetIdIndexDialog( this );
+
+	if ( dialog )
+	{
+	    dialog->removeFromWidgetIdIndex( this, false );
+	    dialog->widgetsChanged( 0 );
+	}
+    }
 
     delete priv->childrenManager;
 
@@ -184,6 +250,17 @@ YWidget::addChild( YWidget * child )
 #endif
 
     childrenManager()->add( child );
+
+    if ( child )
+    {
+	YDialog * dialog = widgetIdIndexDialog( this );
+
+	if ( dialog )
+	{
+	    dialog->addToWidgetIdIndex( child );
+	    dialog->widgetsChanged( this );
+	}
+    }
 }
 
 
@@ -194,6 +271,14 @@ YWidget::removeChild( YWidget * child )
     {
 	// yuiDebug() << "Removing " << child << " from " << this << endl;
 	childrenManager()->remove( child );
+
+	YDialog * dialog = widgetIdIndexDialog( this );
+
+	if ( dialog && child )
+	{
+	    dialog->removeFromWidgetIdIndex( child );
+	    dialog->widgetsChanged( this );
+	}
     }
 }
 
@@ -360,10 +445,44 @@ YWidget::id() const
 
 void YWidget::setId( YWidgetID * newId )
 {
+    // A dialog's own ID is not part of its widget ID index
+
+    YDialog * dialog = widgetIdIndexDialog( this );
+
+    if ( dialog == this )
+	dialog = 0;
+
+    if ( dialog )
+	dialog->removeFromWidgetIdIndex( this );
+
     if ( priv->id )
 	delete priv->id;
 
     priv->id = newId;
+
+    if ( dialog )
+    {
+	dialog->addToWidgetIdIndex( this ); // This also adds the children again
+	dialog->widgetsChanged( this );
+    }
+}
+
+
+void YWidget::labelChanged()
+{
+    YDialog * dialog = widgetIdIndexDialog( this );
+
+    if ( dialog )
+	dialog->widgetsChanged( this );
+}
+
+
+void YWidget::propertyChanged()
+{
+    YDialog * dialog = widgetIdIndexDialog( this );
+
+    if ( dialog )
+	dialog->propertyChanged( this );
 }
 
 
@@ -431,52 +550,96 @@ YWidget::propertySet()
 bool
 YWidget::setProperty( const string & propertyName, const YPropertyValue & val )
 {
-    try
-    {
-	propertySet().check( propertyName, val.type() ); // throws exceptions if not found or type mismatch
-    }
-    catch( YUIPropertyException & exception )
+    YPropertyId propertyId = YProperty::propertyId( propertyName );
+    const YProperty * prop = propertySet().find( propertyId );
+
+    if ( ! prop || prop->isReadOnly() ||
+	 ( prop->type() != val.type() && prop->type() != YOtherProperty ) )
     {
-	exception.setWidget( this );
-	throw;
+	// Not interned, not found or not writable with this type: the full
+	// check by name finds names that are not interned or throws the
+	// matching exception
+	try
+	{
+	    propertySet().check( propertyName, val.type() );
+	}
+	catch( YUIPropertyException & exception )
+	{
+	    exception.setWidget( this );
+	    throw;
+	}
     }
 
-    if      ( propertyName == YUIProperty_Enabled  )	setEnabled( val.boolVal() );
-    else if ( propertyName == YUIProperty_Notify   )	setNotify ( val.boolVal() );
-    else if ( propertyName == YUIProperty_HelpText )	setHelpText( val.stringVal() );
-    else if ( propertyName == YUIProperty_HWeight  )	setWeight( YD_HORIZ, val.integerVal() );
-    else if ( propertyName == YUIProperty_VWeight  )	setWeight( YD_VERT , val.integerVal() );
-    else if ( propertyName == YUIProperty_HStretch )	setStretchable( YD_HORIZ, val.boolVal() );
-    else if ( propertyName == YUIProperty_VStretch )	setStretchable( YD_VERT , val.boolVal() );
+    propertyChanged();
 
-    return true; // success -- no special processing necessary
+    return setProperty( propertyId, val );
 }
 
 
 YPropertyValue
 YWidget::getProperty( const string & propertyName )
 {
-    try
+    YPropertyId propertyId = YProperty::propertyId( propertyName );
+
+    if ( ! propertySet().contains( propertyId ) )
     {
-	propertySet().check( propertyName ); // throws exceptions if not found
+	try
+	{
+	    propertySet().check( propertyName ); // throws exceptions if not found
+	}
+	catch( YUIPropertyException & exception )
+	{
+	    exception.setWidget( this );
+	    throw;
+	}
     }
-    catch( YUIPropertyException & exception )
+
+    return getProperty( propertyId );
+}
+
+
+bool
+YWidget::setProperty( YPropertyId propertyId, const YPropertyValue & val )
+{
+    switch ( propertyId )
     {
-	exception.setWidget( this );
-	throw;
+	case YUIPropertyId_Enabled:	setEnabled( val.boolVal() );	break;
+	case YUIPropertyId_Notify:	setNotify ( val.boolVal() );	break;
+	case YUIPropertyId_HelpText:	setHelpText( val.stringVal() );	break;
+	case YUIPropertyId_HWeight:	setWeight( YD_HORIZ, val.integerVal() );	break;
+	case YUIPropertyId_VWeight:	setWeight( YD_VERT , val.integerVal() );	break;
+	case YUIPropertyId_HStretch:	setStretchable( YD_HORIZ, val.boolVal() );	break;
+	case YUIPropertyId_VStretch:	setStretchable( YD_VERT , val.boolVal() );	break;
+	default:			break;
     }
 
-    if ( propertyName == YUIProperty_Enabled 		) return YPropertyValue( isEnabled() 	);
-    if ( propertyName == YUIProperty_Notify  		) return YPropertyValue( notify()   	);
-    if ( propertyName == YUIProperty_ContextMenu	) return YPropertyValue( notifyContextMenu() );
-    if ( propertyName == YUIProperty_WidgetClass	) return YPropertyValue( widgetClass() 	);
-    if ( propertyName == YUIProperty_HelpText		) return YPropertyValue( helpText() 	);
-    if ( propertyName == YUIProperty_DebugLabel		) return YPropertyValue( debugLabel()	);
-    if ( propertyName == YUIProperty_HWeight		) return YPropertyValue( weight( YD_HORIZ ) );
-    if ( propertyName == YUIProperty_VWeight		) return YPropertyValue( weight( YD_VERT  ) );
-    if ( propertyName == YUIProperty_HStretch		) return YPropertyValue( stretchable( YD_HORIZ ) );
-    if ( propertyName == YUIProperty_VStretch		) return YPropertyValue( stretchable( YD_VERT  ) );
-    if ( propertyName == YUIProperty_ID	&& this->hasId() ) return YPropertyValue(this->id()->toString());
+    return true; // success -- no special processing necessary
+}
+
+
+YPropertyValue
+YWidget::getProperty( YPropertyId propertyId )
+{
+    switch ( propertyId )
+    {
+	case YUIPropertyId_Enabled:	return YPropertyValue( isEnabled() 	);
+	case YUIPropertyId_Notify:	return YPropertyValue( notify()   	);
+	case YUIPropertyId_ContextMenu:	return YPropertyValue( notifyContextMenu() );
+	case YUIPropertyId_WidgetClass:	return YPropertyValue( widgetClass() 	);
+	case YUIPropertyId_HelpText:	return YPropertyValue( helpText() 	);
+	case YUIPropertyId_DebugLabel:	return YPropertyValue( debugLabel()	);
+	case YUIPropertyId_HWeight:	return YPropertyValue( weight( YD_HORIZ ) );
+	case YUIPropertyId_VWeight:	return YPropertyValue( weight( YD_VERT  ) );
+	case YUIPropertyId_HStretch:	return YPropertyValue( stretchable( YD_HORIZ ) );
+	case YUIPropertyId_VStretch:	return YPropertyValue( stretchable( YD_VERT  ) );
+
+	case YUIPropertyId_ID:
+	    if ( this->hasId() )
+		return YPropertyValue( this->id()->toString() );
+	    break;
+
+	default:			break;
+    }
 
     return YPropertyValue( false ); // NOTREACHED
 }
@@ -557,6 +720,37 @@ int YWidget::preferredSize( YUIDimension dim )
 }
 
 
+int YWidget::cachedPreferredSize( YUIDimension dim )
+{
+    if ( layoutPassDepth == 0 )
+	return preferredSize( dim );
+
+    if ( priv->preferredSizePass[ dim ] != layoutPass )
+    {
+	priv->preferredSize[ dim ]     = preferredSize( dim );
+	priv->preferredSizePass[ dim ] = layoutPass;
+    }
+
+    return priv->preferredSize[ dim ];
+}
+
+
+void YWidget::startLayoutPass()
+{
+    if ( ++layoutPass == 0 )	// wrapped around: 0 marks "never computed"
+	layoutPass = 1;
+
+    layoutPassDepth++;
+}
+
+
+void YWidget::endLayoutPass()
+{
+    if ( layoutPassDepth > 0 )
+	layoutPassDepth--;
+}
+
+
 void YWidget::setStretchable( YUIDimension dim, bool newStretch )
 {
     priv->stretch[ dim ] = newStretch;
@@ -614,6 +808,36 @@ YWidget::findWidget( YWidgetID * id, bool doThrow ) const
 	return 0;
     }
 
+    // Use the widget ID index of the dialog if possible. Only if there is
+    // more than one widget with that ID, the widget tree needs to be
+    // searched to find the first one.
+
+    YDialog * dialog = widgetIdIndexDialog( const_cast<YWidget *>( this ) );
+
+    if ( dialog )
+    {
+	bool ambiguous = false;
+	YWidget * found = dialog->lookupWidgetId( id, this, ambiguous );
+
+	if ( found )
+	    return found;
+
+	if ( ! ambiguous )
+	{
+	    if ( doThrow )
+		YUI_THROW( YUIWidgetNotFoundException( id->toString() ) );
+
+	    return 0;
+	}
+    }
+
+    return findWidgetInTree( id, doThrow );
+}
+
+
+YWidget *
+YWidget::findWidgetInTree( YWidgetID * id, bool doThrow ) const
+{
     for ( YWidgetListConstIterator it = childrenBegin();
 	  it != childrenEnd();
 	  ++it )
@@ -626,7 +850,7 @@ YWidget::findWidget( YWidgetID * id, bool doThrow ) const
 
 	if ( child->hasChildren() )
 	{
-	    YWidget * found = child->findWidget( id, false );
+	    YWidget * found = child->findWidgetInTree( id, false );
 
 	    if ( found )
 		return found;
@@ -138,7 +138,13 @@ public:
     virtual const YPropertySet & propertySet();
 
     /**
-     * Set a property. Derived classes need to implement this.
+     * Set a property.
+     *
+     * This checks the property name and the type of 'val' against
+     * propertySet(), resolves the name to its interned ID once and calls
+     * setProperty( YPropertyId, ... ). Derived classes reimplement that one,
+     * unless they have properties that are not one of the YUIProperty_*
+     * names (YUIPropertyId_Unknown).
      *
      * This method may throw exceptions, for example
      *	 - if there is no property with that name
@@ -153,13 +159,33 @@ public:
 			      const YPropertyValue & val );
 
     /**
-     * Get a property. Derived classes need to implement this.
+     * Get a property. Like setProperty(), this checks the name and calls
+     * getProperty( YPropertyId ).
      *
      * This method may throw exceptions, for example
      *	 - if there is no property with that name
      **/
     virtual YPropertyValue getProperty( const std::string & propertyName );
 
+    /**
+     * Set a property by its interned ID. The property and the type of 'val'
+     * must already be checked against propertySet(), like
+     * setProperty( const std::string &, ... ) does.
+     *
+     * Derived classes with their own properties reimplement this with a
+     * switch over the IDs and call their base class for all others. Since
+     * this hides the setProperty() overload with the property name, they
+     * add "using YWidget::setProperty;".
+     **/
+    virtual bool setProperty( YPropertyId propertyId, const YPropertyValue & val );
+
+    /**
+     * Get a property by its interned ID. The property must already be
+     * checked against propertySet().
+     * See also setProperty( YPropertyId, ... ).
+     **/
+    virtual YPropertyValue getProperty( YPropertyId propertyId );
+
 
     //
     // Children Management
@@ -301,6 +327,9 @@ public:
      * If there is no widget with that ID, this function throws a
      * YUIWidgetNotFoundException if 'doThrow' is 'true'. It returns 0 if
      * 'doThrow' is 'false'.
+     *
+     * For widgets in a dialog, this uses the dialog's widget ID index, so
+     * it does not need to search the widget tree.
      **/
     YWidget * findWidget( YWidgetID * id, bool doThrow = true ) const;
 
@@ -335,6 +364,22 @@ public:
      **/
     virtual int preferredSize( YUIDimension dim );
 
+    /**
+     * Preferred size of the widget in the specified dimension, memoized for
+     * the duration of the current layout pass.
+     *
+     * Layout managers should use this rather than preferredSize() to query
+     * their children: Nested layout boxes ask each child for its preferred
+     * size several times, which without memoization makes the cost of a
+     * layout pass grow with the nesting depth of the dialog.
+     *
+     * Outside of a layout pass (see YDialog::doLayout()) this simply calls
+     * preferredSize(). The memoized sizes are only valid for one layout
+     * pass; each new pass computes them again, so nothing needs to be
+     * invalidated when a widget changes between passes.
+     **/
+    int cachedPreferredSize( YUIDimension dim );
+
     /**
      * Set the new size of the widget.
      *
@@ -624,9 +669,17 @@ public:
      *
      * Simpler implementations of this have a tendency to be fooled by poorly
      * implemented derived classes.
+     *
+     * The memory comes from the current arena, i.e. usually from the arena
+     * of the dialog the widget is created for (see YArena).
      **/
     void * operator new( size_t size );
 
+    /**
+     * Free the memory of a widget (see operator new() ).
+     **/
+    void operator delete( void * ptr, size_t size );
+
 
     // NCurses optimizations
 
@@ -673,12 +726,38 @@ protected:
      **/
      void setBeingDestroyed();
 
+    /**
+     * Notify the dialog that the label of this widget changed (see
+     * YDialog::widgetsRevision()). Widgets with a "Label" property call this
+     * whenever the label changes.
+     **/
+    void labelChanged();
+
+    /**
+     * Notify the dialog that a property of this widget is changed via
+     * setProperty() (see YDialogObserver::dialogChanged()). Every
+     * setProperty() implementation calls this after checking the property.
+     **/
+    void propertyChanged();
+
     /**
      * Helper function for dumpWidgetTree():
      * Dump one widget to the log file.
      **/
     void dumpWidget( YWidget *w, int indentationLevel );
 
+    /**
+     * Start a new layout pass: From now on, cachedPreferredSize() memoizes
+     * preferred sizes until the matching endLayoutPass(). Preferred sizes
+     * memoized in any previous layout pass are discarded.
+     **/
+    static void startLayoutPass();
+
+    /**
+     * End the layout pass started with startLayoutPass().
+     **/
+    static void endLayoutPass();
+
 
 private:
 
@@ -687,6 +766,13 @@ private:
      **/
     void invalidate();
 
+    /**
+     * Recursively find a widget by its ID by searching the widget tree.
+     * This is the fallback for findWidget() if the dialog's widget ID index
+     * cannot be used.
+     **/
+    YWidget * findWidgetInTree( YWidgetID * id, bool doThrow ) const;
+
     /**
      * Disable copy constructor.
      **/
@@ -25,10 +25,25 @@
 
 #include <iostream>
 #include "YWidgetID.h"
+#include "YArena.h"
 
 using std::string;
 
 
+void *
+YWidgetID::operator new( size_t size )
+{
+    return YArena::allocate( size );
+}
+
+
+void
+YWidgetID::operator delete( void * ptr, size_t size )
+{
+    YArena::deallocate( ptr, size );
+}
+
+
 YStringWidgetID::YStringWidgetID( const string & val )
     : _value( val )
 {
@@ -47,6 +47,16 @@ public:
      **/
     virtual ~YWidgetID() {}
 
+    /**
+     * Allocate IDs from the current arena (see YArena).
+     **/
+    static void * operator new( size_t size );
+
+    /**
+     * Free the memory of an ID (see operator new() ).
+     **/
+    static void operator delete( void * ptr, size_t size );
+
     /**
      * Check if this ID is equal to another.
      **/
@@ -55,6 +65,9 @@ public:
     /**
      * Convert the ID value to string.
      * Used for logging and debugging.
+     *
+     * IDs that are equal according to isEqual() are required to return
+     * the same string: YDialog uses it as the key of its widget ID index.
      **/
     virtual std::string toString() const = 0;
 
@@ -130,13 +130,12 @@ YWizard::propertySet()
 
 
 YPropertyValue
-YWizard::getProperty( const string & propertyName )
+YWizard::getProperty( YPropertyId propertyId )
 {
-    propertySet().check( propertyName ); // throws exceptions if not found
-
-    if ( propertyName == YUIProperty_CurrentItem )	return YPropertyValue( YOtherProperty );
-    else
+    switch ( propertyId )
     {
-	return YWidget::getProperty( propertyName );
+	case YUIPropertyId_CurrentItem:	return YPropertyValue( YOtherProperty );
+	default:
+	    return YWidget::getProperty( propertyId );
     }
 }
@@ -0,0 +1,125 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YArena pool allocator
+
+#define BOOST_TEST_MODULE YArena_tests
+#include <boost/test/unit_test.hpp>
+
+#include "YArena.h"
+#include "YItem.h"
+#include "YTableItem.h"
+#include "YWidgetID.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+BOOST_AUTO_TEST_CASE( no_current_arena )
+{
+    BOOST_CHECK_EQUAL( YArena::current(), (YArena *) 0 );
+
+    YItem * item = new YItem( "heap" );
+    BOOST_CHECK_EQUAL( item->label(), "heap" );
+    delete item;
+}
+
+BOOST_AUTO_TEST_CASE( reuse_blocks )
+{
+    YArena * arena = new YArena();
+    YArena::setCurrent( arena );
+
+    YItem * item = new YItem( "first" );
+    YWidgetID * id = new YStringWidgetID( "id" );
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 2 );
+    BOOST_CHECK_EQUAL( arena->chunkCount(), 1 );
+
+    delete item;
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 1 );
+
+    // the memory of the deleted item is reused for one of the same size
+    YItem * other = new YItem( "second" );
+    BOOST_CHECK_EQUAL( (void *) other, (void *) item );
+
+    // too large for the arena: from the heap
+    void * large = YArena::allocate( 100000 );
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 2 );
+    YArena::deallocate( large, 100000 );
+
+    delete other;
+    delete id;
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 0 );
+
+    arena->release();
+    BOOST_CHECK_EQUAL( YArena::current(), (YArena *) 0 );
+}
+
+BOOST_AUTO_TEST_CASE( outlive_arena )
+{
+    YArena * arena = new YArena();
+    YArena::setCurrent( arena );
+
+    YTableItem * item = new YTableItem( "one", "two" );
+    item->addCell( new YTableCell( "three" ) );
+
+    std::vector<YItem *> items;
+
+    for ( int i = 0; i < 10000; i++ )
+        items.push_back( new YItem( std::to_string( i ) ) );
+
+    BOOST_CHECK( arena->chunkCount() > 1 );
+
+    // the arena is deleted only with the last block
+    arena->release();
+
+    BOOST_CHECK_EQUAL( item->label( 2 ), "three" );
+    BOOST_CHECK_EQUAL( items.back()->label(), "9999" );
+
+    for ( YItem * item : items )
+        delete item;
+
+    delete item;
+}
+
+BOOST_AUTO_TEST_CASE( heap_and_arena_blocks )
+{
+    // from the heap before there is any arena, freed while there is one
+    YItem * heapItem = new YItem( "heap" );
+
+    YArena * arena = new YArena();
+    YArena::setCurrent( arena );
+
+    YItem * arenaItem = new YItem( "arena" );
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 1 );
+
+    delete heapItem;
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 1 );
+
+    // freed after the arena is not the current one any more
+    YArena::setCurrent( 0 );
+    delete arenaItem;
+    BOOST_CHECK_EQUAL( arena->usedBlocks(), 0 );
+
+    arena->release();
+}
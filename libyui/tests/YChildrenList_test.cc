@@ -0,0 +1,125 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YChildrenList container
+
+#define BOOST_TEST_MODULE YChildrenList_tests
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include "YChildrenList.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+typedef YChildrenList<int> IntList;
+
+static std::vector<int *> contents( const IntList & list )
+{
+    return std::vector<int *>( list.begin(), list.end() );
+}
+
+BOOST_AUTO_TEST_CASE( add_and_iterate )
+{
+    int values[ 20 ];
+    IntList list;
+
+    BOOST_CHECK( list.empty() );
+
+    for ( int i = 0; i < 20; i++ )
+        list.push_back( &values[ i ] );
+
+    BOOST_REQUIRE_EQUAL( list.size(), 20 );
+    BOOST_CHECK_EQUAL( list.front(), &values[ 0 ] );
+    BOOST_CHECK_EQUAL( list.back(), &values[ 19 ] );
+    BOOST_CHECK_EQUAL( list[ 7 ], &values[ 7 ] );
+    BOOST_CHECK_EQUAL( *list.rbegin(), &values[ 19 ] );
+    BOOST_CHECK_EQUAL( list.rend() - list.rbegin(), 20 );
+
+    IntList copy( list );
+    BOOST_CHECK( contents( copy ) == contents( list ) );
+
+    list.clear();
+    BOOST_CHECK( list.empty() );
+    BOOST_CHECK_EQUAL( copy.size(), 20 );
+}
+
+BOOST_AUTO_TEST_CASE( remove_children )
+{
+    int values[ 6 ];
+    IntList list;
+
+    for ( int i = 0; i < 6; i++ )
+        list.push_back( &values[ i ] );
+
+    list.remove( &values[ 3 ] );
+    list.remove( &values[ 0 ] );
+    list.remove( &values[ 5 ] );
+    list.remove( &values[ 5 ] ); // not there any more
+
+    std::vector<int *> expected = { &values[ 1 ], &values[ 2 ], &values[ 4 ] };
+    BOOST_CHECK( contents( list ) == expected );
+
+    // the storage in front of the children is used again
+    for ( int i = 0; i < 6; i++ )
+        list.push_back( &values[ i ] );
+
+    BOOST_CHECK_EQUAL( list.size(), 9 );
+    BOOST_CHECK_EQUAL( list.front(), &values[ 1 ] );
+    BOOST_CHECK_EQUAL( list.back(), &values[ 5 ] );
+}
+
+BOOST_AUTO_TEST_CASE( remove_while_iterating )
+{
+    int values[ 10 ];
+    IntList list;
+
+    for ( int i = 0; i < 10; i++ )
+        list.push_back( &values[ i ] );
+
+    // like YWidget::deleteChildren(): every child removes itself
+    int count = 0;
+    IntList::const_iterator it = list.begin();
+
+    while ( it != list.end() )
+    {
+        int * child = *it;
+        ++it;
+
+        list.remove( child );
+        count++;
+    }
+
+    BOOST_CHECK_EQUAL( count, 10 );
+    BOOST_CHECK( list.empty() );
+
+    // iterators to the children after a removed one stay valid
+    for ( int i = 0; i < 10; i++ )
+        list.push_back( &values[ i ] );
+
+    IntList::iterator eighth = list.begin() + 7;
+    list.remove( &values[ 4 ] );
+    BOOST_CHECK_EQUAL( *eighth, &values[ 7 ] );
+}
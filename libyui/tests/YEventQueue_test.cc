@@ -0,0 +1,261 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YEventQueue class
+
+#define BOOST_TEST_MODULE YEventQueue_tests
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "YEvent.h"
+#include "YEventQueue.h"
+#include "YWidget.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+// A widget to send events for.
+//
+// Notice that the test widgets are never deleted: The YWidget destructor
+// needs a loaded UI (YUI::ui()->deleteNotify()).
+class TestWidget : public YWidget
+{
+public:
+    TestWidget() : YWidget( 0 ) {}
+
+    virtual const char * widgetClass() const { return "TestWidget"; }
+    virtual int  preferredWidth()  { return 1; }
+    virtual int  preferredHeight() { return 1; }
+    virtual void setSize( int, int ) {}
+};
+
+static YWidgetEvent *
+widgetEvent( YEvent * event )
+{
+    return dynamic_cast<YWidgetEvent *>( event );
+}
+
+BOOST_AUTO_TEST_CASE( fifo )
+{
+    TestWidget * widget = new TestWidget();
+    YEventQueue queue;
+
+    queue.sendEvent( new YWidgetEvent( widget, YEvent::Activated ) );
+    queue.sendEvent( new YMenuEvent( "menu" ) );
+    queue.sendEvent( new YCancelEvent() );
+
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 3 );
+    BOOST_CHECK( queue.eventPendingFor( widget ) );
+    BOOST_CHECK_EQUAL( queue.pendingEvent()->eventType(), YEvent::WidgetEvent );
+
+    YEvent * event = queue.consumePendingEvent();
+    BOOST_CHECK_EQUAL( event->eventType(), YEvent::WidgetEvent );
+    queue.deleteEvent( event );
+    BOOST_CHECK( ! queue.eventPendingFor( widget ) );
+
+    std::vector<YEvent *> events;
+    BOOST_CHECK_EQUAL( queue.consumePendingEvents( events ), 2 );
+    BOOST_CHECK_EQUAL( events[0]->eventType(), YEvent::MenuEvent );
+    BOOST_CHECK_EQUAL( events[1]->eventType(), YEvent::CancelEvent );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 0 );
+    BOOST_CHECK( ! queue.consumePendingEvent() );
+
+    for ( YEvent * event : events )
+        queue.deleteEvent( event );
+}
+
+BOOST_AUTO_TEST_CASE( merging )
+{
+    TestWidget * widget1 = new TestWidget();
+    TestWidget * widget2 = new TestWidget();
+    YEventQueue queue;
+
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::ValueChanged ) );
+    queue.sendEvent( new YTimeoutEvent() );
+    queue.sendEvent( new YWidgetEvent( widget2, YEvent::ValueChanged ) );
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::ValueChanged ) );	// merged
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::Activated ) );
+    queue.sendEvent( new YTimeoutEvent() );					// merged
+
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 4 );
+    BOOST_CHECK_EQUAL( queue.mergedEventsCount(), 2 );
+
+    std::vector<YEvent *> events;
+    queue.consumePendingEvents( events );
+    BOOST_CHECK_EQUAL( widgetEvent( events[0] )->widget(), widget1 );
+    BOOST_CHECK_EQUAL( events[1]->eventType(), YEvent::TimeoutEvent );
+    BOOST_CHECK_EQUAL( widgetEvent( events[2] )->widget(), widget2 );
+    BOOST_CHECK_EQUAL( widgetEvent( events[3] )->reason(), YEvent::Activated );
+
+    for ( YEvent * event : events )
+        queue.deleteEvent( event );
+
+    // Consumed events are no longer merge candidates
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::ValueChanged ) );
+    queue.sendEvent( new YTimeoutEvent() );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( pending_event_for_widget )
+{
+    TestWidget * widget1 = new TestWidget();
+    TestWidget * widget2 = new TestWidget();
+    YEventQueue queue;
+
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::Activated ) );
+    queue.sendEvent( new YWidgetEvent( widget2, YEvent::SelectionChanged ) );
+    queue.sendEvent( new YWidgetEvent( widget2, YEvent::Activated ) );
+
+    // pendingEvent() is the oldest one, which is for another widget
+    BOOST_CHECK_EQUAL( widgetEvent( queue.pendingEvent() )->widget(), widget1 );
+
+    YWidgetEvent * event = queue.pendingEventFor( widget2 );
+    BOOST_REQUIRE( event );
+    BOOST_CHECK_EQUAL( event->widget(), widget2 );
+    BOOST_CHECK_EQUAL( event->reason(), YEvent::Activated );
+
+    queue.deletePendingEventsFor( widget2 );
+    BOOST_CHECK( ! queue.pendingEventFor( widget2 ) );
+    BOOST_CHECK( queue.pendingEventFor( widget1 ) );
+
+    queue.clear();
+}
+
+BOOST_AUTO_TEST_CASE( bounded )
+{
+    YEventQueue queue( 3 );
+
+    for ( int i = 0; i < 5; i++ )
+        queue.sendEvent( new YMenuEvent( std::to_string( i ) ) );
+
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 3 );
+    BOOST_CHECK_EQUAL( queue.discardedEventsCount(), 2 );
+
+    YEvent * event = queue.consumePendingEvent();
+    BOOST_CHECK_EQUAL( dynamic_cast<YMenuEvent *>( event )->id(), "2" );
+    queue.deleteEvent( event );
+}
+
+BOOST_AUTO_TEST_CASE( delete_pending_events )
+{
+    TestWidget * widget1 = new TestWidget();
+    TestWidget * widget2 = new TestWidget();
+    YEventQueue queue;
+
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::ValueChanged ) );
+    queue.sendEvent( new YWidgetEvent( widget2, YEvent::Activated ) );
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::Activated ) );
+
+    queue.deletePendingEventsFor( widget1 );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 1 );
+    BOOST_CHECK_EQUAL( widgetEvent( queue.pendingEvent() )->widget(), widget2 );
+
+    // not merged with the deleted one
+    queue.sendEvent( new YWidgetEvent( widget1, YEvent::ValueChanged ) );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 2 );
+
+    queue.blockEvents();
+    queue.sendEvent( new YCancelEvent() );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 2 );
+    queue.unblockEvents();
+
+    queue.clear();
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 0 );
+}
+
+// Send events in bursts like a busy UI and consume them in batches
+BOOST_AUTO_TEST_CASE( bursts )
+{
+    const int eventCount   = 10000;
+    const int burstSize    = 100;
+    const int widgetCount  = 16;
+
+    std::vector<TestWidget *> widgets;
+
+    for ( int i = 0; i < widgetCount; i++ )
+        widgets.push_back( new TestWidget() );
+
+    YEventQueue		queue;
+    std::vector<YEvent *> events;
+    long		consumed = 0;
+
+    for ( int i = 0; i < eventCount; )
+    {
+        for ( int j = 0; j < burstSize; j++, i++ )
+        {
+            switch ( i % 4 )
+            {
+                case 0: queue.sendEvent( new YWidgetEvent( widgets[ i % widgetCount ], YEvent::ValueChanged ) ); break;
+                case 1: queue.sendEvent( new YWidgetEvent( widgets[ i % widgetCount ], YEvent::Activated    ) ); break;
+                case 2: queue.sendEvent( new YTimeoutEvent() );	break;
+                case 3: queue.sendEvent( new YMenuEvent( "menu" ) );	break;
+            }
+        }
+
+        events.clear();
+        consumed += queue.consumePendingEvents( events );
+
+        for ( YEvent * event : events )
+            queue.deleteEvent( event );
+    }
+
+    // Nothing is lost: Every event was either consumed or merged
+    BOOST_CHECK_EQUAL( queue.discardedEventsCount(), 0 );
+    BOOST_CHECK_EQUAL( consumed + (long) queue.mergedEventsCount(), eventCount );
+    BOOST_CHECK( queue.mergedEventsCount() > 0 );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( other_threads )
+{
+    TestWidget * widget = new TestWidget();
+    YEventQueue queue;
+    std::vector<YEvent *> events;
+
+    // Events sent by one thread and deleted by another one that then exits
+    // (and releases the event memory it recycled)
+    for ( int round = 0; round < 10; round++ )
+    {
+        for ( int i = 0; i < 200; i++ )
+            queue.sendEvent( new YWidgetEvent( widget, YEvent::Activated ) );
+
+        events.clear();
+        queue.consumePendingEvents( events );
+        BOOST_CHECK_EQUAL( events.size(), 200 );
+
+        std::thread consumer( [&]()
+        {
+            for ( YEvent * event : events )
+                queue.deleteEvent( event );
+        } );
+
+        consumer.join();
+    }
+
+    queue.sendEvent( new YWidgetEvent( widget, YEvent::ValueChanged ) );
+    BOOST_CHECK_EQUAL( queue.pendingEventsCount(), 1 );
+}
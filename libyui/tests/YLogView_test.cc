@@ -0,0 +1,184 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YLogView class
+
+#define BOOST_TEST_MODULE YLogView_tests
+#include <boost/test/unit_test.hpp>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "YLogView.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+// A log view that keeps the displayed lines like a toolkit would.
+//
+// Notice that the test log views are never deleted: The YWidget destructor
+// needs a loaded UI (YUI::ui()->deleteNotify()).
+class TestLogView : public YLogView
+{
+public:
+    TestLogView( int maxLines )
+        : YLogView( 0, "", 10, maxLines )
+        , fullUpdates( 0 )
+        {}
+
+    virtual int  preferredWidth()  { return 10; }
+    virtual int  preferredHeight() { return 10; }
+    virtual void setSize( int, int ) {}
+
+    // The displayed lines joined in the same way as logText()
+    std::string displayedText() const
+    {
+        std::string text;
+
+        for ( const std::string & line : displayed )
+            text += line;
+
+        if ( ! text.empty() && *text.rbegin() == '\n' )
+            text.resize( text.size() - 1 );
+
+        return text;
+    }
+
+    std::deque<std::string> displayed;
+    int fullUpdates;
+
+protected:
+
+    virtual void displayLogText( const std::string & text )
+    {
+        fullUpdates++;
+        displayed.clear();
+
+        std::string::size_type from = 0;
+
+        while ( from < text.size() )
+        {
+            std::string::size_type to = text.find( '\n', from );
+            to = ( to == std::string::npos ) ? text.size() : to + 1;
+            displayed.push_back( text.substr( from, to - from ) );
+            from = to;
+        }
+    }
+
+    virtual void displayAppendedLines( const std::vector<std::string> & newLines,
+                                       bool lastLineReplaced,
+                                       int  droppedLines )
+    {
+        if ( lastLineReplaced )
+            displayed.pop_back();
+
+        displayed.insert( displayed.end(), newLines.begin(), newLines.end() );
+
+        for ( int i = 0; i < droppedLines; i++ )
+            displayed.pop_front();
+    }
+};
+
+BOOST_AUTO_TEST_CASE( append_lines )
+{
+    TestLogView * logView = new TestLogView( 0 );
+
+    logView->appendLines( "one\ntwo\n" );
+    logView->appendLines( "thr" );
+    logView->appendLines( "ee\nfour" );
+
+    BOOST_CHECK_EQUAL( logView->logText(), "one\ntwo\nthree\nfour" );
+    BOOST_CHECK_EQUAL( logView->displayedText(), logView->logText() );
+    BOOST_CHECK_EQUAL( logView->lines(), 4 );
+    BOOST_CHECK_EQUAL( logView->lastLine(), "four" );
+    BOOST_CHECK_EQUAL( logView->fullUpdates, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( max_lines )
+{
+    TestLogView * logView = new TestLogView( 3 );
+
+    for ( int i = 0; i < 10; i++ )
+    {
+        logView->appendLines( "line " + std::to_string( i ) );
+        logView->appendLines( i % 3 ? "\n" : "\na\nb\n" );
+        BOOST_CHECK_EQUAL( logView->displayedText(), logView->logText() );
+    }
+
+    BOOST_CHECK_EQUAL( logView->logText(), "line 9\na\nb" );
+    BOOST_CHECK_EQUAL( logView->lines(), 3 );
+
+    logView->setMaxLines( 2 );
+    BOOST_CHECK_EQUAL( logView->logText(), "a\nb" );
+    BOOST_CHECK_EQUAL( logView->displayedText(), logView->logText() );
+
+    logView->setMaxLines( 0 );
+    logView->appendLines( "c\nd\n" );
+    BOOST_CHECK_EQUAL( logView->logText(), "a\nb\nc\nd" );
+}
+
+BOOST_AUTO_TEST_CASE( set_log_text )
+{
+    TestLogView * logView = new TestLogView( 0 );
+
+    logView->setLogText( "one\ntwo\n" );
+    BOOST_CHECK_EQUAL( logView->fullUpdates, 0 );
+
+    // unchanged text (logText() cuts off the last newline)
+    logView->setLogText( "one\ntwo" );
+    logView->setLogText( "one\ntwo\n" );
+    BOOST_CHECK_EQUAL( logView->lines(), 2 );
+
+    // appended text
+    logView->setLogText( "one\ntwo\nthree" );
+    BOOST_CHECK_EQUAL( logView->fullUpdates, 0 );
+    BOOST_CHECK_EQUAL( logView->displayedText(), "one\ntwo\nthree" );
+
+    // different text
+    logView->setLogText( "four\n" );
+    BOOST_CHECK_EQUAL( logView->fullUpdates, 1 );
+    BOOST_CHECK_EQUAL( logView->displayedText(), "four" );
+    BOOST_CHECK_EQUAL( logView->lines(), 1 );
+
+    logView->clearText();
+    BOOST_CHECK_EQUAL( logView->displayedText(), "" );
+    BOOST_CHECK_EQUAL( logView->lines(), 0 );
+}
+
+// Many appended lines are all displayed incrementally
+BOOST_AUTO_TEST_CASE( append_many_lines )
+{
+    const int count = 10000;
+    TestLogView * logView = new TestLogView( 0 );
+
+    for ( int i = 0; i < count; i++ )
+        logView->appendLines( "log line " + std::to_string( i ) + "\n" );
+
+    BOOST_CHECK_EQUAL( logView->lines(), count );
+    BOOST_CHECK_EQUAL( logView->displayed.size(), (size_t) count );
+    BOOST_CHECK_EQUAL( logView->displayed.back(), "log line 9999\n" );
+    BOOST_CHECK_EQUAL( logView->fullUpdates, 0 );
+}
@@ -0,0 +1,218 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YPath and YIconLoader classes
+
+#define BOOST_TEST_MODULE YPath_tests
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "YPath.h"
+#include "YIconLoader.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+const int sizes    = 8;
+const int contexts = 10;
+const int icons    = 50;
+
+// A synthetic icon theme: <size>/<context>/icon-<context>-<n>.png
+struct ThemeTree
+{
+    ThemeTree()
+    {
+        char tmpl[] = "/tmp/YPath_test_XXXXXX";
+        dir = mkdtemp( tmpl );
+
+        for ( int s = 0; s < sizes; s++ )
+        {
+            std::string sizeDir = dir + "/" + std::to_string( 16 + 8 * s ) + "x" + std::to_string( 16 + 8 * s );
+            mkdir( sizeDir.c_str(), 0755 );
+
+            for ( int c = 0; c < contexts; c++ )
+            {
+                std::string contextDir = sizeDir + "/context" + std::to_string( c );
+                mkdir( contextDir.c_str(), 0755 );
+
+                for ( int i = 0; i < icons; i++ )
+                    touch( contextDir + "/" + iconName( c, i ) );
+            }
+        }
+
+        mkdir( ( dir + "/22x22" ).c_str(), 0755 );
+        mkdir( ( dir + "/22x22/apps" ).c_str(), 0755 );
+        touch( dir + "/22x22/apps/app.png" );
+    }
+
+    ~ThemeTree()
+    {
+        nftw( dir.c_str(), removeFile, 16, FTW_DEPTH | FTW_PHYS );
+    }
+
+    static int removeFile( const char * path, const struct stat *, int, struct FTW * )
+    {
+        return remove( path );
+    }
+
+    static std::string iconName( int context, int n )
+    {
+        return "icon-" + std::to_string( context ) + "-" + std::to_string( n ) + ".png";
+    }
+
+    static void touch( const std::string & path )
+    {
+        std::ofstream file( path );
+    }
+
+    std::string dir;
+};
+
+// The uncached recursive lookup YPath did before
+static std::string
+lookRecursive( const std::string & directory, const std::string & filename )
+{
+    std::vector<std::string> fileList;
+    DIR * dir = opendir( directory.c_str() );
+
+    if ( dir )
+    {
+        while ( struct dirent * ent = readdir( dir ) )
+            fileList.push_back( ent->d_name );
+
+        closedir( dir );
+    }
+
+    for ( const std::string & name : fileList )
+    {
+        if ( name == "." || name == ".." )
+            continue;
+
+        std::string fullname = directory + "/" + name;
+
+        if ( name == filename )
+            return fullname;
+
+        std::string file = lookRecursive( fullname, filename );
+
+        if ( ! file.empty() )
+            return file;
+    }
+
+    return "";
+}
+
+BOOST_AUTO_TEST_CASE( find_recursive )
+{
+    ThemeTree tree;
+
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "app.png" ).path(), tree.dir + "/22x22/apps/app.png" );
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "app.png" ).dir(),  tree.dir + "/22x22/apps" );
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "apps" ).path(),    tree.dir + "/22x22/apps" );
+
+    // not found: the filename itself
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "nosuchfile.png" ).path(), "nosuchfile.png" );
+    BOOST_CHECK_EQUAL( YPath( tree.dir + "/nosuchdir", "app.png" ).path(), "app.png" );
+}
+
+BOOST_AUTO_TEST_CASE( clear_cache )
+{
+    ThemeTree tree;
+
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "new.png" ).path(), "new.png" );
+
+    ThemeTree::touch( tree.dir + "/22x22/apps/new.png" );
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "new.png" ).path(), "new.png" );	// cached
+
+    YPath::clearCache();
+    BOOST_CHECK_EQUAL( YPath( tree.dir, "new.png" ).path(), tree.dir + "/22x22/apps/new.png" );
+}
+
+BOOST_AUTO_TEST_CASE( icon_loader )
+{
+    ThemeTree tree;
+
+    YIconLoader loader;
+    loader.addIconSearchPath( tree.dir + "/" );
+
+    BOOST_CHECK_EQUAL( loader.findIcon( "app" ), tree.dir + "/22x22/apps/app.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "app" ), tree.dir + "/22x22/apps/app.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "32x32/context1/" + ThemeTree::iconName( 1, 7 ) ),
+                       tree.dir + "/32x32/context1/" + ThemeTree::iconName( 1, 7 ) );
+    BOOST_CHECK_EQUAL( loader.findIcon( "nosuchicon" ), "" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "/abs/path.png" ), "/abs/path.png" );
+
+    // a new search path invalidates the results
+    ThemeTree other;
+    ThemeTree::touch( other.dir + "/22x22/apps/other.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "other" ), "" );
+
+    YPath::clearCache();
+    loader.addIconSearchPath( other.dir + "/" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "other" ), other.dir + "/22x22/apps/other.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "app" ),   other.dir + "/22x22/apps/app.png" );
+}
+
+BOOST_AUTO_TEST_CASE( icon_symlinks )
+{
+    ThemeTree tree;
+
+    // only symbolic links to existing files count, like with stat()
+    BOOST_REQUIRE( symlink( "app.png", ( tree.dir + "/22x22/apps/link.png" ).c_str() ) == 0 );
+    BOOST_REQUIRE( symlink( "gone.png", ( tree.dir + "/22x22/apps/dangling.png" ).c_str() ) == 0 );
+
+    YPath::clearCache();
+    YIconLoader loader;
+    loader.addIconSearchPath( tree.dir + "/" );
+
+    BOOST_CHECK_EQUAL( loader.findIcon( "link" ), tree.dir + "/22x22/apps/link.png" );
+    BOOST_CHECK_EQUAL( loader.findIcon( "dangling" ), "" );
+}
+
+// Resolve a few hundred icons like an application starting up
+BOOST_AUTO_TEST_CASE( startup )
+{
+    const int lookups = 300;
+
+    ThemeTree tree;
+
+    for ( int run = 0; run < 2; run++ )
+    {
+        for ( int i = 0; i < lookups; i++ )
+        {
+            std::string name = ThemeTree::iconName( i % contexts, ( i * 7 ) % icons );
+            BOOST_CHECK_EQUAL( YPath( tree.dir, name ).path(), lookRecursive( tree.dir, name ) );
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YProperty and YPropertySet classes
+
+#define BOOST_TEST_MODULE YProperty_tests
+#include <boost/test/unit_test.hpp>
+
+#include "YProperty.h"
+#include "YUIException.h"
+#include "YUISymbols.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+BOOST_AUTO_TEST_CASE( property_ids )
+{
+    BOOST_CHECK_EQUAL( YProperty::propertyId( YUIProperty_Label ), YUIPropertyId_Label );
+    BOOST_CHECK_EQUAL( YProperty::propertyId( YUIProperty_HScrollValue ), YUIPropertyId_HScrollValue );
+    BOOST_CHECK_EQUAL( YProperty::propertyId( "NoSuchProperty" ), YUIPropertyId_Unknown );
+
+    // every ID maps back to its name
+    for ( int id = YUIPropertyId_Unknown + 1; id < YUIPropertyId_Count; id++ )
+    {
+        const std::string & name = YProperty::propertyName( (YPropertyId) id );
+        BOOST_CHECK_EQUAL( YProperty::propertyId( name ), id );
+    }
+
+    BOOST_CHECK_EQUAL( YProperty::propertyName( YUIPropertyId_Unknown ), "" );
+    BOOST_CHECK_EQUAL( YProperty( YUIProperty_Value, YStringProperty ).id(), YUIPropertyId_Value );
+}
+
+BOOST_AUTO_TEST_CASE( property_set_lookup )
+{
+    YPropertySet propSet;
+    propSet.add( YProperty( YUIProperty_Value,	 YStringProperty ) );
+    propSet.add( YProperty( YUIProperty_Label,	 YStringProperty, true ) ); // read-only
+    propSet.add( YProperty( "MyCustomProperty", YIntegerProperty ) );
+
+    BOOST_CHECK_EQUAL( propSet.size(), 3 );
+    BOOST_CHECK( propSet.contains( YUIProperty_Value ) );
+    BOOST_CHECK( propSet.contains( YUIPropertyId_Value ) );
+    BOOST_CHECK( propSet.contains( "MyCustomProperty" ) );
+    BOOST_CHECK( ! propSet.contains( YUIProperty_Items ) );
+    BOOST_CHECK( ! propSet.contains( YUIPropertyId_Items ) );
+    BOOST_CHECK( ! propSet.contains( "OtherCustomProperty" ) );
+
+    BOOST_CHECK( propSet.contains( YUIProperty_Value, YStringProperty ) );
+    BOOST_CHECK( propSet.contains( "MyCustomProperty", YIntegerProperty ) );
+
+    BOOST_CHECK_THROW( propSet.contains( YUIProperty_Value, YBoolProperty ), YUIPropertyTypeMismatchException );
+    BOOST_CHECK_THROW( propSet.contains( YUIProperty_Label, YStringProperty ), YUISetReadOnlyPropertyException );
+    BOOST_CHECK_THROW( propSet.check( YUIProperty_Items ), YUIUnknownPropertyException );
+}
+
+BOOST_AUTO_TEST_CASE( property_set_duplicates )
+{
+    YPropertySet baseSet;
+    baseSet.add( YProperty( YUIProperty_Value, YIntegerProperty ) );
+
+    // properties added first have priority over those of the base class
+    YPropertySet propSet;
+    propSet.add( YProperty( YUIProperty_Value, YStringProperty ) );
+    propSet.add( baseSet );
+
+    BOOST_CHECK_EQUAL( propSet.size(), 2 );
+    BOOST_CHECK_EQUAL( propSet.find( YUIPropertyId_Value )->type(), YStringProperty );
+    BOOST_CHECK_EQUAL( propSet.find( YUIProperty_Value )->type(), YStringProperty );
+}
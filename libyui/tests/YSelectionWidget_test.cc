@@ -0,0 +1,159 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the selection bookkeeping of YSelectionWidget
+
+#define BOOST_TEST_MODULE YSelectionWidget_tests
+#include <boost/test/unit_test.hpp>
+
+#include "YSelectionWidget.h"
+#include "YTreeItem.h"
+#include "YUIException.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+// A concrete selection widget.
+//
+// Notice that the test widgets are never deleted: The YWidget destructor
+// needs a loaded UI (YUI::ui()->deleteNotify()).
+class TestSelectionWidget : public YSelectionWidget
+{
+public:
+    TestSelectionWidget( bool singleSelection )
+        : YSelectionWidget( 0, "label", singleSelection )
+        {}
+
+    virtual const char * widgetClass() const { return "TestSelectionWidget"; }
+    virtual int  preferredWidth()  { return 1; }
+    virtual int  preferredHeight() { return 1; }
+    virtual void setSize( int, int ) {}
+};
+
+BOOST_AUTO_TEST_CASE( single_selection )
+{
+    TestSelectionWidget * widget = new TestSelectionWidget( true );
+
+    widget->addItem( "one" );
+    widget->addItem( "two", true );
+    widget->addItem( "three" );
+
+    BOOST_CHECK_EQUAL( widget->selectedItem(), widget->itemAt( 1 ) );
+    BOOST_CHECK( ! widget->itemAt( 0 )->selected() ); // initial selection replaced
+
+    widget->addItem( "four", true );
+    BOOST_CHECK_EQUAL( widget->selectedItem(), widget->itemAt( 3 ) );
+    BOOST_CHECK( ! widget->itemAt( 1 )->selected() );
+
+    widget->selectItem( widget->itemAt( 2 ) );
+    BOOST_CHECK_EQUAL( widget->selectedItems().size(), 1 );
+    BOOST_CHECK_EQUAL( widget->selectedItem(), widget->itemAt( 2 ) );
+
+    widget->deselectAllItems();
+    BOOST_CHECK( ! widget->hasSelectedItem() );
+    BOOST_CHECK( widget->selectedItems().empty() );
+}
+
+BOOST_AUTO_TEST_CASE( multi_selection )
+{
+    TestSelectionWidget * widget = new TestSelectionWidget( false );
+
+    for ( int i = 0; i < 5; i++ )
+        widget->addItem( std::to_string( i ), i % 2 == 1 );
+
+    // changed directly, not through the widget
+    widget->itemAt( 4 )->setSelected( true );
+    widget->itemAt( 1 )->setStatus( 2 );
+    widget->itemAt( 3 )->setStatus( 0 );
+
+    YItemCollection selected = widget->selectedItems();
+    BOOST_REQUIRE_EQUAL( selected.size(), 2 );
+    BOOST_CHECK_EQUAL( selected[0], widget->itemAt( 1 ) );
+    BOOST_CHECK_EQUAL( selected[1], widget->itemAt( 4 ) );
+    BOOST_CHECK_EQUAL( widget->selectedItem(), widget->itemAt( 1 ) );
+
+    widget->deselectAllItems();
+    BOOST_CHECK( widget->selectedItems().empty() );
+    BOOST_CHECK_EQUAL( widget->itemAt( 1 )->status(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( tree_items )
+{
+    TestSelectionWidget * widget = new TestSelectionWidget( true );
+
+    YTreeItem * parent = new YTreeItem( "parent" );
+    YTreeItem * child  = new YTreeItem( parent, "child" );
+    widget->addItem( parent );
+
+    BOOST_CHECK( widget->itemsContain( parent ) );
+    BOOST_CHECK( widget->itemsContain( child ) );
+    BOOST_CHECK_EQUAL( child->owner(), widget );
+
+    // added after the parent was added to the widget
+    YTreeItem * grandChild = new YTreeItem( child, "grandchild" );
+    BOOST_CHECK( widget->itemsContain( grandChild ) );
+
+    widget->selectItem( grandChild );
+    BOOST_CHECK_EQUAL( widget->selectedItem(), grandChild );
+    BOOST_CHECK( ! parent->selected() );
+
+    // deleting the selected item
+    child->deleteChildren();
+    BOOST_CHECK_EQUAL( widget->selectedItem(), (YItem *) 0 );
+    BOOST_CHECK_EQUAL( widget->findItem( "grandchild" ), (YItem *) 0 );
+
+    YTreeItem other( "other" );
+    BOOST_CHECK( ! widget->itemsContain( &other ) );
+    BOOST_CHECK_THROW( widget->selectItem( &other ), YUIException );
+}
+
+BOOST_AUTO_TEST_CASE( find_item )
+{
+    TestSelectionWidget * widget = new TestSelectionWidget( false );
+
+    YTreeItem * first = new YTreeItem( "first" );
+    YTreeItem * dup1  = new YTreeItem( first, "dup" );
+    widget->addItem( first );
+    widget->addItem( "second" );
+
+    BOOST_CHECK_EQUAL( widget->findItem( "first" ), first );
+    BOOST_CHECK_EQUAL( widget->findItem( "dup" ), dup1 );
+    BOOST_CHECK_EQUAL( widget->findItem( "nothing" ), (YItem *) 0 );
+
+    // another item with the same label: still the first one in tree order
+    widget->addItem( "dup" );
+    BOOST_CHECK_EQUAL( widget->findItem( "dup" ), dup1 );
+
+    widget->itemAt( 1 )->setLabel( "renamed" );
+    BOOST_CHECK_EQUAL( widget->findItem( "second" ), (YItem *) 0 );
+    BOOST_CHECK_EQUAL( widget->findItem( "renamed" ), widget->itemAt( 1 ) );
+
+    dup1->setLabel( "not a dup" );
+    BOOST_CHECK_EQUAL( widget->findItem( "dup" ), widget->itemAt( 2 ) );
+
+    widget->deleteAllItems();
+    BOOST_CHECK_EQUAL( widget->findItem( "first" ), (YItem *) 0 );
+    BOOST_CHECK( ! widget->hasSelectedItem() );
+}
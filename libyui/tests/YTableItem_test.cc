@@ -0,0 +1,94 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the cells of YTableItem
+
+#define BOOST_TEST_MODULE YTableItem_tests
+#include <boost/test/unit_test.hpp>
+
+#include "YTableItem.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+BOOST_AUTO_TEST_CASE( convenience_constructor )
+{
+    YTableItem item( "one", "", "three" );
+
+    BOOST_REQUIRE_EQUAL( item.cellCount(), 3 );
+    BOOST_CHECK_EQUAL( item.label( 0 ), "one" );
+    BOOST_CHECK_EQUAL( item.label( 1 ), "" );
+    BOOST_CHECK_EQUAL( item.label( 2 ), "three" );
+    BOOST_CHECK_EQUAL( item.cell( 2 )->column(), 2 );
+    BOOST_CHECK_EQUAL( item.cell( 2 )->parent(), &item );
+
+    // trailing empty labels don't get a cell, but the first label always does
+    YTableItem empty;
+    BOOST_CHECK_EQUAL( empty.cellCount(), 0 );
+
+    YTableItem emptyLabels( "", "" );
+    BOOST_CHECK_EQUAL( emptyLabels.cellCount(), 1 );
+}
+
+BOOST_AUTO_TEST_CASE( moved_labels )
+{
+    std::vector<std::string> labels = { "one", "a label too long for the small string buffer", "" };
+    YTableItem item( std::move( labels ) );
+
+    BOOST_REQUIRE_EQUAL( item.cellCount(), 3 );
+    BOOST_CHECK_EQUAL( item.label( 1 ), "a label too long for the small string buffer" );
+    BOOST_CHECK_EQUAL( item.label( 2 ), "" );
+    BOOST_CHECK( ! item.hasIconName( 0 ) );
+
+    // more cells after the block
+    item.addCell( "four", "icon.png" );
+    item.addCell( new YTableCell( "five", "icon.png" ) );
+
+    BOOST_REQUIRE_EQUAL( item.cellCount(), 5 );
+    BOOST_CHECK_EQUAL( item.cell( 4 )->column(), 4 );
+    BOOST_CHECK_EQUAL( item.iconName( 3 ), "icon.png" );
+    BOOST_CHECK_EQUAL( item.iconName( 4 ), "icon.png" );
+
+    item.cell( 0 )->setIconName( "other.png" );
+    BOOST_CHECK_EQUAL( item.iconName( 0 ), "other.png" );
+
+    // a new block after deleting all cells
+    item.deleteCells();
+    BOOST_CHECK_EQUAL( item.cellCount(), 0 );
+
+    item.addCells( "x", "y" );
+    BOOST_REQUIRE_EQUAL( item.cellCount(), 2 );
+    BOOST_CHECK_EQUAL( item.label( 1 ), "y" );
+}
+
+BOOST_AUTO_TEST_CASE( nested_items )
+{
+    YTableItem parent( std::vector<std::string> { "parent" } );
+    YTableItem * child = new YTableItem( &parent, std::vector<std::string> { "child", "2" } );
+
+    BOOST_CHECK_EQUAL( child->parent(), &parent );
+    BOOST_CHECK_EQUAL( child->label( 1 ), "2" );
+    BOOST_CHECK( parent.hasChildren() );
+}
@@ -0,0 +1,192 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the asynchronous log writing of YUILog
+
+#define BOOST_TEST_MODULE YUILog_tests
+#include <boost/test/unit_test.hpp>
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#define YUILogComponent "test"
+#include "YUILog.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+// Log to a new temporary file for each test and remove it afterwards
+struct TempLogFile {
+    TempLogFile()
+    {
+        char name[] = "/tmp/YUILog_test.XXXXXX";
+        int fd = mkstemp( name );
+        BOOST_REQUIRE( fd >= 0 );
+        close( fd );
+
+        fileName = name;
+        BOOST_REQUIRE( YUILog::setLogFileName( fileName ) );
+    }
+
+    ~TempLogFile()
+    {
+        YUILog::setAsyncLogging( false );
+        YUILog::setLogFileName( "" );
+        unlink( fileName.c_str() );
+    }
+
+    std::string content() const
+    {
+        std::ifstream file( fileName );
+        std::ostringstream content;
+        content << file.rdbuf();
+
+        return content.str();
+    }
+
+    // Return the number of lines with 'text' or -1 if they are not
+    // numbered 0, 1, 2, ... in this order
+    int countInOrder( const std::string & text ) const
+    {
+        std::istringstream lines( content() );
+        std::string line;
+        int count = 0;
+
+        while ( std::getline( lines, line ) )
+        {
+            if ( line.find( text ) == std::string::npos )
+                continue;
+
+            if ( line.find( text + std::to_string( count ) + "." ) == std::string::npos )
+                return -1;
+
+            count++;
+        }
+
+        return count;
+    }
+
+    std::string fileName;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( ring, TempLogFile )
+{
+    YUILog::setAsyncLogging( true );
+
+    // Many more lines than fit into the queue at once, from several threads
+    const int lineCount = 20000;
+
+    std::thread other( []()
+    {
+        for ( int i = 0; i < lineCount; i++ )
+            yuiMilestone() << "other " << i << "." << std::endl;
+    } );
+
+    for ( int i = 0; i < lineCount; i++ )
+        yuiMilestone() << "main " << i << "." << std::endl;
+
+    other.join();
+    YUILog::flushLog();
+
+    BOOST_CHECK_EQUAL( countInOrder( "main " ),  lineCount );
+    BOOST_CHECK_EQUAL( countInOrder( "other " ), lineCount );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( flush_level, TempLogFile )
+{
+    YUILog::setAsyncLogging( true, YUI_LOG_WARNING );
+
+    yuiMilestone() << "queued 0." << std::endl;
+    yuiWarning()   << "flushed 0." << std::endl;
+
+    // Written when the log call returns, together with everything before
+    BOOST_CHECK_EQUAL( countInOrder( "queued " ),  1 );
+    BOOST_CHECK_EQUAL( countInOrder( "flushed " ), 1 );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( flush_interval, TempLogFile )
+{
+    YUILog::setAsyncLogging( true );
+
+    // A single line does not wake up the writer, but it is written soon
+    yuiMilestone() << "single 0." << std::endl;
+
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+
+    while ( countInOrder( "single " ) == 0 && std::chrono::steady_clock::now() < timeout )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+    BOOST_CHECK_EQUAL( countInOrder( "single " ), 1 );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( after_fork, TempLogFile )
+{
+    YUILog::setAsyncLogging( true );
+
+    for ( int i = 0; i < 100; i++ )
+        yuiMilestone() << "parent " << i << "." << std::endl;
+
+    pid_t pid = ::fork();
+    BOOST_REQUIRE( pid >= 0 );
+
+    if ( pid == 0 )
+    {
+        // The writer thread does not exist in the child: Logging works
+        // synchronously, and a new writer thread can be started.
+
+        int status = YUILog::asyncLogging() ? 1 : 0;
+
+        yuiMilestone() << "child 0." << std::endl;
+
+        YUILog::setAsyncLogging( true );
+
+        for ( int i = 1; i < 1000; i++ )
+            yuiMilestone() << "child " << i << "." << std::endl;
+
+        YUILog::setAsyncLogging( false );
+        _exit( status );
+    }
+
+    int status = -1;
+    BOOST_REQUIRE_EQUAL( waitpid( pid, &status, 0 ), pid );
+    BOOST_CHECK( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 );
+
+    YUILog::flushLog();
+
+    // The parent writes what was queued before fork(), the child does not
+    BOOST_CHECK_EQUAL( countInOrder( "parent " ), 100 );
+    BOOST_CHECK_EQUAL( countInOrder( "child " ),  1000 );
+}
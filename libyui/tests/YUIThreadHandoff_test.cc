@@ -0,0 +1,175 @@
+/*
+  Copyright (C) 2021 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YUIThreadHandoff class
+
+#define BOOST_TEST_MODULE YUIThreadHandoff_tests
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+
+#include "YBuiltinCaller.h"
+#include "YUIThreadHandoff.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+const int roundTrips = 10000;
+
+class CountingCaller : public YBuiltinCaller
+{
+public:
+    CountingCaller() : calls( 0 ) {}
+    virtual void call() { calls++; }
+
+    int calls;
+};
+
+// Wait for 'fd' like the idle loop of a UI
+static void
+idleLoop( int fd )
+{
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    while ( poll( &pfd, 1, -1 ) < 1 )
+        ;
+}
+
+// The UI thread main loop like YUI::uiThreadMainLoop()
+static void
+uiThread( YUIThreadHandoff * handoff, CountingCaller * caller, int commands )
+{
+    while ( commands > 0 )
+    {
+        if ( ! handoff->spinForCommand() )
+        {
+            if ( handoff->waitingForCommand( true ) )
+                idleLoop( handoff->fd() );
+
+            handoff->waitingForCommand( false );
+        }
+
+        if ( ! handoff->takeCommand() )
+            continue;
+
+        YBuiltinCaller * batchCaller = handoff->popCaller();
+
+        if ( batchCaller )
+        {
+            do {
+                batchCaller->call();
+            } while ( ( batchCaller = handoff->popCaller() ) );
+        }
+        else
+            caller->call();
+
+        commands--;
+        handoff->signalDone();
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ping_pong )
+{
+    YUIThreadHandoff handoff;
+    BOOST_REQUIRE( handoff.init() );
+
+    CountingCaller caller;
+    std::thread thread( uiThread, &handoff, &caller, roundTrips );
+
+    for ( int i = 0; i < roundTrips; i++ )
+    {
+        handoff.postCommand();
+        handoff.waitForDone();
+    }
+
+    thread.join();
+
+    BOOST_CHECK_EQUAL( caller.calls, roundTrips );
+}
+
+// The UI thread blocks in its idle loop if the next command takes a while
+BOOST_AUTO_TEST_CASE( blocking )
+{
+    YUIThreadHandoff handoff;
+    BOOST_REQUIRE( handoff.init() );
+
+    CountingCaller caller;
+    std::thread thread( uiThread, &handoff, &caller, 3 );
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        handoff.postCommand();
+        handoff.waitForDone();
+        BOOST_CHECK_EQUAL( caller.calls, i + 1 );
+    }
+
+    thread.join();
+}
+
+BOOST_AUTO_TEST_CASE( batch )
+{
+    const int batches = 1000;
+    const int batchSize = 50;
+
+    YUIThreadHandoff handoff;
+    BOOST_REQUIRE( handoff.init() );
+
+    CountingCaller caller;
+    CountingCaller batchCaller;
+    std::thread thread( uiThread, &handoff, &caller, batches );
+
+    for ( int i = 0; i < batches; i++ )
+    {
+        for ( int j = 0; j < batchSize; j++ )
+            BOOST_REQUIRE( handoff.pushCaller( &batchCaller ) );
+
+        handoff.postCommand();
+        handoff.waitForDone();
+    }
+
+    thread.join();
+
+    BOOST_CHECK_EQUAL( batchCaller.calls, batches * batchSize );
+    BOOST_CHECK_EQUAL( caller.calls, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( batch_full )
+{
+    YUIThreadHandoff handoff;
+    CountingCaller caller;
+    int pushed = 0;
+
+    while ( handoff.pushCaller( &caller ) )
+        pushed++;
+
+    BOOST_CHECK_EQUAL( pushed, 64 );
+    BOOST_CHECK( handoff.popCaller() == &caller );
+    BOOST_CHECK( handoff.pushCaller( &caller ) );
+}
@@ -21,7 +21,7 @@ Name:           libyui-ncurses-rest-api
 Version:        4.1.0
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         bin_name %{name}%{so_version}
 
 BuildRequires:  cmake >= 3.10
@@ -21,7 +21,7 @@ Name:           libyui-qt-pkg
 Version:        4.1.0
 Release:        0
 
-%define         so_version 15
+%define         so_version 16
 %define         libzypp_devel_version libzypp-devel >= 17.21.0
 %define         bin_name %{name}%{so_version}
 